@@ -10,6 +10,7 @@ from flask_cors import CORS
 from flask_socketio import SocketIO, emit, join_room
 import threading
 import time
+from urllib.parse import quote
 import httpx
 
 # Add src to path for imports
@@ -17,8 +18,12 @@ sys.path.insert(0, str(Path(__file__).parent / "src"))
 
 from src.core.config import SystemConfig
 from src.core.exceptions import SkillLearningError
-from src.pipeline.skill_pipeline import SkillLearningPipeline
+from src.pipeline.skill_pipeline import PIPELINE_VERSION, SkillLearningPipeline
 from src.core.models import SkillBundle
+from src.services.robot_stream import RobotPoseStreamer, robot_host
+from src.services.robot_fleet import RobotFleet, normalize_base_url
+from src.services.robot_controller import DEFAULT_STEP_MS, SEQUENCE_BIN_MAX_STEPS
+from src.services.robot_client import RobotClient, get_robot_client
 
 # Configure logging
 logging.basicConfig(
@@ -38,6 +43,8 @@ pipeline = None
 active_sessions = {}
 # Track which sessions have already posted a sequence to the robot to prevent duplicates
 posted_sequence_sessions = set()
+# Lazily created UDP streamer for real-time pose updates
+pose_streamer: Optional[RobotPoseStreamer] = None
 
 def initialize_pipeline():
     """Initialize the skill learning pipeline."""
@@ -76,6 +83,239 @@ class StreamingProcessor:
         socketio.emit('progress_update', update, room=self.session_id)
         logger.info(f"Session {self.session_id}: {step} - {progress}%")
 
+# Pace of POST /frame playback, for motion settling between whole poses
+FRAME_STEP_S = 0.2
+
+def robot_client(base: str) -> RobotClient:
+    """The shared client (pooled connection, paced send queue) for one robot."""
+    return get_robot_client(base, frame_interval_s=pipeline.config.robot_frame_interval_ms / 1000.0)
+
+def post_binary_sequence(base: str, servo_payload: Dict[str, Any], session_id: str) -> None:
+    """Upload the whole sequence once via the firmware's packed POST /sequence.bin.
+
+    Sent with ``?pipeline=1`` so the robot starts moving on the first step
+    instead of after the whole body. Past the robot's 512-step lookahead the
+    body is only read as fast as it plays, so the timeout covers the playback
+    and the robot's client queue waits behind it (see robot_client.py).
+    """
+    packed = pipeline.robot_controller.encode_binary_servo_sequence(servo_payload, pipelined=True)
+    steps = pipeline.robot_controller.sequence_step_count(servo_payload)
+    url = f"{base}/sequence.bin"
+    logger.info("Session %s: Posting packed sequence (%d bytes) to %s", session_id, len(packed), url)
+    print(f"[{session_id}] Posting packed sequence ({len(packed)} bytes) to /sequence.bin")
+    timeout = 5.0 + steps * DEFAULT_STEP_MS / 1000.0
+    resp = robot_client(base).request('POST', '/sequence.bin', params={'pipeline': 1}, content=packed,
+                                      headers={'Content-Type': 'application/octet-stream'},
+                                      timeout=timeout, holds_robot=steps > SEQUENCE_BIN_MAX_STEPS).result()
+    if resp.status_code >= 400:
+        logger.warning("Robot /sequence.bin error %s: %s", resp.status_code, resp.text)
+        print(f"[{session_id}] /sequence.bin -> {resp.status_code}")
+    else:
+        logger.info("Session %s: Robot accepted sequence: %s", session_id, resp.text)
+        print(f"[{session_id}] Robot accepted sequence: {resp.text}")
+
+def post_cached_sequence(base: str, servo_payload: Dict[str, Any], session_id: str) -> None:
+    """Play the sequence from the robot's skill cache, uploading it only if the robot lacks it.
+
+    The cache key is the CRC-32 of the packed /sequence.bin steps and timing,
+    without the skill name, so a motion the robot already holds is replayed
+    with one GET and one bodiless POST whichever skill name, session or
+    backend process produced it. Firmware without
+    the cache falls back to a plain /sequence.bin upload, and so do sequences
+    longer than the robot's step table, which only the pipelined upload plays.
+    """
+    controller = pipeline.robot_controller
+    steps = controller.sequence_step_count(servo_payload)
+    if steps > SEQUENCE_BIN_MAX_STEPS:
+        logger.info("Session %s: %d steps exceed the skill cache; streaming instead", session_id, steps)
+        print(f"[{session_id}] {steps} steps exceed the robot's skill cache; using pipelined /sequence.bin")
+        post_binary_sequence(base, servo_payload, session_id)
+        return
+    packed = controller.encode_binary_servo_sequence(servo_payload)
+    key = controller.sequence_content_hash(packed)
+    client = robot_client(base)
+    lookup = client.request('GET', f"/skills/{key}").result()
+    if lookup.status_code == 200:
+        logger.info("Session %s: Robot already caches %s; skipping upload", session_id, key)
+        print(f"[{session_id}] Robot already caches sequence {key}; skipping upload")
+    else:
+        name = str(servo_payload.get('skill') or key)[:63]
+        store = client.request('POST', f"/skills/{quote(name, safe='')}", content=packed,
+                               headers={'Content-Type': 'application/octet-stream'}).result()
+        if store.status_code >= 400:
+            logger.warning("Robot /skills store error %s: %s; falling back to /sequence.bin",
+                           store.status_code, store.text)
+            print(f"[{session_id}] /skills -> {store.status_code}; falling back to /sequence.bin")
+            post_binary_sequence(base, servo_payload, session_id)
+            return
+        logger.info("Session %s: Stored %d-byte sequence as %s", session_id, len(packed), key)
+        print(f"[{session_id}] Stored packed sequence ({len(packed)} bytes) as {key}")
+
+    resp = client.request('POST', f"/play/{key}").result()
+    if resp.status_code >= 400:
+        logger.warning("Robot /play error %s: %s", resp.status_code, resp.text)
+        print(f"[{session_id}] /play/{key} -> {resp.status_code}")
+    else:
+        logger.info("Session %s: Robot playing cached sequence: %s", session_id, resp.text)
+        print(f"[{session_id}] Robot playing cached sequence: {resp.text}")
+
+def post_fleet_sequence(bases: list, servo_payload: Dict[str, Any], session_id: str) -> None:
+    """Play the sequence on every configured robot with one shared start time.
+
+    Sequences longer than the robot's step table skip the skill cache and
+    are streamed to each robot with a pipelined, scheduled /sequence.bin.
+    """
+    controller = pipeline.robot_controller
+    steps = controller.sequence_step_count(servo_payload)
+    streamed = steps > SEQUENCE_BIN_MAX_STEPS
+    packed = controller.encode_binary_servo_sequence(servo_payload, pipelined=streamed)
+    key = controller.sequence_content_hash(packed)
+    name = str(servo_payload.get('skill') or key)
+    fleet = RobotFleet(bases, lead_ms=pipeline.config.robot_sync_lead_ms)
+    print(f"[{session_id}] Starting sequence {key} on {len(bases)} robots in sync"
+          + (f" ({steps} steps, streamed)" if streamed else ""))
+    for result in fleet.play_synchronized(packed, key, name, streamed=streamed,
+                                          playback_ms=steps * DEFAULT_STEP_MS):
+        if result.ok:
+            logger.info("Session %s: %s scheduled at %s (rtt %.1f ms): %s", session_id, result.base,
+                        result.start_at_ms, result.rtt_ms or 0.0, result.detail)
+            print(f"[{session_id}] {result.base} scheduled at {result.start_at_ms}")
+        else:
+            logger.warning("Session %s: %s failed synchronised start (%s): %s", session_id, result.base,
+                           result.status_code, result.detail)
+            print(f"[{session_id}] {result.base} -> {result.status_code or 'error'}")
+
+def step_to_frame(step: Dict[str, Any]) -> list:
+    """Convert one sequence step into the six-entry angles list for POST /frame.
+
+    Servos the step doesn't mention are sent as None so the robot leaves them alone.
+    """
+    angles: list = [None] * 6
+    for cmd in (step or {}).get('commands', []) or []:
+        servo_id = int(cmd.get('id'))
+        if not 1 <= servo_id <= 6:
+            raise ValueError(f"servo id {servo_id} out of range")
+        angles[servo_id - 1] = max(0.0, min(180.0, round(float(cmd.get('deg')), 2)))
+    return angles
+
+def post_frames(base: str, servo_payload: Dict[str, Any], session_id: str) -> None:
+    """Send each sequence step to the robot as a single whole-pose POST /frame.
+
+    Every step is queued up front on the robot's shared client, with the time
+    it is due (FRAME_STEP_S apart). Round trips then overlap the pacing
+    instead of adding to it. Frames other sessions queue for the same robot
+    are merged with these and paced with them.
+    """
+    steps = servo_payload.get('sequence', []) or []
+    logger.info("Session %s: Posting %d steps as /frame requests", session_id, len(steps))
+    print(f"[{session_id}] Posting {len(steps)} steps as /frame requests")
+
+    client = robot_client(base)
+    step_s = FRAME_STEP_S
+    queued = []
+    errors = 0
+    due = time.monotonic()
+    for step_index, step in enumerate(steps):
+        hold = int((step or {}).get('hold', 0) or 0)
+        if hold > 0:
+            # Held steps change nothing; just let the time pass
+            due += step_s * hold
+            continue
+        try:
+            angles = step_to_frame(step)
+        except Exception:
+            logger.warning("Invalid step format encountered: %s", step)
+            errors += 1
+            continue
+        queued.append((step_index, angles, client.send_frame(angles, due=due)))
+        due += step_s
+
+    frames_sent = 0
+    for step_index, angles, future in queued:
+        try:
+            resp = future.result()
+        except Exception as e:
+            errors += 1
+            logger.warning("Robot /frame failed: %s (step=%d)", e, step_index + 1)
+            print(f"[{session_id}] /frame failed: {e} (step={step_index+1})")
+            continue
+        if resp.status_code >= 400:
+            errors += 1
+            logger.warning("Robot /frame error %s: %s (step=%d angles=%s)",
+                           resp.status_code, resp.text, step_index + 1, angles)
+            print(f"[{session_id}] /frame -> {resp.status_code} (step={step_index+1} angles={angles})")
+        else:
+            frames_sent += 1
+
+    logger.info("Session %s: Finished posting frames (ok=%d, errors=%d, merged across sessions so far=%d)",
+                session_id, frames_sent, errors, client.frames_merged)
+    print(f"[{session_id}] Finished posting frames (ok={frames_sent}, errors={errors})")
+
+def deliver_servo_payload(servo_payload: Dict[str, Any], session_id: str) -> None:
+    """Emit final_movements to the session and, if configured, send the sequence to the robot(s)."""
+    try:
+        seq_len = len(servo_payload.get('sequence', []) or [])
+    except Exception:
+        seq_len = 0
+    socketio.emit('final_movements', servo_payload, room=session_id)
+    logger.info(f"Session {session_id}: Emitted final_movements event (sequence_len={seq_len})")
+    print(f"[{session_id}] Emitted final_movements (sequence_len={seq_len})")
+
+    # Optionally send servo actions to robot over HTTP if configured
+    robot_base_url = getattr(pipeline.config, 'robot_base_url', None)
+    robot_base_urls = getattr(pipeline.config, 'robot_base_urls', None) or []
+    if robot_base_url or robot_base_urls:
+        if session_id in posted_sequence_sessions:
+            logger.info(f"Session {session_id}: Robot sequence already posted; skipping duplicate send")
+            print(f"[{session_id}] Robot sequence already posted; skipping duplicate send")
+        else:
+            posted_sequence_sessions.add(session_id)
+            try:
+                bases = [normalize_base_url(b) for b in (robot_base_urls or [robot_base_url])]
+                base = bases[0]
+                if len(bases) > 1:
+                    post_fleet_sequence(bases, servo_payload, session_id)
+                elif pipeline.config.robot_post_mode == 'sequence':
+                    post_cached_sequence(base, servo_payload, session_id)
+                else:
+                    post_frames(base, servo_payload, session_id)
+            except Exception as e:
+                logger.error(f"Failed to send servo sequence to robot: {e}")
+                print(f"[{session_id}] Failed to send servo sequence: {e}")
+    else:
+        logger.info("ROBOT_BASE_URL / ROBOT_BASE_URLS not set; skipping robot POST")
+        print(f"[{session_id}] ROBOT_BASE_URL / ROBOT_BASE_URLS not set; skipping robot POST")
+
+def serve_cached_skill(query: str, session_id: str, processor: 'StreamingProcessor',
+                       max_sources: Optional[int]) -> Optional[Dict[str, Any]]:
+    """Answer a repeat query from the skill cache; None when it has to be learned."""
+    try:
+        cached = pipeline.lookup_cached_skill(query, max_sources)
+        if cached is None:
+            return None
+        saved_files = pipeline.save_cached_skill(cached)
+    except Exception as e:
+        logger.warning(f"Session {session_id}: Skill cache lookup failed, learning from scratch: {e}")
+        return None
+    print(f"[{session_id}] Skill cache hit ({cached.plan_key[:12]}) in {cached.lookup_ms:.1f}ms")
+    processor.emit_progress("Loaded from cache", 90, {
+        'plan_key': cached.plan_key,
+        'sequence_key': cached.sequence_key,
+        'recompiled': cached.recompiled,
+        'lookup_ms': round(cached.lookup_ms, 1)
+    })
+    try:
+        deliver_servo_payload(cached.servo_sequence, session_id)
+    except Exception as e:
+        logger.error(f"Session {session_id}: Failed to emit final_movements: {e}")
+        print(f"[{session_id}] Failed to emit final_movements: {e}")
+    processor.emit_progress("Complete", 100, {
+        'bundle': cached.bundle,
+        'files': saved_files,
+        'cached': True
+    })
+    return cached.bundle
+
 async def process_skill_with_streaming(query: str, session_id: str, max_sources: Optional[int] = None):
     """Process skill query with streaming updates."""
     processor = StreamingProcessor(session_id)
@@ -84,6 +324,11 @@ async def process_skill_with_streaming(query: str, session_id: str, max_sources:
     try:
         processor.emit_progress("Initializing", 0)
         
+        # Repeat queries skip scraping, guide generation and compilation
+        cached_bundle = serve_cached_skill(query, session_id, processor, max_sources or 5)
+        if cached_bundle is not None:
+            return cached_bundle
+        
         # Step 1: Scraping
         processor.emit_progress("Scraping sources", 10)
         sources = await pipeline.scraper.scrape_query(query, max_sources or 5)
@@ -154,7 +399,7 @@ async def process_skill_with_streaming(query: str, session_id: str, max_sources:
             guide=guide,
             plan=plan,
             metadata={
-                "pipeline_version": "2.0",
+                "pipeline_version": PIPELINE_VERSION,
                 "processing_warnings": warnings,
                 "source_count": len(sources),
                 "step_count": len(guide.steps),
@@ -165,7 +410,7 @@ async def process_skill_with_streaming(query: str, session_id: str, max_sources:
         
         # Save results
         print(f"[{session_id}] Saving bundle to output directory: {pipeline.config.output_dir}")
-        saved_files = pipeline.save_bundle(bundle)
+        saved_files = pipeline.save_bundle(bundle, max_sources=max_sources or 5)
         try:
             print(f"[{session_id}] Bundle saved: files_count={len(saved_files or [])}")
         except Exception:
@@ -188,87 +433,7 @@ async def process_skill_with_streaming(query: str, session_id: str, max_sources:
             if servo_file.exists():
                 with open(servo_file, 'rb') as f:
                     servo_payload = orjson.loads(f.read())
-                try:
-                    seq_len = len(servo_payload.get('sequence', []) or [])
-                except Exception:
-                    seq_len = 0
-                socketio.emit('final_movements', servo_payload, room=session_id)
-                logger.info(f"Session {session_id}: Emitted final_movements event (sequence_len={seq_len})")
-                print(f"[{session_id}] Emitted final_movements (sequence_len={seq_len})")
-
-                # Optionally send servo actions to robot over HTTP one-by-one if configured
-                robot_base_url = getattr(pipeline.config, 'robot_base_url', None)
-                if robot_base_url:
-                    if session_id in posted_sequence_sessions:
-                        logger.info(f"Session {session_id}: Robot sequence already posted; skipping duplicate send")
-                        print(f"[{session_id}] Robot sequence already posted; skipping duplicate send")
-                    else:
-                        posted_sequence_sessions.add(session_id)
-                        try:
-                            base = robot_base_url.rstrip('/')
-                            if not (base.startswith('http://') or base.startswith('https://')):
-                                base = f"http://{base}"
-                            logger.info(
-                                "Session %s: Posting %d steps as individual /servo commands",
-                                session_id,
-                                seq_len,
-                            )
-                            print(f"[{session_id}] Posting {seq_len} steps as individual /servo commands")
-
-                            steps = servo_payload.get('sequence', []) or []
-                            commands_sent = 0
-                            errors = 0
-                            with httpx.Client(timeout=2.0) as client:
-                                for step_index, step in enumerate(steps):
-                                    commands = (step or {}).get('commands', []) or []
-                                    print(f"[{session_id}] Step {step_index+1}/{len(steps)}: sending {len(commands)} commands")
-                                    for cmd in commands:
-                                        try:
-                                            servo_id = int(cmd.get('id'))
-                                            angle = int(cmd.get('deg'))
-                                        except Exception:
-                                            logger.warning("Invalid command format encountered: %s", cmd)
-                                            errors += 1
-                                            continue
-
-                                        if angle < 0:
-                                            angle = 0
-                                        if angle > 180:
-                                            angle = 180
-
-                                        url = f"{base}/servo"
-                                        resp = client.post(url, json={"id": servo_id, "angle": angle})
-                                        if resp.status_code >= 400:
-                                            errors += 1
-                                            logger.warning(
-                                                "Robot /servo error %s: %s (id=%s angle=%s)",
-                                                resp.status_code,
-                                                resp.text,
-                                                servo_id,
-                                                angle,
-                                            )
-                                            print(f"[{session_id}] /servo -> {resp.status_code} (id={servo_id} angle={angle})")
-                                        else:
-                                            commands_sent += 1
-                                        # Small delay to avoid flooding the microcontroller
-                                        time.sleep(0.02)
-
-                                    # Slight delay between steps for motion settling
-                                    time.sleep(0.1)
-
-                            logger.info(
-                                "Session %s: Finished posting servo commands (ok=%d, errors=%d)",
-                                session_id,
-                                commands_sent,
-                                errors,
-                            )
-                            print(f"[{session_id}] Finished posting servo commands (ok={commands_sent}, errors={errors})")
-                        except Exception as e:
-                            logger.error(f"Failed to send servo sequence to robot: {e}")
-                            print(f"[{session_id}] Failed to send servo sequence: {e}")
-                else:
-                    logger.info("ROBOT_BASE_URL not set; skipping robot POST")
-                    print(f"[{session_id}] ROBOT_BASE_URL not set; skipping robot POST")
+                deliver_servo_payload(servo_payload, session_id)
             else:
                 logger.warning(f"Session {session_id}: servo_sequence.json not found at {servo_file}")
                 print(f"[{session_id}] servo_sequence.json not found at {servo_file}")
@@ -304,7 +469,8 @@ def health_check():
     return jsonify({
         'status': 'healthy',
         'pipeline_initialized': pipeline is not None,
-        'active_sessions': len(active_sessions)
+        'active_sessions': len(active_sessions),
+        'skill_cache': {'hits': pipeline.cache.hits, 'misses': pipeline.cache.misses} if pipeline else None
     })
 
 @app.route('/calibrate', methods=['POST'])
@@ -327,34 +493,38 @@ def calibrate_robot():
                 'message': 'Calibration simulated (ROBOT_BASE_URL not set)'
             })
 
-        base = robot_base_url.rstrip('/')
-        if not (base.startswith('http://') or base.startswith('https://')):
-            base = f"http://{base}"
+        base = normalize_base_url(robot_base_url)
         url = f"{base}/calibrate"
 
         logger.info(f"Forwarding calibration request to robot: {url}")
         try:
-            with httpx.Client(timeout=5.0) as client:
-                resp = client.post(url, json={'action': 'calibrate'})
-                content_type = resp.headers.get('content-type', '')
-                body: Any
-                try:
-                    if 'application/json' in content_type:
-                        body = resp.json()
-                    else:
-                        body = {'message': resp.text}
-                except Exception:
+            # Queued as due now, so it goes ahead of any frames still waiting for
+            # their slot. A streaming upload in flight would hold it until the
+            # playback ends, so that job is aborted over UDP first.
+            client = robot_client(base)
+            if client.holding_robot():
+                logger.info("Aborting the streaming sequence upload so calibration can go through")
+                get_pose_streamer().abort_sequence()
+            resp = client.request('POST', '/calibrate', json={'action': 'calibrate'}).result()
+            content_type = resp.headers.get('content-type', '')
+            body: Any
+            try:
+                if 'application/json' in content_type:
+                    body = resp.json()
+                else:
                     body = {'message': resp.text}
+            except Exception:
+                body = {'message': resp.text}
 
-                if resp.status_code >= 400:
-                    logger.warning(f"Robot calibration returned {resp.status_code}: {resp.text}")
-                    raise RuntimeError(f"calibrate endpoint returned {resp.status_code}")
+            if resp.status_code >= 400:
+                logger.warning(f"Robot calibration returned {resp.status_code}: {resp.text}")
+                raise RuntimeError(f"calibrate endpoint returned {resp.status_code}")
 
-                return jsonify({
-                    'ok': True,
-                    'message': body.get('message') if isinstance(body, dict) else 'Calibration triggered',
-                    'robot_response': body
-                })
+            return jsonify({
+                'ok': True,
+                'message': body.get('message') if isinstance(body, dict) else 'Calibration triggered',
+                'robot_response': body
+            })
         except Exception as primary_err:
             # Fallback: if /calibrate not supported, send neutral angles via /servos
             try:
@@ -528,6 +698,33 @@ def handle_start_processing(data):
         logger.error(f"Error in start_processing: {e}")
         emit('error', {'message': str(e)})
 
+def get_pose_streamer() -> RobotPoseStreamer:
+    """The lazily created UDP streamer for ROBOT_BASE_URL's stream port."""
+    global pose_streamer
+    if pose_streamer is None:
+        pose_streamer = RobotPoseStreamer(robot_host(pipeline.config.robot_base_url),
+                                          pipeline.config.robot_stream_port)
+        logger.info("Streaming poses to %s:%d", *pose_streamer.address)
+    return pose_streamer
+
+@socketio.on('stream_pose')
+def handle_stream_pose(data):
+    """Forward a live pose to the robot's UDP stream channel.
+
+    Expects {'angles': [a1..a6]}, with None for servos that should hold.
+    """
+    try:
+        if pipeline is None:
+            initialize_pipeline()
+        robot_base_url = getattr(pipeline.config, 'robot_base_url', None)
+        if not robot_base_url:
+            emit('error', {'message': 'ROBOT_BASE_URL not set; cannot stream poses'})
+            return
+        get_pose_streamer().send_pose((data or {}).get('angles') or [])
+    except Exception as e:
+        logger.warning(f"stream_pose failed: {e}")
+        emit('error', {'message': str(e)})
+
 if __name__ == '__main__':
     try:
         initialize_pipeline()
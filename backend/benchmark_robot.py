@@ -0,0 +1,399 @@
+"""Benchmark and load-test harness for the robot firmware's HTTP and UDP API.
+
+Drives the controller's endpoints at a fixed rate (or flat out) from several
+workers, records client-side latency percentiles, status codes and achieved
+poses/sec, and snapshots the firmware's own GET /metrics before and after
+each scenario. Sequence scenarios replay real servo_sequence.json files from
+outputs/. Results can be saved as JSON and compared against an earlier run
+so regressions between firmware builds show up as numbers.
+
+Examples:
+  python benchmark_robot.py http://192.168.1.50
+  python benchmark_robot.py 192.168.1.50 --scenario frame --rate 50 --duration 20
+  python benchmark_robot.py 192.168.1.50 --scenario status,servo --concurrency 4 --save before.json
+  python benchmark_robot.py 192.168.1.50 --save after.json --compare before.json
+"""
+import argparse
+import json
+import math
+import random
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional
+
+import httpx
+
+# Add src to path for imports
+sys.path.insert(0, str(Path(__file__).parent / "src"))
+
+from src.services.robot_controller import RobotControlGenerator
+from src.services.robot_stream import RobotPoseStreamer, robot_host, DEFAULT_STREAM_PORT
+from src.services.robot_fleet import normalize_base_url
+
+SERVO_COUNT = 6
+OCTET_STREAM = {'Content-Type': 'application/octet-stream'}
+
+
+def percentile(sorted_values: List[float], q: float) -> float:
+    """Nearest-rank percentile of an already sorted list (0 when empty)."""
+    if not sorted_values:
+        return 0.0
+    rank = max(1, math.ceil(q * len(sorted_values)))
+    return sorted_values[rank - 1]
+
+
+def random_pose(fine: bool = False) -> List[float]:
+    """Angles kept inside 30-150 degrees so a benchmark never drives a joint to its stop."""
+    return [round(random.uniform(30, 150), 2 if fine else 0) for _ in range(SERVO_COUNT)]
+
+
+def load_sequences(paths: List[str]) -> List[Dict[str, Any]]:
+    """Load servo_sequence.json style files; directories are searched recursively."""
+    found: List[Dict[str, Any]] = []
+    for raw in paths:
+        path = Path(raw)
+        files = sorted(path.rglob("*servo_sequence*.json")) if path.is_dir() else [path]
+        for f in files:
+            try:
+                data = json.loads(f.read_text())
+            except (OSError, ValueError) as e:
+                print(f"  skipping {f}: {e}")
+                continue
+            if isinstance(data, dict) and data.get("sequence"):
+                found.append(data)
+    return found
+
+
+@dataclass
+class Sample:
+    latency_ms: float
+    status: int  # 0 for a transport error
+    poses: float
+
+
+@dataclass
+class ScenarioResult:
+    name: str
+    target_rate: float
+    concurrency: int
+    elapsed_s: float = 0.0
+    samples: List[Sample] = field(default_factory=list)
+    firmware_before: Optional[Dict[str, Any]] = None
+    firmware_after: Optional[Dict[str, Any]] = None
+    extra: Dict[str, Any] = field(default_factory=dict)
+
+    def summary(self) -> Dict[str, Any]:
+        latencies = sorted(s.latency_ms for s in self.samples if s.status)
+        ok = [s for s in self.samples if 200 <= s.status < 300]
+        statuses: Dict[str, int] = {}
+        for s in self.samples:
+            key = str(s.status) if s.status else "transport_error"
+            statuses[key] = statuses.get(key, 0) + 1
+        total = len(self.samples)
+        elapsed = self.elapsed_s or 1e-9
+        out = {
+            "requests": total,
+            "elapsed_s": round(self.elapsed_s, 3),
+            "target_rate": self.target_rate,
+            "concurrency": self.concurrency,
+            "achieved_rps": round(total / elapsed, 2),
+            "poses_per_s": round(sum(s.poses for s in ok) / elapsed, 2),
+            "error_rate": round((total - len(ok)) / total, 4) if total else 0.0,
+            "statuses": statuses,
+            "p50_ms": round(percentile(latencies, 0.50), 2),
+            "p90_ms": round(percentile(latencies, 0.90), 2),
+            "p99_ms": round(percentile(latencies, 0.99), 2),
+            "max_ms": round(latencies[-1], 2) if latencies else 0.0,
+        }
+        out.update(self.extra)
+        firmware = firmware_delta(self.firmware_before, self.firmware_after)
+        if firmware:
+            out["firmware"] = firmware
+        return out
+
+
+def firmware_delta(before: Optional[Dict[str, Any]], after: Optional[Dict[str, Any]]) -> Dict[str, Any]:
+    """Condense two GET /metrics snapshots into what changed during a scenario."""
+    if not before or not after:
+        return {}
+    delta: Dict[str, Any] = {}
+    for section in ("routes", "series"):
+        for name, hist in (after.get(section) or {}).items():
+            prev = (before.get(section) or {}).get(name) or {}
+            count = hist.get("count", 0) - prev.get("count", 0)
+            if count <= 0:
+                continue
+            sum_us = hist.get("sum_us", 0) - prev.get("sum_us", 0)
+            delta[name] = {"count": count, "mean_us": round(sum_us / count, 1),
+                           "p99_us": hist.get("p99_us"), "max_us": hist.get("max_us")}
+    heap = after.get("heap") or {}
+    wifi = after.get("wifi") or {}
+    delta["heap_min_free"] = heap.get("min_free")
+    delta["heap_largest_block"] = heap.get("largest_block")
+    delta["wifi_rssi"] = wifi.get("rssi")
+    delta["wifi_reconnects"] = wifi.get("reconnects", 0) - (before.get("wifi") or {}).get("reconnects", 0)
+    return delta
+
+
+class Bench:
+    def __init__(self, base: str, timeout: float, sequences: List[Dict[str, Any]]):
+        self.base = normalize_base_url(base)
+        self.timeout = timeout
+        self.sequences = sequences
+        self._local = threading.local()
+
+    def client(self) -> httpx.Client:
+        """One keep-alive client per worker thread."""
+        c = getattr(self._local, "client", None)
+        if c is None:
+            c = httpx.Client(timeout=self.timeout)
+            self._local.client = c
+        return c
+
+    def metrics(self) -> Optional[Dict[str, Any]]:
+        try:
+            resp = httpx.get(f"{self.base}/metrics", timeout=self.timeout)
+            return resp.json() if resp.status_code == 200 else None
+        except (httpx.HTTPError, ValueError):
+            return None
+
+    def wait_idle(self, limit_s: float = 60.0) -> None:
+        """Block until no sequence is running so the next scenario starts clean."""
+        deadline = time.monotonic() + limit_s
+        while time.monotonic() < deadline:
+            try:
+                state = httpx.get(f"{self.base}/sequence", timeout=self.timeout).json().get("state")
+            except (httpx.HTTPError, ValueError):
+                return
+            if state not in ("queued", "scheduled", "running"):
+                return
+            time.sleep(0.25)
+
+    def timed(self, send: Callable[[httpx.Client], httpx.Response], poses: float) -> Sample:
+        start = time.perf_counter()
+        try:
+            resp = send(self.client())
+            status = resp.status_code
+        except httpx.HTTPError:
+            status = 0
+        return Sample((time.perf_counter() - start) * 1000.0, status, poses)
+
+    # One request of each scenario; the return value is that request's sample
+
+    def op_status(self, i: int) -> Sample:
+        return self.timed(lambda c: c.get(f"{self.base}/"), 0)
+
+    def op_servo(self, i: int) -> Sample:
+        # Six /servo calls complete one batch, so each is a sixth of a pose
+        body = {"id": i % SERVO_COUNT + 1, "angle": random.randint(30, 150)}
+        return self.timed(lambda c: c.post(f"{self.base}/servo", json=body), 1.0 / SERVO_COUNT)
+
+    def op_frame(self, i: int) -> Sample:
+        body = {"angles": random_pose(fine=True)}
+        return self.timed(lambda c: c.post(f"{self.base}/frame", json=body), 1)
+
+    def op_calibrate(self, i: int) -> Sample:
+        return self.timed(lambda c: c.post(f"{self.base}/calibrate"), 0)
+
+    def _sequence(self, i: int) -> Dict[str, Any]:
+        return self.sequences[i % len(self.sequences)]
+
+    def op_sequence(self, i: int) -> Sample:
+        seq = dict(self._sequence(i), step_ms=20)  # short steps so back-to-back uploads are not all 409
+        poses = RobotControlGenerator.sequence_step_count(seq)
+        return self.timed(lambda c: c.post(f"{self.base}/sequence", json=seq), poses)
+
+    def op_sequence_bin(self, i: int) -> Sample:
+        seq = self._sequence(i)
+        packed = RobotControlGenerator.encode_binary_servo_sequence(seq, step_ms=20)
+        poses = RobotControlGenerator.sequence_step_count(seq)
+        return self.timed(lambda c: c.post(f"{self.base}/sequence.bin", content=packed, headers=OCTET_STREAM), poses)
+
+    def op_play(self, i: int) -> Sample:
+        seq = self._sequence(i)
+        packed = RobotControlGenerator.encode_binary_servo_sequence(seq, step_ms=20)
+        key = RobotControlGenerator.sequence_content_hash(packed)
+        poses = RobotControlGenerator.sequence_step_count(seq)
+        return self.timed(lambda c: c.post(f"{self.base}/play/{key}"), poses)
+
+    def prime_skill_cache(self) -> None:
+        """Store every replayed sequence once so the play scenario measures replay only."""
+        for seq in self.sequences:
+            packed = RobotControlGenerator.encode_binary_servo_sequence(seq, step_ms=20)
+            key = RobotControlGenerator.sequence_content_hash(packed)
+            if self.client().get(f"{self.base}/skills/{key}").status_code != 200:
+                self.client().post(f"{self.base}/skills/{key}", content=packed, headers=OCTET_STREAM)
+
+
+def run_load(name: str, op: Callable[[int], Sample], rate: float, concurrency: int,
+             duration_s: float, max_requests: int) -> ScenarioResult:
+    """Issue op() from `concurrency` workers, open-loop at `rate` req/s (0 = as fast as they go)."""
+    result = ScenarioResult(name=name, target_rate=rate, concurrency=concurrency)
+    lock = threading.Lock()
+    counter = [0]
+    start = time.perf_counter()
+    stop_at = start + duration_s
+
+    def worker() -> None:
+        while True:
+            with lock:
+                i = counter[0]
+                if (max_requests and i >= max_requests) or time.perf_counter() >= stop_at:
+                    return
+                counter[0] += 1
+            if rate > 0:
+                # Open loop: request i is due at start + i/rate whatever earlier ones took
+                delay = start + i / rate - time.perf_counter()
+                if delay > 0:
+                    time.sleep(delay)
+            sample = op(i)
+            with lock:
+                result.samples.append(sample)
+
+    with ThreadPoolExecutor(max_workers=concurrency) as pool:
+        for _ in range(concurrency):
+            pool.submit(worker)
+    result.elapsed_s = time.perf_counter() - start
+    return result
+
+
+def run_stream(bench: Bench, rate: float, duration_s: float, port: int) -> ScenarioResult:
+    """Send UDP poses at `rate` Hz and read back how many the firmware applied."""
+    rate = rate or 50.0
+    result = ScenarioResult(name="stream", target_rate=rate, concurrency=1)
+
+    def stream_stats() -> Dict[str, Any]:
+        try:
+            return httpx.get(f"{bench.base}/", timeout=bench.timeout).json().get("stream") or {}
+        except (httpx.HTTPError, ValueError):
+            return {}
+
+    before = stream_stats()
+    streamer = RobotPoseStreamer(robot_host(bench.base), port)
+    start = time.perf_counter()
+    sent = 0
+    try:
+        while time.perf_counter() - start < duration_s:
+            due = start + sent / rate
+            delay = due - time.perf_counter()
+            if delay > 0:
+                time.sleep(delay)
+            t0 = time.perf_counter()
+            streamer.send_pose(random_pose(fine=True))
+            result.samples.append(Sample((time.perf_counter() - t0) * 1000.0, 200, 1))
+            sent += 1
+    finally:
+        streamer.close()
+    result.elapsed_s = time.perf_counter() - start
+    time.sleep(0.2)  # let the last packets land before reading the counters
+    after = stream_stats()
+
+    applied = after.get("applied", 0) - before.get("applied", 0)
+    result.extra = {
+        "packets_sent": sent,
+        "packets_received": after.get("received", 0) - before.get("received", 0),
+        "packets_applied": applied,
+        "dropped_stale": after.get("dropped_stale", 0) - before.get("dropped_stale", 0),
+        "dropped_busy": after.get("dropped_busy", 0) - before.get("dropped_busy", 0),
+        "applied_poses_per_s": round(applied / (result.elapsed_s or 1e-9), 2),
+    }
+    return result
+
+
+SCENARIOS = ["status", "servo", "frame", "sequence", "sequence_bin", "play", "stream", "calibrate"]
+
+
+def print_summary(name: str, s: Dict[str, Any], baseline: Optional[Dict[str, Any]]) -> None:
+    def fmt(key: str, unit: str = "") -> str:
+        value = s.get(key)
+        text = f"{value}{unit}"
+        if baseline and isinstance(baseline.get(key), (int, float)) and baseline[key]:
+            change = (value - baseline[key]) / baseline[key] * 100.0
+            text += f" ({change:+.1f}%)"
+        return text
+
+    print(f"\n=== {name} ===")
+    print(f"  requests: {s['requests']} in {s['elapsed_s']}s  "
+          f"rps: {fmt('achieved_rps')}  poses/s: {fmt('poses_per_s')}")
+    print(f"  latency p50: {fmt('p50_ms', 'ms')}  p90: {fmt('p90_ms', 'ms')}  "
+          f"p99: {fmt('p99_ms', 'ms')}  max: {fmt('max_ms', 'ms')}")
+    print(f"  error rate: {fmt('error_rate')}  statuses: {s['statuses']}")
+    if "packets_sent" in s:
+        print(f"  stream sent/received/applied: {s['packets_sent']}/{s['packets_received']}/"
+              f"{s['packets_applied']}  applied poses/s: {fmt('applied_poses_per_s')}")
+    for route, h in (s.get("firmware") or {}).items():
+        if isinstance(h, dict):
+            print(f"  firmware {route}: n={h['count']} mean={h['mean_us']}us "
+                  f"p99<={h['p99_us']}us max={h['max_us']}us")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark the robot firmware HTTP/UDP API",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__.split("Examples:", 1)[1],
+    )
+    parser.add_argument("robot", help="Robot base URL or host (e.g. http://192.168.1.50)")
+    parser.add_argument("--scenario", default="status,servo,frame,sequence,sequence_bin,play,stream",
+                        help=f"Comma-separated scenarios from: {', '.join(SCENARIOS)} (default: all but calibrate)")
+    parser.add_argument("--rate", type=float, default=0.0,
+                        help="Target requests/sec per scenario, 0 for closed loop (default: 0; stream defaults to 50)")
+    parser.add_argument("--concurrency", type=int, default=1, help="Parallel workers (default: 1)")
+    parser.add_argument("--duration", type=float, default=10.0, help="Seconds per scenario (default: 10)")
+    parser.add_argument("--requests", type=int, default=0, help="Stop a scenario after this many requests")
+    parser.add_argument("--timeout", type=float, default=5.0, help="Per-request timeout in seconds")
+    parser.add_argument("--outputs", nargs="*", default=[str(Path(__file__).parent / "outputs")],
+                        help="servo_sequence.json files or directories to replay (default: outputs/)")
+    parser.add_argument("--stream-port", type=int, default=DEFAULT_STREAM_PORT, help="UDP pose stream port")
+    parser.add_argument("--save", help="Write the results as JSON to this file")
+    parser.add_argument("--compare", help="Earlier --save file to print relative changes against")
+    args = parser.parse_args()
+
+    names = [n.strip() for n in args.scenario.split(",") if n.strip()]
+    unknown = [n for n in names if n not in SCENARIOS]
+    if unknown:
+        parser.error(f"unknown scenario(s): {', '.join(unknown)}")
+
+    sequences = load_sequences(args.outputs)
+    if not sequences and any(n in ("sequence", "sequence_bin", "play") for n in names):
+        print("No servo_sequence.json found to replay; skipping sequence scenarios")
+        names = [n for n in names if n not in ("sequence", "sequence_bin", "play")]
+
+    baseline = None
+    if args.compare:
+        baseline = json.loads(Path(args.compare).read_text()).get("scenarios", {})
+
+    bench = Bench(args.robot, args.timeout, sequences)
+    print(f"Benchmarking {bench.base}: {', '.join(names)} "
+          f"(rate={args.rate or 'max'}, concurrency={args.concurrency}, {args.duration}s each, "
+          f"{len(sequences)} replayed sequences)")
+
+    results: Dict[str, Any] = {}
+    for name in names:
+        bench.wait_idle()
+        if name == "play":
+            bench.prime_skill_cache()
+        before = bench.metrics()
+        if name == "stream":
+            result = run_stream(bench, args.rate, args.duration, args.stream_port)
+        else:
+            op = getattr(bench, f"op_{name}")
+            result = run_load(name, op, args.rate, args.concurrency, args.duration, args.requests)
+        result.firmware_before = before
+        result.firmware_after = bench.metrics()
+        summary = result.summary()
+        results[name] = summary
+        print_summary(name, summary, (baseline or {}).get(name))
+
+    if args.save:
+        report = {"robot": bench.base, "timestamp": time.time(), "args": vars(args), "scenarios": results}
+        Path(args.save).write_text(json.dumps(report, indent=2))
+        print(f"\nResults saved to {args.save}")
+
+
+if __name__ == "__main__":
+    main()
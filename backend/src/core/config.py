@@ -2,7 +2,7 @@
 from __future__ import annotations
 import os
 from dataclasses import dataclass, field
-from typing import Dict, Any, Optional
+from typing import Dict, Any, List, Optional
 from dotenv import load_dotenv
 
 from .exceptions import ConfigurationError
@@ -76,7 +76,11 @@ class SystemConfig:
     enable_caching: bool = True
     cache_ttl_hours: int = 24
     robot_base_url: Optional[str] = None  # e.g., "http://192.168.1.50"
-    robot_post_mode: str = "servos"  # 'servos' posts angles per step; 'sequence' posts entire sequence once
+    robot_base_urls: List[str] = field(default_factory=list)  # several robots started in sync, e.g. ROBOT_BASE_URLS="http://10.0.0.5,http://10.0.0.6"
+    robot_sync_lead_ms: int = 750  # how far ahead the shared start is scheduled once every robot is primed
+    robot_stream_port: int = 4210  # UDP port for real-time pose streaming
+    robot_post_mode: str = "servos"  # 'servos' posts one /frame per step; 'sequence' plays from the robot's skill cache, uploading once
+    robot_frame_interval_ms: int = 50  # minimum spacing of POST /frame requests to one robot, across all sessions
     
     @classmethod
     def from_env(cls) -> SystemConfig:
@@ -89,8 +93,13 @@ class SystemConfig:
         config.output_dir = os.getenv("OUTPUT_DIR", "outputs")
         config.log_level = os.getenv("LOG_LEVEL", "INFO")
         config.enable_caching = os.getenv("ENABLE_CACHING", "true").lower() == "true"
+        config.cache_ttl_hours = int(os.getenv("CACHE_TTL_HOURS", "24"))
         config.robot_base_url = os.getenv("ROBOT_BASE_URL")
+        config.robot_base_urls = [u.strip() for u in os.getenv("ROBOT_BASE_URLS", "").split(",") if u.strip()]
+        config.robot_sync_lead_ms = int(os.getenv("ROBOT_SYNC_LEAD_MS", "750"))
+        config.robot_stream_port = int(os.getenv("ROBOT_STREAM_PORT", "4210"))
         config.robot_post_mode = os.getenv("ROBOT_POST_MODE", "servos").strip().lower()
+        config.robot_frame_interval_ms = int(os.getenv("ROBOT_FRAME_INTERVAL_MS", "50"))
         
         return config
     
@@ -142,6 +142,20 @@ class ExecutionPhase:
             result["force_profile"] = self.force_profile
         return result
 
+    @classmethod
+    def from_dict(cls, data: Dict[str, Any]) -> ExecutionPhase:
+        """Inverse of to_dict()."""
+        return cls(
+            name=data["name"],
+            duration_ms=int(data["duration_ms"]),
+            cue=data.get("cue", ""),
+            pose_hints=data.get("pose_hints", ""),
+            rationale=data.get("rationale", ""),
+            citations=list(data.get("citations", [])),
+            velocity_profile=data.get("velocity_profile"),
+            force_profile=data.get("force_profile")
+        )
+
 
 @dataclass
 class PhysicalConstraints:
@@ -162,6 +176,17 @@ class PhysicalConstraints:
             "safety_margins": self.safety_margins
         }
 
+    @classmethod
+    def from_dict(cls, data: Dict[str, Any]) -> PhysicalConstraints:
+        """Inverse of to_dict()."""
+        return cls(
+            max_velocity_hint=float(data.get("max_velocity_hint", 0.8)),
+            keep_com_in_base=bool(data.get("keep_com_in_base", True)),
+            workspace_hint=data.get("workspace_hint", ""),
+            joint_limits=dict(data.get("joint_limits", {})),
+            safety_margins=dict(data.get("safety_margins", {}))
+        )
+
 
 @dataclass
 class ExecutionPlan:
@@ -189,6 +214,16 @@ class ExecutionPlan:
             "complexity_score": round(self.complexity_score, 3)
         }
 
+    @classmethod
+    def from_dict(cls, data: Dict[str, Any]) -> ExecutionPlan:
+        """Inverse of to_dict(); the derived totals are recomputed."""
+        return cls(
+            skill_name=data["skill"],
+            phases=[ExecutionPhase.from_dict(p) for p in data.get("phases", [])],
+            constraints=PhysicalConstraints.from_dict(data.get("constraints", {})),
+            provenance=list(data.get("provenance", []))
+        )
+
 
 @dataclass
 class SkillBundle:
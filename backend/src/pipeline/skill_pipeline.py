@@ -2,21 +2,27 @@
 from __future__ import annotations
 import asyncio
 import logging
-from typing import Dict, Any, Optional
+import time
+from dataclasses import asdict
+from typing import Dict, Any, Optional, Tuple
 from pathlib import Path
 import orjson
 
-from ..core.models import SkillBundle
+from ..core.models import ExecutionPlan, SkillBundle
 from ..core.config import SystemConfig
 from ..core.exceptions import SkillLearningError
 from ..services.scraper import WebScraper
 from ..services.llm_agent import CohereAgent
 from ..services.compiler import SkillCompiler
-from ..services.robot_controller import RobotControlGenerator
+from ..services.robot_controller import RobotControlGenerator, SERVO_PLANNER_VERSION
+from ..services.skill_cache import CachedSkill, SkillCache, content_key, normalize_query
 
 logger = logging.getLogger(__name__)
 
 
+PIPELINE_VERSION = "2.0"
+
+
 class SkillLearningPipeline:
     """Main pipeline for converting queries into executable skill plans."""
     
@@ -30,6 +36,8 @@ class SkillLearningPipeline:
         self.compiler = SkillCompiler(self.config.compiler)
         # Pass LLM config so servo planning can call Cohere
         self.robot_controller = RobotControlGenerator(self.config.llm)
+        self.cache = SkillCache(Path(self.config.output_dir) / "cache", self.config.cache_ttl_hours,
+                                enabled=self.config.enable_caching)
         
         # Setup logging
         logging.basicConfig(
@@ -79,7 +87,7 @@ class SkillLearningPipeline:
                 plan=plan,
                 robot_instructions=robot_instructions.to_dict(),
                 metadata={
-                    "pipeline_version": "2.0",
+                    "pipeline_version": PIPELINE_VERSION,
                     "processing_warnings": warnings,
                     "source_count": len(sources),
                     "step_count": len(guide.steps),
@@ -94,8 +102,100 @@ class SkillLearningPipeline:
             logger.error(f"Pipeline processing failed: {e}")
             raise SkillLearningError(f"Failed to process query '{query}': {e}")
     
-    def save_bundle(self, bundle: SkillBundle, output_dir: Optional[str] = None) -> Dict[str, str]:
-        """Save skill bundle to JSON files."""
+    def _llm_fingerprint(self) -> Dict[str, Any]:
+        # Everything that changes what the LLM answers; without a key the
+        # deterministic fallback answers instead
+        llm = self.config.llm
+        return {"model": llm.model, "temperature": llm.temperature, "max_tokens": llm.max_tokens,
+                "live": bool(llm.api_key)}
+
+    def plan_cache_key(self, query: str, max_sources: Optional[int] = None) -> str:
+        """Key of the plan a query compiles to under the current configuration."""
+        scraping = self.config.scraping
+        return content_key("plan", normalize_query(query), PIPELINE_VERSION, self._llm_fingerprint(),
+                           asdict(self.config.compiler), {
+                               "allow_web": scraping.allow_web,
+                               "max_sources": max_sources or scraping.max_sources,
+                               "trust_domains": scraping.trust_domains,
+                               "content_length": [scraping.min_content_length, scraping.max_content_length],
+                           })
+
+    def sequence_cache_key(self, plan: ExecutionPlan) -> str:
+        """Key of the servo sequence a plan compiles to."""
+        return content_key("sequence", plan.to_dict(), SERVO_PLANNER_VERSION, self._llm_fingerprint())
+
+    def compile_servo_sequence(self, plan: ExecutionPlan) -> Tuple[Dict[str, Any], bytes]:
+        """Minimal servo sequence plus its packed /sequence.bin bytes, from the cache when possible."""
+        key = self.sequence_cache_key(plan)
+        cached = self.cache.load_sequence(key)
+        if cached is not None:
+            logger.info(f"Servo sequence cache hit ({key[:12]})")
+            return cached
+        sequence = self.robot_controller.generate_minimal_servo_sequence(plan)
+        # Pipelined limit: past the robot's step table the bytes are still what
+        # a ?pipeline=1 upload sends, and delivery picks the transport
+        packed = self.robot_controller.encode_binary_servo_sequence(sequence, pipelined=True)
+        try:
+            self.cache.store_sequence(key, sequence, packed)
+        except OSError as e:
+            logger.warning(f"Could not cache servo sequence: {e}")
+        return sequence, packed
+
+    def lookup_cached_skill(self, query: str, max_sources: Optional[int] = None) -> Optional[CachedSkill]:
+        """Serve a query from the cache, skipping scraping and guide generation.
+
+        A cached plan whose compiled sequence is missing (e.g. after a servo
+        planner change) is recompiled here. Returns None on a plan miss.
+        """
+        start = time.perf_counter()
+        plan_key = self.plan_cache_key(query, max_sources)
+        bundle = self.cache.load_plan(plan_key)
+        if bundle is None:
+            self.cache.misses += 1
+            return None
+        try:
+            plan = ExecutionPlan.from_dict(bundle["plan"])
+        except (KeyError, TypeError, ValueError) as e:
+            logger.warning(f"Discarding malformed cached plan {plan_key[:12]}: {e}")
+            self.cache.misses += 1
+            return None
+        sequence_key = self.sequence_cache_key(plan)
+        hit = self.cache.load_sequence(sequence_key)
+        recompiled = hit is None
+        sequence, packed = hit if hit is not None else self.compile_servo_sequence(plan)
+        self.cache.hits += 1
+        cached = CachedSkill(plan_key, sequence_key, bundle, sequence, packed, recompiled=recompiled,
+                             lookup_ms=(time.perf_counter() - start) * 1000.0)
+        logger.info(f"Skill cache hit for '{query}' ({plan_key[:12]}, "
+                    f"{'recompiled' if recompiled else 'sequence cached'}, {cached.lookup_ms:.1f}ms)")
+        return cached
+
+    def save_bundle(self, bundle: SkillBundle, output_dir: Optional[str] = None,
+                    max_sources: Optional[int] = None) -> Dict[str, str]:
+        """Save skill bundle to JSON files and remember it in the skill cache."""
+        try:
+            bundle_dict = bundle.to_dict()
+            sequence, packed = self.compile_servo_sequence(bundle.plan)
+            files = self._write_outputs(bundle_dict, sequence, packed, output_dir)
+        except Exception as e:
+            logger.error(f"Failed to save bundle: {e}")
+            raise SkillLearningError(f"Failed to save bundle: {e}")
+        try:
+            self.cache.store_plan(self.plan_cache_key(bundle.query, max_sources), bundle.query, bundle_dict)
+        except OSError as e:
+            logger.warning(f"Could not cache skill plan: {e}")
+        return files
+
+    def save_cached_skill(self, cached: CachedSkill, output_dir: Optional[str] = None) -> Dict[str, str]:
+        """Write a cache hit to the output files, as save_bundle() would have."""
+        try:
+            return self._write_outputs(cached.bundle, cached.servo_sequence, cached.packed, output_dir)
+        except Exception as e:
+            logger.error(f"Failed to save bundle: {e}")
+            raise SkillLearningError(f"Failed to save bundle: {e}")
+
+    def _write_outputs(self, bundle_dict: Dict[str, Any], minimal_seq: Dict[str, Any], packed: bytes,
+                       output_dir: Optional[str] = None) -> Dict[str, str]:
         output_dir = Path(output_dir or self.config.output_dir)
         output_dir.mkdir(exist_ok=True)
         
@@ -106,33 +206,31 @@ class SkillLearningPipeline:
             "plan": output_dir / "plan.json",
             "robot_instructions": output_dir / "robot_instructions.json",
             "servo_sequence": output_dir / "servo_sequence.json",
+            "servo_sequence_bin": output_dir / "servo_sequence.bin",
             "servo_id_map": output_dir / "servo_id_map.json",
             "bundle": output_dir / "complete_bundle.json"
         }
         
-        try:
-            # Save individual components
-            self._save_json(files["sources"], {"sources": [s.to_dict() for s in bundle.sources]})
-            self._save_json(files["guide"], bundle.guide.to_dict())
-            self._save_json(files["plan"], bundle.plan.to_dict())
-            if bundle.robot_instructions:
-                self._save_json(files["robot_instructions"], bundle.robot_instructions)
-            # Save minimal servo sequence (no textual descriptions)
-            minimal_seq = self.robot_controller.generate_minimal_servo_sequence(bundle.plan)
-            self._save_json(files["servo_sequence"], minimal_seq)
-            # Save a compact legend mapping numeric IDs to servo names (no change to servo_sequence structure)
-            if hasattr(self.robot_controller, "SERVO_ID_MAP"):
-                # Ensure keys are strings for JSON serialization
-                id_map = {str(v): k for k, v in self.robot_controller.SERVO_ID_MAP.items()}
-                self._save_json(files["servo_id_map"], {"id_map": id_map})
-            self._save_json(files["bundle"], bundle.to_dict())
-            
-            logger.info(f"Saved bundle to {output_dir}")
-            return {key: str(path) for key, path in files.items()}
-            
-        except Exception as e:
-            logger.error(f"Failed to save bundle: {e}")
-            raise SkillLearningError(f"Failed to save bundle: {e}")
+        # Save individual components
+        self._save_json(files["sources"], {"sources": bundle_dict["sources"]})
+        self._save_json(files["guide"], bundle_dict["guide"])
+        self._save_json(files["plan"], bundle_dict["plan"])
+        if bundle_dict.get("robot_instructions"):
+            self._save_json(files["robot_instructions"], bundle_dict["robot_instructions"])
+        # Save minimal servo sequence (no textual descriptions)
+        self._save_json(files["servo_sequence"], minimal_seq)
+        # Packed copy for the firmware's POST /sequence.bin
+        with open(files["servo_sequence_bin"], "wb") as f:
+            f.write(packed)
+        # Save a compact legend mapping numeric IDs to servo names (no change to servo_sequence structure)
+        if hasattr(self.robot_controller, "SERVO_ID_MAP"):
+            # Ensure keys are strings for JSON serialization
+            id_map = {str(v): k for k, v in self.robot_controller.SERVO_ID_MAP.items()}
+            self._save_json(files["servo_id_map"], {"id_map": id_map})
+        self._save_json(files["bundle"], bundle_dict)
+        
+        logger.info(f"Saved bundle to {output_dir}")
+        return {key: str(path) for key, path in files.items()}
     
     def _save_json(self, path: Path, data: Dict[str, Any]) -> None:
         """Save data as formatted JSON."""
@@ -0,0 +1,221 @@
+"""Shared, paced HTTP client for each robot controller.
+
+Sessions used to open their own ``httpx.Client`` and post a frame, wait out
+the round trip, sleep and post the next. Now one ``RobotClient`` per base URL
+owns a pooled connection and a single sender thread. Callers queue requests
+and get futures back, so posting a whole sequence of frames costs no round
+trips on the caller's side. Frames carry the time they are due; frames that
+concurrent sessions queue for the same instant are merged into one
+POST /frame. They go out one at a time and no closer together than the
+controller absorbs them, because the ESP32 serves a single client at a time
+and a second connection would just wait in its accept backlog.
+
+A pipelined /sequence.bin upload (``holds_robot=True``) is the exception to
+"a few ms per request": the robot reads its body only as fast as it plays,
+so it occupies this sender and the robot's HTTP server for the whole
+playback, and every request queued behind it (including /calibrate and
+/frame) waits until it ends. A second connection would not help, because
+the firmware cannot serve one mid-upload. ``holding_robot()`` tells callers
+that this is the case, so they can first stop the job over the UDP stream
+channel (``RobotPoseStreamer.abort_sequence()``), which ends the upload.
+
+The stock ESP32 ``WebServer`` ends every reply with ``Connection: close``.
+Against current firmware the pool therefore saves client setup rather than
+the TCP handshake. httpx keeps the connection open on its own whenever a
+server allows it.
+"""
+from __future__ import annotations
+import bisect
+import logging
+import threading
+import time
+from concurrent.futures import Future
+from dataclasses import dataclass, field
+from typing import Any, Dict, List, Optional, Sequence
+
+import httpx
+
+logger = logging.getLogger(__name__)
+
+# The firmware parses a /frame, hands it to the motion task and replies in a
+# few ms, and the planner retargets every 20 ms control tick. Closer spacing
+# than this only queues requests on the robot.
+DEFAULT_FRAME_INTERVAL_S = 0.05
+DEFAULT_TIMEOUT_S = 5.0
+# Frames due this close together are merged into one request
+FRAME_MERGE_WINDOW_S = 0.02
+
+
+@dataclass
+class _Job:
+    method: str
+    path: str
+    kwargs: Dict[str, Any]
+    due: float  # time.monotonic() before which the job is not sent
+    futures: List[Future] = field(default_factory=list)
+    angles: Optional[List[Optional[float]]] = None  # set for mergeable POST /frame jobs
+    holds_robot: bool = False  # a streaming upload that lasts as long as the playback
+
+
+def merge_angles(older: Sequence[Optional[float]], newer: Sequence[Optional[float]]) -> List[Optional[float]]:
+    """Overlay two /frame angle lists; the newer entry wins wherever it is not None."""
+    return [n if n is not None else o for o, n in zip(older, newer)]
+
+
+class RobotClient:
+    """Pooled connection plus a due-time-ordered send queue for one robot."""
+
+    def __init__(self, base: str, frame_interval_s: float = DEFAULT_FRAME_INTERVAL_S,
+                 timeout: float = DEFAULT_TIMEOUT_S):
+        self.base = base
+        self.frame_interval_s = frame_interval_s
+        self.frames_merged = 0
+        self._http = httpx.Client(
+            timeout=timeout,
+            limits=httpx.Limits(max_connections=1, max_keepalive_connections=1, keepalive_expiry=30.0),
+        )
+        self._jobs: List[_Job] = []
+        self._cv = threading.Condition()
+        self._closed = False
+        self._last_frame_at = float('-inf')
+        self._in_flight: Optional[_Job] = None
+        self._thread = threading.Thread(target=self._run, name=f"robot-client {base}", daemon=True)
+        self._thread.start()
+
+    def request(self, method: str, path: str, due: Optional[float] = None, holds_robot: bool = False,
+                **kwargs: Any) -> Future:
+        """Queue any request (kwargs go to httpx); resolves to the httpx.Response.
+
+        Set ``holds_robot`` for uploads the robot reads at playback speed.
+        """
+        job = _Job(method.upper(), path, kwargs, due if due is not None else time.monotonic(),
+                   holds_robot=holds_robot)
+        return self._enqueue(job)
+
+    def holding_robot(self) -> bool:
+        """True while a ``holds_robot`` upload is in flight and everything else waits behind it."""
+        job = self._in_flight
+        return job is not None and job.holds_robot
+
+    def send_frame(self, angles: Sequence[Optional[float]], due: Optional[float] = None) -> Future:
+        """Queue a whole-pose POST /frame; None entries leave that servo alone.
+
+        A pending frame due within FRAME_MERGE_WINDOW_S absorbs this one, and
+        both futures resolve to the same response.
+        """
+        due = due if due is not None else time.monotonic()
+        future: Future = Future()
+        with self._cv:
+            self._check_open()
+            for job in self._jobs:
+                if job.angles is not None and abs(job.due - due) <= FRAME_MERGE_WINDOW_S:
+                    job.angles = merge_angles(job.angles, angles)
+                    job.futures.append(future)
+                    self.frames_merged += 1
+                    return future
+            self._insert(_Job("POST", "/frame", {}, due, [future], list(angles)))
+        return future
+
+    def pending(self) -> int:
+        with self._cv:
+            return len(self._jobs)
+
+    def close(self) -> None:
+        """Stop the sender; queued jobs fail with RuntimeError."""
+        with self._cv:
+            self._closed = True
+            dropped, self._jobs = self._jobs, []
+            self._cv.notify()
+        for job in dropped:
+            for future in job.futures:
+                future.set_exception(RuntimeError(f"robot client for {self.base} closed"))
+        self._thread.join(timeout=self._http.timeout.read or DEFAULT_TIMEOUT_S)
+        self._http.close()
+
+    def _check_open(self) -> None:
+        if self._closed:
+            raise RuntimeError(f"robot client for {self.base} closed")
+
+    def _enqueue(self, job: _Job) -> Future:
+        future: Future = Future()
+        job.futures.append(future)
+        with self._cv:
+            self._check_open()
+            self._insert(job)
+        return future
+
+    def _insert(self, job: _Job) -> None:
+        # Ordered by due time, FIFO among equals; caller holds the lock
+        self._jobs.insert(bisect.bisect_right(self._jobs, job.due, key=lambda j: j.due), job)
+        self._cv.notify()
+
+    def _next_job(self) -> Optional[_Job]:
+        with self._cv:
+            while not self._closed:
+                if not self._jobs:
+                    self._cv.wait()
+                    continue
+                job = self._jobs[0]
+                ready_at = job.due
+                if job.angles is not None:
+                    ready_at = max(ready_at, self._last_frame_at + self.frame_interval_s)
+                delay = ready_at - time.monotonic()
+                if delay > 0:
+                    self._cv.wait(delay)  # an earlier job may be queued meanwhile
+                    continue
+                self._jobs.pop(0)
+                if job.angles is not None:
+                    # Frames that fell due while this one waited are superseded
+                    # poses; fold them in rather than spend a round trip on each
+                    now = time.monotonic()
+                    while self._jobs and self._jobs[0].angles is not None and self._jobs[0].due <= now:
+                        later = self._jobs.pop(0)
+                        job.angles = merge_angles(job.angles, later.angles)
+                        job.futures.extend(later.futures)
+                        self.frames_merged += 1
+                return job
+            return None
+
+    def _run(self) -> None:
+        while True:
+            job = self._next_job()
+            if job is None:
+                return
+            kwargs = dict(job.kwargs)
+            if job.angles is not None:
+                kwargs['json'] = {'angles': job.angles}
+                self._last_frame_at = time.monotonic()
+            self._in_flight = job
+            try:
+                resp = self._http.request(job.method, f"{self.base}{job.path}", **kwargs)
+            except Exception as e:
+                for future in job.futures:
+                    future.set_exception(e)
+                continue
+            finally:
+                self._in_flight = None
+            for future in job.futures:
+                future.set_result(resp)
+
+
+_clients: Dict[str, RobotClient] = {}
+_clients_lock = threading.Lock()
+
+
+def get_robot_client(base: str, frame_interval_s: float = DEFAULT_FRAME_INTERVAL_S) -> RobotClient:
+    """The process-wide client for a (normalised) robot base URL."""
+    with _clients_lock:
+        client = _clients.get(base)
+        if client is None:
+            client = RobotClient(base, frame_interval_s=frame_interval_s)
+            _clients[base] = client
+            logger.info("Robot client for %s (frames >= %.0f ms apart)", base, frame_interval_s * 1000)
+        return client
+
+
+def close_robot_clients() -> None:
+    with _clients_lock:
+        clients = list(_clients.values())
+        _clients.clear()
+    for client in clients:
+        client.close()
@@ -5,6 +5,8 @@ from typing import Dict, Any, List, Optional, Tuple
 from dataclasses import dataclass, field
 from enum import Enum
 import math
+import struct
+import zlib
 
 from ..core.models import ExecutionPlan, ExecutionPhase
 from ..core.config import LLMConfig
@@ -12,6 +14,32 @@ from .llm_agent import CohereServoPlanner
 
 logger = logging.getLogger(__name__)
 
+# Packed sequence format accepted by the firmware's POST /sequence.bin:
+# 8-byte little-endian header (magic "SQ", version, name length, step count,
+# step duration ms), the UTF-8 skill name, then the steps. Versions 1 and 2
+# carry one angle per servo id 1-6 per step: a degree byte in version 1, a u16
+# of centidegrees in version 2. Versions 3 and 4 are the same angles delta
+# encoded: a record byte with bit 7 clear is a mask of the servo ids (bit 0 =
+# id 1) whose new angles follow, one with bit 7 set holds the pose for 1-127
+# steps.
+SEQUENCE_BIN_MAGIC = b"SQ"
+SEQUENCE_BIN_VERSION = 1
+SEQUENCE_BIN_VERSION_CDEG = 2
+SEQUENCE_BIN_VERSION_DELTA = 3
+SEQUENCE_BIN_VERSION_DELTA_CDEG = 4
+SEQUENCE_BIN_HOLD_RUN = 0x80
+SEQUENCE_BIN_MAX_RUN = 0x7F
+SEQUENCE_BIN_MAX_NAME = 63
+SEQUENCE_BIN_MAX_STEPS = 512
+SEQUENCE_BIN_MAX_PIPELINED_STEPS = 65535  # ?pipeline=1 streams through the step table
+SEQUENCE_BIN_HOLD = 0xFF  # leave this servo where it is for the step
+SEQUENCE_BIN_HOLD_CDEG = 0xFFFF
+SEQUENCE_BIN_SERVO_COUNT = 6
+DEFAULT_STEP_MS = 400
+# Bump whenever generate_minimal_servo_sequence() would produce different
+# output for the same plan; it is part of the compiled-sequence cache key
+SERVO_PLANNER_VERSION = 1
+
 
 class ServoAxis(Enum):
     """Servo axis types for 3 DOF model."""
@@ -217,12 +245,17 @@ class RobotControlGenerator:
         {
           "skill": str,
           "sequence": [
-            { "commands": [ {"id": str, "deg": int}, ... ] },
+            { "commands": [ {"id": str, "deg": number}, ... ] },
+            { "hold": int },
             ...
           ]
         }
 
-        No textual descriptions or reasoning. Strictly ordered steps only.
+        Delta encoded: the first step sets every joint, later steps list only
+        the joints that change (the firmware leaves the others where they
+        are), and consecutive steps that change nothing collapse into one
+        ``{"hold": n}`` entry. No textual descriptions or reasoning. Strictly
+        ordered steps only.
         """
         sequence: List[Dict[str, Any]] = []
         # Determine max allowed change per step per joint (degrees)
@@ -231,7 +264,7 @@ class RobotControlGenerator:
         max_delta = int(10 + (max(0.0, min(1.0, mv)) * 35))
 
         # Maintain last angles to smooth transitions; start from neutral
-        last_angles: Dict[str, int] = {
+        last_angles: Dict[str, float] = {
             "left_shoulder_vertical": 90,
             "left_shoulder_horizontal": 90,
             "left_elbow_vertical": 90,
@@ -240,14 +273,16 @@ class RobotControlGenerator:
             "right_elbow_vertical": 90,
         }
 
-        def clamp_int(v: float) -> int:
+        def clamp_angle(v: float) -> float:
+            # Keep 0.01 degree resolution; the firmware carries centidegrees to the servo
             try:
-                iv = int(round(float(v)))
+                fv = round(float(v), 2)
             except Exception:
-                iv = 90
-            return max(0, min(180, iv))
+                fv = 90.0
+            fv = max(0.0, min(180.0, fv))
+            return int(fv) if fv.is_integer() else fv
 
-        def smooth(target: int, prev: int) -> int:
+        def smooth(target: float, prev: float) -> float:
             # Limit per-step change to +/- max_delta
             if target > prev + max_delta:
                 return prev + max_delta
@@ -272,30 +307,118 @@ class RobotControlGenerator:
                 ra = wp.get("right_arm", {})
 
                 raw = {
-                    "left_shoulder_vertical": clamp_int(la.get("shoulder_vertical", 90)),
-                    "left_shoulder_horizontal": clamp_int(la.get("shoulder_horizontal", 90)),
-                    "left_elbow_vertical": clamp_int(la.get("elbow_vertical", 90)),
-                    "right_shoulder_vertical": clamp_int(ra.get("shoulder_vertical", 90)),
-                    "right_shoulder_horizontal": clamp_int(ra.get("shoulder_horizontal", 90)),
-                    "right_elbow_vertical": clamp_int(ra.get("elbow_vertical", 90)),
+                    "left_shoulder_vertical": clamp_angle(la.get("shoulder_vertical", 90)),
+                    "left_shoulder_horizontal": clamp_angle(la.get("shoulder_horizontal", 90)),
+                    "left_elbow_vertical": clamp_angle(la.get("elbow_vertical", 90)),
+                    "right_shoulder_vertical": clamp_angle(ra.get("shoulder_vertical", 90)),
+                    "right_shoulder_horizontal": clamp_angle(ra.get("shoulder_horizontal", 90)),
+                    "right_elbow_vertical": clamp_angle(ra.get("elbow_vertical", 90)),
                 }
 
-                smoothed = {k: smooth(v, last_angles[k]) for k, v in raw.items()}
+                smoothed = {k: clamp_angle(smooth(v, last_angles[k])) for k, v in raw.items()}
+                changed = [k for k, v in smoothed.items() if not sequence or v != last_angles[k]]
                 last_angles.update(smoothed)
 
-                commands = [
-                    {"id": self.SERVO_ID_MAP["left_shoulder_vertical"], "deg": smoothed["left_shoulder_vertical"]},
-                    {"id": self.SERVO_ID_MAP["left_shoulder_horizontal"], "deg": smoothed["left_shoulder_horizontal"]},
-                    {"id": self.SERVO_ID_MAP["left_elbow_vertical"], "deg": smoothed["left_elbow_vertical"]},
-                    {"id": self.SERVO_ID_MAP["right_shoulder_vertical"], "deg": smoothed["right_shoulder_vertical"]},
-                    {"id": self.SERVO_ID_MAP["right_shoulder_horizontal"], "deg": smoothed["right_shoulder_horizontal"]},
-                    {"id": self.SERVO_ID_MAP["right_elbow_vertical"], "deg": smoothed["right_elbow_vertical"]},
-                ]
-                sequence.append({"seq_num": seq_counter, "commands": commands})
+                if changed:
+                    commands = [{"id": self.SERVO_ID_MAP[k], "deg": smoothed[k]} for k in changed]
+                    sequence.append({"seq_num": seq_counter, "commands": commands})
+                elif "hold" in sequence[-1]:
+                    sequence[-1]["hold"] += 1
+                else:
+                    sequence.append({"seq_num": seq_counter, "hold": 1})
                 seq_counter += 1
 
         return {"skill": plan.skill_name, "sequence": sequence}
     
+    @staticmethod
+    def sequence_step_count(minimal_seq: Dict[str, Any]) -> int:
+        """Timeline length of a minimal sequence, counting each held step."""
+        return sum(int(step.get("hold", 0)) or 1 for step in minimal_seq.get("sequence", []) or [])
+
+    @staticmethod
+    def encode_binary_servo_sequence(minimal_seq: Dict[str, Any], step_ms: int = DEFAULT_STEP_MS,
+                                     pipelined: bool = False) -> bytes:
+        """Pack a generate_minimal_servo_sequence() result for POST /sequence.bin.
+
+        Servos missing from a step are encoded as a hold, matching the JSON
+        endpoint where only listed servos move. Sequences with any fractional
+        angle use the centidegree layout (version 2); whole-degree ones keep the
+        smaller version 1 encoding. The delta layouts (versions 3 and 4) are
+        used whenever they come out smaller, which is the usual case once
+        only a few joints move per step. ``pipelined`` lifts the step limit
+        for uploads sent with ``?pipeline=1``.
+        """
+        rows: List[List[Optional[int]]] = []
+        for step in minimal_seq.get("sequence", []) or []:
+            hold = int((step or {}).get("hold", 0) or 0)
+            if hold > 0:
+                rows.extend([None] * SEQUENCE_BIN_SERVO_COUNT for _ in range(hold))
+                continue
+            cdeg: List[Optional[int]] = [None] * SEQUENCE_BIN_SERVO_COUNT
+            for cmd in (step or {}).get("commands", []) or []:
+                servo_id = int(cmd.get("id"))
+                if not 1 <= servo_id <= SEQUENCE_BIN_SERVO_COUNT:
+                    raise ValueError(f"servo id {servo_id} out of range")
+                cdeg[servo_id - 1] = max(0, min(18000, int(round(float(cmd.get("deg")) * 100))))
+            rows.append(cdeg)
+        limit = SEQUENCE_BIN_MAX_PIPELINED_STEPS if pipelined else SEQUENCE_BIN_MAX_STEPS
+        if len(rows) > limit:
+            raise ValueError(f"sequence has {len(rows)} steps; firmware limit is {limit}")
+        fine = any(c is not None and c % 100 for row in rows for c in row)
+
+        name = str(minimal_seq.get("skill", "") or "").encode("utf-8")[:SEQUENCE_BIN_MAX_NAME]
+        full = bytearray()
+        for row in rows:
+            if fine:
+                full += struct.pack("<6H", *(SEQUENCE_BIN_HOLD_CDEG if c is None else c for c in row))
+            else:
+                full += bytes(SEQUENCE_BIN_HOLD if c is None else c // 100 for c in row)
+        delta = RobotControlGenerator._encode_delta_steps(rows, fine)
+
+        if len(delta) < len(full):
+            version = SEQUENCE_BIN_VERSION_DELTA_CDEG if fine else SEQUENCE_BIN_VERSION_DELTA
+            steps = delta
+        else:
+            version = SEQUENCE_BIN_VERSION_CDEG if fine else SEQUENCE_BIN_VERSION
+            steps = full
+        header = struct.pack("<2sBBHH", SEQUENCE_BIN_MAGIC, version, len(name), len(rows), int(step_ms))
+        return bytes(header) + name + bytes(steps)
+
+    @staticmethod
+    def _encode_delta_steps(rows: List[List[Optional[int]]], fine: bool) -> bytes:
+        """Step records for versions 3/4: changed-joint masks plus hold runs."""
+        out = bytearray()
+        run = 0
+        for row in rows + [None]:
+            if row is not None and all(c is None for c in row):
+                run += 1
+                continue
+            while run:
+                n = min(run, SEQUENCE_BIN_MAX_RUN)
+                out.append(SEQUENCE_BIN_HOLD_RUN | n)
+                run -= n
+            if row is None:
+                break
+            out.append(sum(1 << i for i, c in enumerate(row) if c is not None))
+            for c in row:
+                if c is not None:
+                    out += struct.pack("<H", c) if fine else bytes([c // 100])
+        return bytes(out)
+
+    @staticmethod
+    def sequence_content_hash(packed: bytes) -> str:
+        """Skill cache key for a packed sequence: CRC-32 of its playback content as 8 hex digits.
+
+        The skill name is left out (its length byte reads as zero and its bytes
+        are skipped), so the key covers the step records plus the header fields
+        that drive playback: encoding version, step count and step_ms. Matches
+        the "crc" the firmware reports for a stored skill, so identical motions
+        map to the same key whatever skill name or session produced them.
+        """
+        name_len = packed[3]
+        content = packed[:3] + b"\x00" + packed[4:8] + packed[8 + name_len:]
+        return f"{zlib.crc32(content) & 0xFFFFFFFF:08x}"
+
     def _calculate_3d_targets(self, phase: ExecutionPhase) -> Tuple[Dict[str, float], Dict[str, float]]:
         """Calculate 3D target positions for unlimited DOF model."""
         # Base positions (neutral stance)
@@ -0,0 +1,168 @@
+"""Synchronised sequence playback across several robots.
+
+Each robot's firmware schedules a sequence against its own millis() clock
+(``start_at_ms`` on POST /play/<key> and /sequence.bin), so the backend only
+has to learn every robot's clock offset and hand each one the shared start
+instant translated into its local time. Offsets are estimated NTP-style from
+GET /time: the sample with the smallest round trip is the one whose midpoint
+best matches the moment the robot stamped its reply.
+"""
+from __future__ import annotations
+import logging
+import time
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass
+from typing import Dict, List, Optional, Sequence
+from urllib.parse import quote
+
+import httpx
+
+logger = logging.getLogger(__name__)
+
+DEFAULT_CLOCK_SAMPLES = 8
+DEFAULT_SYNC_LEAD_MS = 750
+# Firmware rejects start times further than this from its own clock
+MAX_START_LEAD_MS = 30000
+
+
+def normalize_base_url(base: str) -> str:
+    """Strip trailing slashes and default the scheme to http://."""
+    base = base.strip().rstrip('/')
+    if not (base.startswith('http://') or base.startswith('https://')):
+        base = f"http://{base}"
+    return base
+
+
+def parse_base_urls(value: Optional[str]) -> List[str]:
+    """Split a comma-separated ROBOT_BASE_URLS value into normalised base URLs."""
+    if not value:
+        return []
+    return [normalize_base_url(part) for part in value.split(',') if part.strip()]
+
+
+def local_ms() -> float:
+    """Monotonic host clock in milliseconds, the timeline offsets are measured against."""
+    return time.monotonic() * 1000.0
+
+
+@dataclass
+class ClockOffset:
+    """robot_ms = local_ms + offset_ms, good to within roughly rtt_ms / 2."""
+    offset_ms: float
+    rtt_ms: float
+
+    def to_robot(self, local: float) -> int:
+        return int(round(local + self.offset_ms)) & 0xFFFFFFFF
+
+
+def estimate_clock_offset(client: httpx.Client, base: str,
+                          samples: int = DEFAULT_CLOCK_SAMPLES) -> ClockOffset:
+    """Estimate a robot's millis() offset from the host clock via GET /time."""
+    best: Optional[ClockOffset] = None
+    for _ in range(max(1, samples)):
+        sent = local_ms()
+        resp = client.get(f"{base}/time")
+        received = local_ms()
+        resp.raise_for_status()
+        robot_now = float(resp.json()['now_ms'])
+        rtt = received - sent
+        if best is None or rtt < best.rtt_ms:
+            best = ClockOffset(offset_ms=robot_now - (sent + received) / 2.0, rtt_ms=rtt)
+    return best
+
+
+@dataclass
+class RobotPlayResult:
+    base: str
+    ok: bool
+    status_code: int = 0
+    start_at_ms: Optional[int] = None
+    rtt_ms: Optional[float] = None
+    detail: str = ""
+
+
+class RobotFleet:
+    """Plays one packed sequence on several robots so they start together."""
+
+    def __init__(self, base_urls: Sequence[str], lead_ms: int = DEFAULT_SYNC_LEAD_MS,
+                 timeout: float = 5.0, clock_samples: int = DEFAULT_CLOCK_SAMPLES):
+        self.base_urls = [normalize_base_url(b) for b in base_urls]
+        self.lead_ms = max(0, min(int(lead_ms), MAX_START_LEAD_MS // 2))
+        self.timeout = timeout
+        self.clock_samples = clock_samples
+
+    def _prepare(self, base: str, packed: bytes, key: str, name: str, streamed: bool) -> Dict:
+        """Measure the clock offset and make sure the robot caches the sequence.
+
+        A streamed sequence is too long for the skill cache and is only timed.
+        """
+        with httpx.Client(timeout=self.timeout) as client:
+            offset = estimate_clock_offset(client, base, self.clock_samples)
+            if streamed:
+                return {'offset': offset, 'cached': False}
+            cached = client.get(f"{base}/skills/{key}").status_code == 200
+            if not cached:
+                store = client.post(f"{base}/skills/{quote(name, safe='')}", content=packed,
+                                    headers={'Content-Type': 'application/octet-stream'})
+                cached = store.status_code < 400
+                if not cached:
+                    logger.warning("Robot %s /skills store error %s: %s; will send /sequence.bin",
+                                   base, store.status_code, store.text)
+        return {'offset': offset, 'cached': cached}
+
+    def _start(self, base: str, prep: Dict, packed: bytes, key: str, start_local: float,
+               streamed: bool, playback_ms: int) -> RobotPlayResult:
+        offset: ClockOffset = prep['offset']
+        start_at = offset.to_robot(start_local)
+        params = {'start_at_ms': str(start_at)}
+        timeout = self.timeout
+        if streamed:
+            # The robot reads the body only as fast as it plays, from start_at on
+            params['pipeline'] = '1'
+            timeout = self.timeout + (self.lead_ms + playback_ms) / 1000.0
+        with httpx.Client(timeout=timeout) as client:
+            if prep['cached']:
+                resp = client.post(f"{base}/play/{key}", params=params)
+            else:
+                resp = client.post(f"{base}/sequence.bin", params=params, content=packed,
+                                   headers={'Content-Type': 'application/octet-stream'})
+        return RobotPlayResult(base=base, ok=resp.status_code < 400, status_code=resp.status_code,
+                               start_at_ms=start_at, rtt_ms=offset.rtt_ms, detail=resp.text)
+
+    def play_synchronized(self, packed: bytes, key: str, name: str, streamed: bool = False,
+                          playback_ms: int = 0) -> List[RobotPlayResult]:
+        """Start ``packed`` on every robot at one shared instant.
+
+        Clock sync and uploads run first, in parallel, so the start requests
+        are bodiless (or small) and all land well inside the lead time. A
+        robot that fails to prepare is reported and skipped rather than
+        holding the others back. With ``streamed`` (sequences longer than the
+        robot's step table) nothing is cached: each robot gets a pipelined
+        /sequence.bin upload with the shared start_at_ms, which starts on
+        schedule and keeps its connection open for ``playback_ms``.
+        """
+        name = name[:63]
+        results: List[RobotPlayResult] = []
+        prepared: Dict[str, Dict] = {}
+        with ThreadPoolExecutor(max_workers=max(1, len(self.base_urls))) as pool:
+            futures = {base: pool.submit(self._prepare, base, packed, key, name, streamed) for base in self.base_urls}
+            for base, fut in futures.items():
+                try:
+                    prepared[base] = fut.result()
+                except Exception as e:
+                    logger.error("Robot %s could not be prepared for a synchronised start: %s", base, e)
+                    results.append(RobotPlayResult(base=base, ok=False, detail=str(e)))
+            if not prepared:
+                return results
+
+            start_local = local_ms() + self.lead_ms
+            futures = {base: pool.submit(self._start, base, prep, packed, key, start_local, streamed,
+                                         playback_ms)
+                       for base, prep in prepared.items()}
+            for base, fut in futures.items():
+                try:
+                    results.append(fut.result())
+                except Exception as e:
+                    logger.error("Robot %s synchronised start failed: %s", base, e)
+                    results.append(RobotPlayResult(base=base, ok=False, detail=str(e)))
+        return results
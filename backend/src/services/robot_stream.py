@@ -0,0 +1,154 @@
+"""UDP pose streaming client for the robot controller's real-time channel."""
+from __future__ import annotations
+import logging
+import select
+import socket
+import struct
+import threading
+import time
+from dataclasses import dataclass
+from typing import List, Optional, Sequence
+from urllib.parse import urlparse
+
+logger = logging.getLogger(__name__)
+
+# Matches processStream() in robot/src/main.cpp: 'PS' magic, uint32 sequence
+# number, then one byte per servo id 1-6 (0-180, 0xFF to hold). Poses with
+# fractional degrees use 'PC' and a little-endian u16 of centidegrees per servo
+# (0-18000, 0xFFFF to hold).
+STREAM_MAGIC = b"PS"
+STREAM_MAGIC_CDEG = b"PC"
+STREAM_HOLD = 0xFF
+STREAM_HOLD_CDEG = 0xFFFF
+STREAM_SERVO_COUNT = 6
+DEFAULT_STREAM_PORT = 4210
+# Aborts the running sequence; unlike POST /sequence/abort it is heard while a
+# pipelined /sequence.bin upload is still holding the robot's HTTP server
+SEQUENCE_ABORT = b"SA"
+
+# Feedback telemetry from firmware built with ROBOT_FEEDBACK=1 (see
+# sendTelemetry() in robot/src/main.cpp). Sending 'TS' subscribes the sending
+# socket for TELEMETRY_LEASE_S; the robot then answers every 20 ms control
+# tick with a 'TF' datagram: uint32 tick, uint32 device millis, sensed /
+# stalled / overcurrent joint masks, a pad byte, then per servo id 1-6 the
+# commanded and measured centidegrees and the supply mA as u16 (0xFFFF where
+# the joint is not sensed).
+TELEMETRY_SUBSCRIBE = b"TS"
+TELEMETRY_MAGIC = b"TF"
+TELEMETRY_NONE = 0xFFFF
+TELEMETRY_LEASE_S = 5.0
+_TELEMETRY_HEADER = struct.Struct("<2sIIBBBx")
+_TELEMETRY_JOINTS = struct.Struct(f"<{3 * STREAM_SERVO_COUNT}H")
+TELEMETRY_PACKET_SIZE = _TELEMETRY_HEADER.size + _TELEMETRY_JOINTS.size
+
+
+@dataclass
+class JointTelemetry:
+    commanded: float            # degrees the planner drove this tick
+    measured: Optional[float]   # degrees read back, if the joint has position feedback
+    supply_ma: Optional[int]    # current of the joint's arm supply, if sensed
+    stalled: bool
+    overcurrent: bool
+
+    @property
+    def error(self) -> Optional[float]:
+        """Measured minus commanded degrees; how far the servo trails the plan."""
+        return None if self.measured is None else self.measured - self.commanded
+
+
+@dataclass
+class TelemetryFrame:
+    tick: int
+    device_ms: int
+    joints: List[JointTelemetry]
+
+
+def decode_telemetry(packet: bytes) -> TelemetryFrame:
+    """Unpack one 'TF' datagram; raises ValueError if it is not one."""
+    if len(packet) != TELEMETRY_PACKET_SIZE or packet[:2] != TELEMETRY_MAGIC:
+        raise ValueError("not a telemetry packet")
+    _, tick, device_ms, _sensed, stalled, overcurrent = _TELEMETRY_HEADER.unpack_from(packet)
+    values = _TELEMETRY_JOINTS.unpack_from(packet, _TELEMETRY_HEADER.size)
+    joints = []
+    for i in range(STREAM_SERVO_COUNT):
+        commanded, measured, supply = values[3 * i:3 * i + 3]
+        joints.append(JointTelemetry(
+            commanded=commanded / 100.0,
+            measured=None if measured == TELEMETRY_NONE else measured / 100.0,
+            supply_ma=None if supply == TELEMETRY_NONE else supply,
+            stalled=bool(stalled & (1 << i)),
+            overcurrent=bool(overcurrent & (1 << i)),
+        ))
+    return TelemetryFrame(tick=tick, device_ms=device_ms, joints=joints)
+
+
+def robot_host(robot_base_url: str) -> str:
+    """Extract the bare host from a ROBOT_BASE_URL such as http://192.168.1.50."""
+    base = robot_base_url.strip()
+    if "://" not in base:
+        base = f"http://{base}"
+    host = urlparse(base).hostname
+    if not host:
+        raise ValueError(f"Cannot determine robot host from '{robot_base_url}'")
+    return host
+
+
+class RobotPoseStreamer:
+    """Fire-and-forget pose sender; the robot keeps only the newest packet."""
+
+    def __init__(self, host: str, port: int = DEFAULT_STREAM_PORT):
+        self.address = (host, port)
+        self._sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self._seq = 0
+        self._lock = threading.Lock()
+
+    @staticmethod
+    def encode_pose(seq: int, angles: Sequence[Optional[float]]) -> bytes:
+        """Pack six angles (None to hold a servo) into one stream packet.
+
+        Whole-degree poses use the compact 'PS' packet; anything finer is sent
+        as centidegrees.
+        """
+        if len(angles) != STREAM_SERVO_COUNT:
+            raise ValueError(f"expected {STREAM_SERVO_COUNT} angles, got {len(angles)}")
+        cdeg = [None if a is None else max(0, min(18000, int(round(float(a) * 100)))) for a in angles]
+        header = struct.pack("<I", seq & 0xFFFFFFFF)
+        if all(c is None or c % 100 == 0 for c in cdeg):
+            packed = bytes(STREAM_HOLD if c is None else c // 100 for c in cdeg)
+            return STREAM_MAGIC + header + packed
+        packed = struct.pack("<6H", *(STREAM_HOLD_CDEG if c is None else c for c in cdeg))
+        return STREAM_MAGIC_CDEG + header + packed
+
+    def send_pose(self, angles: Sequence[Optional[float]]) -> int:
+        """Send one pose and return the sequence number it was sent with."""
+        with self._lock:
+            self._seq = (self._seq + 1) & 0xFFFFFFFF
+            seq = self._seq
+            self._sock.sendto(self.encode_pose(seq, angles), self.address)
+        return seq
+
+    def abort_sequence(self) -> None:
+        """Stop the robot's running sequence (best effort: UDP, no reply)."""
+        self._sock.sendto(SEQUENCE_ABORT, self.address)
+
+    def subscribe_telemetry(self) -> None:
+        """Ask the robot for feedback telemetry on this socket; renew within TELEMETRY_LEASE_S."""
+        self._sock.sendto(TELEMETRY_SUBSCRIBE, self.address)
+
+    def receive_telemetry(self, timeout: float = 0.1) -> Optional[TelemetryFrame]:
+        """Next telemetry frame from the robot, or None if none arrives within timeout."""
+        deadline = time.monotonic() + timeout
+        while True:
+            remaining = deadline - time.monotonic()
+            if remaining < 0 or not select.select([self._sock], [], [], remaining)[0]:
+                return None
+            packet, sender = self._sock.recvfrom(64)
+            if sender[0] != self.address[0]:
+                continue
+            try:
+                return decode_telemetry(packet)
+            except ValueError:
+                logger.debug("Ignoring %d-byte datagram from the robot", len(packet))
+
+    def close(self) -> None:
+        self._sock.close()
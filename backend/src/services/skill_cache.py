@@ -0,0 +1,163 @@
+"""Content-addressed cache of skill plans and compiled servo sequences.
+
+Two levels, each keyed by a SHA-256 over exactly what produced the entry:
+
+* plans: normalised query + pipeline/LLM/compiler/scraping configuration.
+  Holds the bundle (sources, guide, plan) from the scrape and two LLM passes,
+  and expires after the configured TTL since the web it was built from moves.
+* sequences: the plan's content + servo planner version + LLM model. Holds
+  the minimal servo sequence and its packed /sequence.bin bytes. Plans are
+  not timestamped into it, so two queries that compile to the same plan
+  share one sequence.
+
+A repeat query resolves both levels from disk in milliseconds. A planner
+change only invalidates the sequence level, so the next request recompiles
+from the cached plan without repeating the scrape and guide generation.
+Writes are atomic (temp file + rename), so concurrent sessions can share
+the directory.
+"""
+from __future__ import annotations
+import hashlib
+import logging
+import os
+import re
+import tempfile
+import time
+import unicodedata
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any, Dict, Optional, Tuple
+
+import orjson
+
+logger = logging.getLogger(__name__)
+
+# Bump when the layout of cached entries changes
+CACHE_FORMAT_VERSION = 1
+
+# Request phrasing that does not change the skill itself
+_FILLER_PREFIXES = (
+    "can you teach me how to ", "can you teach me to ", "can you show me how to ",
+    "teach me how to ", "teach me to ", "teach me ", "show me how to ", "show me ",
+    "learn how to ", "learn to ", "learn ", "how do i ", "how do you ", "how to ",
+)
+_FILLER_SUFFIXES = (" please", " for me", " technique")
+_ARTICLE = re.compile(r"^(a|an|the) ")
+
+
+def normalize_query(query: str) -> str:
+    """Fold the spellings of one skill request onto one key.
+
+    Case, punctuation, spacing, leading request phrasing ("how to", "teach
+    me", ...), a leading article and trailing politeness are dropped:
+    "How to do a Karate Chop?" and "karate chop" normalise alike.
+    """
+    text = unicodedata.normalize("NFKC", query).casefold()
+    text = " ".join(re.sub(r"[^\w\s]", " ", text).split())
+    for prefix in _FILLER_PREFIXES:
+        if text.startswith(prefix):
+            text = text[len(prefix):]
+            break
+    for suffix in _FILLER_SUFFIXES:
+        if text.endswith(suffix):
+            text = text[:-len(suffix)]
+    for verb in ("do ", "perform ", "make "):
+        if text.startswith(verb):
+            text = text[len(verb):]
+            break
+    return _ARTICLE.sub("", text).strip()
+
+
+def content_key(*parts: Any) -> str:
+    """SHA-256 over a canonical (sorted-key) JSON encoding of the parts."""
+    blob = orjson.dumps([CACHE_FORMAT_VERSION, *parts], option=orjson.OPT_SORT_KEYS)
+    return hashlib.sha256(blob).hexdigest()
+
+
+@dataclass
+class CachedSkill:
+    """A request served from the cache."""
+    plan_key: str
+    sequence_key: str
+    bundle: Dict[str, Any]
+    servo_sequence: Dict[str, Any]
+    packed: bytes
+    recompiled: bool = False  # the plan was cached but its sequence had to be compiled
+    lookup_ms: float = 0.0
+
+
+class SkillCache:
+    """Plans and compiled sequences under ``root`` (normally outputs/cache)."""
+
+    def __init__(self, root: Path, ttl_hours: float, enabled: bool = True):
+        self.root = Path(root)
+        self.ttl_s = ttl_hours * 3600.0
+        self.enabled = enabled
+        self.hits = 0
+        self.misses = 0
+
+    def _path(self, kind: str, key: str, suffix: str) -> Path:
+        return self.root / kind / key[:2] / f"{key}{suffix}"
+
+    def _write(self, path: Path, data: bytes) -> None:
+        path.parent.mkdir(parents=True, exist_ok=True)
+        fd, tmp = tempfile.mkstemp(dir=path.parent, prefix=".tmp-")
+        try:
+            with os.fdopen(fd, "wb") as f:
+                f.write(data)
+            os.replace(tmp, path)
+        except BaseException:
+            try:
+                os.unlink(tmp)
+            except OSError:
+                pass
+            raise
+
+    def _read_json(self, path: Path) -> Optional[Dict[str, Any]]:
+        try:
+            with open(path, "rb") as f:
+                return orjson.loads(f.read())
+        except FileNotFoundError:
+            return None
+        except (OSError, orjson.JSONDecodeError) as e:
+            logger.warning("Ignoring unreadable cache entry %s: %s", path, e)
+            return None
+
+    def load_plan(self, key: str) -> Optional[Dict[str, Any]]:
+        """The cached bundle dict for a plan key, unless missing or expired."""
+        if not self.enabled:
+            return None
+        entry = self._read_json(self._path("plans", key, ".json"))
+        if entry is None:
+            return None
+        if self.ttl_s > 0 and time.time() - float(entry.get("created_at", 0)) > self.ttl_s:
+            logger.info("Plan cache entry %s expired", key[:12])
+            return None
+        return entry.get("bundle")
+
+    def store_plan(self, key: str, query: str, bundle: Dict[str, Any]) -> None:
+        if not self.enabled:
+            return
+        entry = {"key": key, "query": query, "normalized_query": normalize_query(query),
+                 "created_at": time.time(), "bundle": bundle}
+        self._write(self._path("plans", key, ".json"), orjson.dumps(entry))
+
+    def load_sequence(self, key: str) -> Optional[Tuple[Dict[str, Any], bytes]]:
+        """The minimal servo sequence and its packed bytes for a sequence key."""
+        if not self.enabled:
+            return None
+        sequence = self._read_json(self._path("sequences", key, ".json"))
+        if sequence is None:
+            return None
+        try:
+            packed = self._path("sequences", key, ".bin").read_bytes()
+        except OSError:
+            return None
+        return sequence, packed
+
+    def store_sequence(self, key: str, sequence: Dict[str, Any], packed: bytes) -> None:
+        if not self.enabled:
+            return
+        # Binary first: a reader that finds the JSON can rely on the .bin beside it
+        self._write(self._path("sequences", key, ".bin"), packed)
+        self._write(self._path("sequences", key, ".json"), orjson.dumps(sequence))
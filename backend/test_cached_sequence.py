@@ -0,0 +1,145 @@
+"""Test script for the skill-cache and fleet upload paths in app.py."""
+import sys
+from pathlib import Path
+from types import SimpleNamespace
+
+# Add src to path for imports
+sys.path.insert(0, str(Path(__file__).parent / "src"))
+
+import app
+from src.services import robot_fleet
+from src.services.robot_controller import RobotControlGenerator, SEQUENCE_BIN_MAX_STEPS
+
+
+class _Response:
+    def __init__(self, status_code, text=""):
+        self.status_code = status_code
+        self.text = text
+
+    def result(self):
+        return self
+
+
+class _RecordingClient:
+    """Stands in for the shared RobotClient and records every request."""
+
+    def __init__(self, lookup_status=404):
+        self.calls = []
+        self.lookup_status = lookup_status
+
+    def request(self, method, path, **kwargs):
+        self.calls.append((method, path))
+        if method == 'GET':
+            return _Response(self.lookup_status)
+        return _Response(200, '{"status":"accepted"}')
+
+
+def _payload(steps):
+    return {"skill": "test skill", "sequence": [
+        {"commands": [{"id": 1, "deg": 45 + (i % 2) * 90}]} for i in range(steps)]}
+
+
+def _run(payload):
+    """post_cached_sequence() against a fake robot; returns (client, streamed payloads)."""
+    client = _RecordingClient()
+    streamed = []
+    saved = (app.pipeline, app.robot_client, app.post_binary_sequence)
+    app.pipeline = SimpleNamespace(robot_controller=RobotControlGenerator())
+    app.robot_client = lambda base: client
+    app.post_binary_sequence = lambda base, servo_payload, session_id: streamed.append(servo_payload)
+    try:
+        app.post_cached_sequence("http://robot", payload, "test")
+    finally:
+        app.pipeline, app.robot_client, app.post_binary_sequence = saved
+    return client, streamed
+
+
+def test_long_sequence_bypasses_cache():
+    """Past the step table the cache is skipped for the pipelined upload."""
+    payload = _payload(SEQUENCE_BIN_MAX_STEPS + 1)
+    client, streamed = _run(payload)
+    assert streamed == [payload], streamed
+    assert client.calls == [], client.calls
+    print(f"✓ {SEQUENCE_BIN_MAX_STEPS + 1} steps: streamed via /sequence.bin?pipeline=1")
+
+
+def test_short_sequence_uses_cache():
+    """A sequence that fits is stored and replayed through /skills and /play."""
+    client, streamed = _run(_payload(SEQUENCE_BIN_MAX_STEPS))
+    assert streamed == [], streamed
+    methods = [method for method, _ in client.calls]
+    assert methods == ['GET', 'POST', 'POST'], client.calls
+    assert client.calls[2][1].startswith('/play/'), client.calls
+    print(f"✓ {SEQUENCE_BIN_MAX_STEPS} steps: looked up, stored and played from the skill cache")
+
+
+class _RecordingFleet:
+    """Stands in for RobotFleet and records what it was asked to play."""
+    played = []
+
+    def __init__(self, bases, lead_ms=0):
+        pass
+
+    def play_synchronized(self, packed, key, name, streamed=False, playback_ms=0):
+        self.played.append({'steps': int.from_bytes(packed[4:6], 'little'), 'streamed': streamed})
+        return []
+
+
+def test_long_fleet_sequence_is_streamed():
+    """The fleet path packs past the step table and asks for a streamed start."""
+    _RecordingFleet.played = []
+    saved = (app.pipeline, app.RobotFleet)
+    app.pipeline = SimpleNamespace(robot_controller=RobotControlGenerator(),
+                                   config=SimpleNamespace(robot_sync_lead_ms=750))
+    app.RobotFleet = _RecordingFleet
+    try:
+        app.post_fleet_sequence(["http://a", "http://b"], _payload(SEQUENCE_BIN_MAX_STEPS + 1), "test")
+        app.post_fleet_sequence(["http://a", "http://b"], _payload(SEQUENCE_BIN_MAX_STEPS), "test")
+    finally:
+        app.pipeline, app.RobotFleet = saved
+    assert _RecordingFleet.played == [{'steps': SEQUENCE_BIN_MAX_STEPS + 1, 'streamed': True},
+                                      {'steps': SEQUENCE_BIN_MAX_STEPS, 'streamed': False}], _RecordingFleet.played
+    print("✓ fleet: long sequences streamed, short ones through the skill cache")
+
+
+class _RecordingHttpClient:
+    """Stands in for httpx.Client inside RobotFleet._start()."""
+    posts = []
+
+    def __init__(self, timeout=None):
+        self.timeout = timeout
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        return False
+
+    def post(self, url, params=None, **kwargs):
+        self.posts.append({'url': url, 'params': dict(params or {}), 'timeout': self.timeout})
+        return _Response(202)
+
+
+def test_fleet_start_pipelines_streamed_upload():
+    """A streamed start is a scheduled ?pipeline=1 upload with a playback-long timeout."""
+    _RecordingHttpClient.posts = []
+    fleet = robot_fleet.RobotFleet(["http://a"], lead_ms=500, timeout=5.0)
+    prep = {'offset': robot_fleet.ClockOffset(offset_ms=1000.0, rtt_ms=2.0), 'cached': False}
+    saved = robot_fleet.httpx.Client
+    robot_fleet.httpx.Client = _RecordingHttpClient
+    try:
+        result = fleet._start("http://a", prep, b"SQ", "00000000", 0.0, True, 200000)
+    finally:
+        robot_fleet.httpx.Client = saved
+    post = _RecordingHttpClient.posts[0]
+    assert result.ok and post['url'] == "http://a/sequence.bin", post
+    assert post['params'] == {'start_at_ms': '1000', 'pipeline': '1'}, post
+    assert post['timeout'] >= 200.0, post
+    print("✓ fleet: streamed start is POST /sequence.bin?pipeline=1&start_at_ms=...")
+
+
+if __name__ == "__main__":
+    test_long_sequence_bypasses_cache()
+    test_short_sequence_uses_cache()
+    test_long_fleet_sequence_is_streamed()
+    test_fleet_start_pipelines_streamed_upload()
@@ -0,0 +1,64 @@
+"""Test script for compiling and caching servo sequences in SkillLearningPipeline."""
+import sys
+import tempfile
+from pathlib import Path
+from types import SimpleNamespace
+
+# Add src to path for imports
+sys.path.insert(0, str(Path(__file__).parent / "src"))
+
+from src.core.models import ExecutionPlan, ExecutionPhase, PhysicalConstraints
+from src.pipeline.skill_pipeline import SkillLearningPipeline
+from src.services.robot_controller import RobotControlGenerator, SEQUENCE_BIN_MAX_STEPS
+from src.services.skill_cache import SkillCache
+
+WAYPOINTS_PER_PHASE = 30
+
+
+class _AlternatingPlanner:
+    """Stands in for the Cohere servo planner: swings both arms every waypoint."""
+
+    def plan_servo_trajectory(self, **kwargs):
+        return [{"left_arm": {"shoulder_vertical": 45 + (i % 2) * 90},
+                 "right_arm": {"shoulder_vertical": 135 - (i % 2) * 90}}
+                for i in range(WAYPOINTS_PER_PHASE)]
+
+
+def _long_plan(phase_count):
+    phases = [ExecutionPhase(name=f"phase_{i}", duration_ms=600, cue="", pose_hints="", rationale="",
+                             velocity_profile="medium", force_profile="controlled")
+              for i in range(phase_count)]
+    constraints = PhysicalConstraints(max_velocity_hint=1.0, keep_com_in_base=True, workspace_hint="",
+                                      joint_limits={}, safety_margins={})
+    return ExecutionPlan(skill_name="Long drill", phases=phases, constraints=constraints, provenance=[],
+                         complexity_score=0.5)
+
+
+def _pipeline(cache_dir):
+    # Only what compile_servo_sequence() touches; no scraper or LLM clients
+    pipeline = SkillLearningPipeline.__new__(SkillLearningPipeline)
+    pipeline.config = SimpleNamespace(llm=SimpleNamespace(model="test", temperature=0.0, max_tokens=0,
+                                                          api_key=""))
+    pipeline.robot_controller = RobotControlGenerator()
+    pipeline.robot_controller.servo_planner = _AlternatingPlanner()
+    pipeline.cache = SkillCache(Path(cache_dir), ttl_hours=24)
+    return pipeline
+
+
+def test_long_plan_compiles_and_caches():
+    """A plan past the robot's step table still compiles, packs and round-trips the cache."""
+    plan = _long_plan(SEQUENCE_BIN_MAX_STEPS // WAYPOINTS_PER_PHASE + 3)
+    with tempfile.TemporaryDirectory() as cache_dir:
+        pipeline = _pipeline(cache_dir)
+        sequence, packed = pipeline.compile_servo_sequence(plan)
+        steps = RobotControlGenerator.sequence_step_count(sequence)
+        assert steps > SEQUENCE_BIN_MAX_STEPS, steps
+        assert int.from_bytes(packed[4:6], "little") == steps, packed[:8]
+
+        cached = pipeline.compile_servo_sequence(plan)
+        assert cached == (sequence, packed), "second compile should come from the cache"
+    print(f"✓ {steps}-step plan compiled to {len(packed)} packed bytes and served from the cache")
+
+
+if __name__ == "__main__":
+    test_long_plan_compiles_and_caches()
@@ -79,11 +79,13 @@ function Robot() {
               );
             }
           });
+          // {"hold": n} keeps the pose for n steps
+          const stepMs = stepDelayMs * Math.max(1, Number(step?.hold) || 1);
           stepIndex += 1;
           console.log(
-            `[RobotViewer] Scheduling next step (index ${stepIndex}) in ${stepDelayMs}ms`
+            `[RobotViewer] Scheduling next step (index ${stepIndex}) in ${stepMs}ms`
           );
-          setTimeout(applyNext, stepDelayMs);
+          setTimeout(applyNext, stepMs);
         };
 
         applyNext();
@@ -74,8 +74,11 @@ export interface FinalMovementsCommand {
   deg: number;
 }
 
+// Delta encoded: a step lists only the joints that change, and {hold: n}
+// stands for n steps that keep the pose
 export interface FinalMovementsStep {
-  commands: FinalMovementsCommand[];
+  commands?: FinalMovementsCommand[];
+  hold?: number;
 }
 
 export interface FinalMovementsPayload {
@@ -218,6 +221,14 @@ class SkillLearningAPI {
     });
   }
 
+  // Stream a live pose (servo ids 1-6, null to hold) to the robot via the backend's UDP channel
+  streamPose(angles: (number | null)[]) {
+    if (!this.socket) {
+      throw new Error("Not connected to server. Call connect() first.");
+    }
+    this.socket.emit("stream_pose", { angles });
+  }
+
   async healthCheck(): Promise<{
     status: string;
     pipeline_initialized: boolean;
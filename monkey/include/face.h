@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+#include <MCUFRIEND_kbv.h>
+
+// Sprite face - the eyes and mouth are fixed boxes whose frames are RLE
+// bitmaps in flash (include/face_frames.h, generated by
+// tools/gen_face_frames.py). Setting a frame only records it; faceRender()
+// then diffs the old and new frame row by row and pushes just the pixel spans
+// that changed, so a blink or a talking mouth costs a few hundred pixels of
+// bus traffic instead of redrawing circles. RAM use is two decoded rows and
+// one row of colours.
+
+// Order must match EYE_FRAMES in tools/gen_face_frames.py
+enum FaceEyes : uint8_t {
+    EYES_OPEN,
+    EYES_HALF,
+    EYES_CLOSED,
+    EYES_LEFT,
+    EYES_RIGHT,
+    EYES_WIDE,
+    EYE_FRAME_COUNT
+};
+
+// Order must match MOUTH_FRAMES in tools/gen_face_frames.py
+enum FaceMouth : uint8_t {
+    MOUTH_SMILE,
+    MOUTH_TALK,
+    MOUTH_OH,
+    MOUTH_FRAME_COUNT
+};
+
+// Anchor the sprite boxes on (cx, cy) and blit every part in full; call once
+// after the static face has been drawn
+void faceBegin(MCUFRIEND_kbv &display, int cx, int cy, FaceEyes eyes, FaceMouth mouth);
+
+void faceSetEyes(FaceEyes eyes);
+void faceSetMouth(FaceMouth mouth);
+FaceEyes faceEyes();
+FaceMouth faceMouth();
+
+// Push whatever changed since the last call; returns the pixels written
+uint16_t faceRender();
@@ -0,0 +1,279 @@
+// Generated by tools/gen_face_frames.py - edit the script, not this file.
+#pragma once
+
+#include <Arduino.h>
+
+#define FACE_EYE_FRAME_COUNT 6
+#define FACE_MOUTH_FRAME_COUNT 3
+#define FACE_MAX_W 81
+
+// Box origins and sizes relative to the face centre
+#define FACE_EYE_L_X -61
+#define FACE_EYE_L_Y -46
+#define FACE_EYE_L_W 53
+#define FACE_EYE_L_H 53
+#define FACE_EYE_R_X 9
+#define FACE_EYE_R_Y -46
+#define FACE_EYE_R_W 53
+#define FACE_EYE_R_H 53
+#define FACE_MOUTH_X -40
+#define FACE_MOUTH_Y 30
+#define FACE_MOUTH_W 81
+#define FACE_MOUTH_H 31
+
+static const uint16_t FACE_PALETTE[] PROGMEM = {
+    0xFFFF,  // white
+    0x7A22,  // monkeyBrown
+    0xE651,  // monkeyTan
+    0x0000,  // black
+    0x3941,  // darkBrown
+    0xDACB,  // tongue
+};
+
+static const uint8_t RLE_EYE_L_OPEN[] PROGMEM = {
+    0xF9, 0x21, 0x7A, 0xF9, 0x09, 0x92, 0xF9, 0xA2, 0xE9, 0xB2, 0xA9, 0x40, 0xAA, 0x91, 0x70, 0x92,
+    0x79, 0xA0, 0x7A, 0x71, 0xB0, 0x72, 0x61, 0xD0, 0x62, 0x59, 0xE0, 0x5A, 0x51, 0xF0, 0x52, 0x49,
+    0xF8, 0x00, 0x4A, 0x41, 0xF8, 0x10, 0x42, 0x39, 0xF8, 0x20, 0x3A, 0x39, 0x70, 0x33, 0x70, 0x3A,
+    0x31, 0x68, 0x53, 0x68, 0x32, 0x29, 0x60, 0x73, 0x60, 0x2A, 0x29, 0x58, 0x83, 0x58, 0x2A, 0x29,
+    0x50, 0x5B, 0x10, 0x1B, 0x50, 0x2A, 0x21, 0x50, 0x53, 0x30, 0x13, 0x50, 0x22, 0x21, 0x50, 0x53,
+    0x30, 0x13, 0x50, 0x22, 0x21, 0x48, 0x53, 0x40, 0x13, 0x48, 0x22, 0x19, 0x50, 0x53, 0x40, 0x13,
+    0x50, 0x1A, 0x19, 0x48, 0x5B, 0x40, 0x1B, 0x48, 0x1A, 0x19, 0x48, 0x63, 0x30, 0x23, 0x48, 0x1A,
+    0x19, 0x48, 0x63, 0x30, 0x23, 0x48, 0x1A, 0x19, 0x48, 0x73, 0x10, 0x33, 0x48, 0x1A, 0x11, 0x02,
+    0x48, 0xC3, 0x48, 0x1A, 0x09, 0x0A, 0x48, 0xC3, 0x48, 0x1A, 0x09, 0x0A, 0x48, 0xC3, 0x48, 0x1A,
+    0x01, 0x12, 0x50, 0xB3, 0x50, 0x1A, 0x22, 0x48, 0xB3, 0x48, 0x22, 0x22, 0x50, 0xA3, 0x50, 0x22,
+    0x22, 0x50, 0xA3, 0x50, 0x22, 0x2A, 0x50, 0x93, 0x50, 0x2A, 0x2A, 0x58, 0x83, 0x58, 0x2A, 0x2A,
+    0x60, 0x73, 0x60, 0x2A, 0x32, 0x68, 0x53, 0x68, 0x32, 0x3A, 0x70, 0x33, 0x70, 0x3A, 0x3A, 0xF8,
+    0x20, 0x3A, 0x42, 0xF8, 0x10, 0x42, 0x4A, 0xF8, 0x00, 0x4A, 0x52, 0xF0, 0x52, 0x5A, 0xE0, 0x5A,
+    0x62, 0xD0, 0x62, 0x72, 0xB0, 0x72, 0x7A, 0xA0, 0x7A, 0x92, 0x70, 0x92, 0xAA, 0x40, 0xAA, 0xFA,
+    0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_L_HALF[] PROGMEM = {
+    0xF9, 0x21, 0x7A, 0xA9, 0x42, 0x11, 0x92, 0x89, 0xFA, 0x12, 0x79, 0xFA, 0x22, 0x69, 0xFA, 0x32,
+    0x59, 0xFA, 0x42, 0x51, 0xFA, 0x4A, 0x49, 0xFA, 0x52, 0x41, 0xFA, 0x5A, 0x39, 0xFA, 0x62, 0x31,
+    0xFA, 0x6A, 0x29, 0xFA, 0x72, 0x21, 0xFA, 0x7A, 0x21, 0xFA, 0x7A, 0x19, 0xFA, 0x82, 0x19, 0xFA,
+    0x82, 0x11, 0xFA, 0x8A, 0x11, 0x12, 0xFC, 0x44, 0x2A, 0x09, 0x1A, 0xFC, 0x44, 0x2A, 0x09, 0x12,
+    0xFC, 0x54, 0x22, 0x09, 0x12, 0x50, 0xA3, 0x50, 0x22, 0x09, 0x12, 0x48, 0xB3, 0x48, 0x22, 0x01,
+    0x12, 0x50, 0xB3, 0x50, 0x1A, 0x01, 0x12, 0x48, 0xC3, 0x48, 0x1A, 0x01, 0x12, 0x48, 0xC3, 0x48,
+    0x1A, 0x01, 0x12, 0x48, 0xC3, 0x48, 0x1A, 0x01, 0x12, 0x48, 0xC3, 0x48, 0x1A, 0x01, 0x12, 0x48,
+    0xC3, 0x48, 0x1A, 0x01, 0x12, 0x48, 0xC3, 0x48, 0x1A, 0x01, 0x12, 0x48, 0xC3, 0x48, 0x1A, 0x01,
+    0x12, 0x50, 0xB3, 0x50, 0x1A, 0x22, 0x48, 0xB3, 0x48, 0x22, 0x22, 0x50, 0xA3, 0x50, 0x22, 0x22,
+    0x50, 0xA3, 0x50, 0x22, 0x2A, 0x50, 0x93, 0x50, 0x2A, 0x2A, 0x58, 0x83, 0x58, 0x2A, 0x2A, 0x60,
+    0x73, 0x60, 0x2A, 0x32, 0x68, 0x53, 0x68, 0x32, 0x3A, 0x70, 0x33, 0x70, 0x3A, 0x3A, 0xF8, 0x20,
+    0x3A, 0x42, 0xF8, 0x10, 0x42, 0x4A, 0xF8, 0x00, 0x4A, 0x52, 0xF0, 0x52, 0x5A, 0xE0, 0x5A, 0x62,
+    0xD0, 0x62, 0x72, 0xB0, 0x72, 0x7A, 0xA0, 0x7A, 0x92, 0x70, 0x92, 0xAA, 0x40, 0xAA, 0xFA, 0xA2,
+    0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_L_CLOSED[] PROGMEM = {
+    0xF9, 0x21, 0x7A, 0xA9, 0x42, 0x11, 0x92, 0x89, 0xFA, 0x12, 0x79, 0xFA, 0x22, 0x69, 0xFA, 0x32,
+    0x59, 0xFA, 0x42, 0x51, 0xFA, 0x4A, 0x49, 0xFA, 0x52, 0x41, 0xFA, 0x5A, 0x39, 0xFA, 0x62, 0x31,
+    0xFA, 0x6A, 0x29, 0xFA, 0x72, 0x21, 0xFA, 0x7A, 0x21, 0xFA, 0x7A, 0x19, 0xFA, 0x82, 0x19, 0xFA,
+    0x82, 0x11, 0xFA, 0x8A, 0x11, 0xFA, 0x8A, 0x09, 0xFA, 0x92, 0x09, 0xFA, 0x92, 0x09, 0xFA, 0x92,
+    0x09, 0xFA, 0x92, 0x01, 0xFA, 0x9A, 0x01, 0xFA, 0x9A, 0x01, 0x72, 0x9C, 0x82, 0x01, 0x72, 0x9C,
+    0x82, 0x01, 0x72, 0x9C, 0x82, 0x01, 0x72, 0x9C, 0x82, 0x01, 0xFA, 0x9A, 0x01, 0xFA, 0x9A, 0x01,
+    0xFA, 0x9A, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+    0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+    0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_L_LEFT[] PROGMEM = {
+    0xF9, 0x21, 0x7A, 0xF9, 0x09, 0x92, 0xF9, 0xA2, 0xE9, 0xB2, 0xA9, 0x40, 0xAA, 0x91, 0x70, 0x92,
+    0x79, 0xA0, 0x7A, 0x71, 0xB0, 0x72, 0x61, 0xD0, 0x62, 0x59, 0xE0, 0x5A, 0x51, 0xF0, 0x52, 0x49,
+    0xF8, 0x00, 0x4A, 0x41, 0xF8, 0x10, 0x42, 0x39, 0xF8, 0x20, 0x3A, 0x39, 0x30, 0x33, 0xB0, 0x3A,
+    0x31, 0x28, 0x53, 0xA8, 0x32, 0x29, 0x20, 0x73, 0xA0, 0x2A, 0x29, 0x18, 0x83, 0x98, 0x2A, 0x29,
+    0x10, 0x5B, 0x10, 0x1B, 0x90, 0x2A, 0x21, 0x10, 0x53, 0x30, 0x13, 0x90, 0x22, 0x21, 0x10, 0x53,
+    0x30, 0x13, 0x90, 0x22, 0x21, 0x08, 0x53, 0x40, 0x13, 0x88, 0x22, 0x19, 0x10, 0x53, 0x40, 0x13,
+    0x90, 0x1A, 0x19, 0x08, 0x5B, 0x40, 0x1B, 0x88, 0x1A, 0x19, 0x08, 0x63, 0x30, 0x23, 0x88, 0x1A,
+    0x19, 0x08, 0x63, 0x30, 0x23, 0x88, 0x1A, 0x19, 0x08, 0x73, 0x10, 0x33, 0x88, 0x1A, 0x11, 0x02,
+    0x08, 0xC3, 0x88, 0x1A, 0x09, 0x0A, 0x08, 0xC3, 0x88, 0x1A, 0x09, 0x0A, 0x08, 0xC3, 0x88, 0x1A,
+    0x01, 0x12, 0x10, 0xB3, 0x90, 0x1A, 0x22, 0x08, 0xB3, 0x88, 0x22, 0x22, 0x10, 0xA3, 0x90, 0x22,
+    0x22, 0x10, 0xA3, 0x90, 0x22, 0x2A, 0x10, 0x93, 0x90, 0x2A, 0x2A, 0x18, 0x83, 0x98, 0x2A, 0x2A,
+    0x20, 0x73, 0xA0, 0x2A, 0x32, 0x28, 0x53, 0xA8, 0x32, 0x3A, 0x30, 0x33, 0xB0, 0x3A, 0x3A, 0xF8,
+    0x20, 0x3A, 0x42, 0xF8, 0x10, 0x42, 0x4A, 0xF8, 0x00, 0x4A, 0x52, 0xF0, 0x52, 0x5A, 0xE0, 0x5A,
+    0x62, 0xD0, 0x62, 0x72, 0xB0, 0x72, 0x7A, 0xA0, 0x7A, 0x92, 0x70, 0x92, 0xAA, 0x40, 0xAA, 0xFA,
+    0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_L_RIGHT[] PROGMEM = {
+    0xF9, 0x21, 0x7A, 0xF9, 0x09, 0x92, 0xF9, 0xA2, 0xE9, 0xB2, 0xA9, 0x40, 0xAA, 0x91, 0x70, 0x92,
+    0x79, 0xA0, 0x7A, 0x71, 0xB0, 0x72, 0x61, 0xD0, 0x62, 0x59, 0xE0, 0x5A, 0x51, 0xF0, 0x52, 0x49,
+    0xF8, 0x00, 0x4A, 0x41, 0xF8, 0x10, 0x42, 0x39, 0xF8, 0x20, 0x3A, 0x39, 0xB0, 0x33, 0x30, 0x3A,
+    0x31, 0xA8, 0x53, 0x28, 0x32, 0x29, 0xA0, 0x73, 0x20, 0x2A, 0x29, 0x98, 0x83, 0x18, 0x2A, 0x29,
+    0x90, 0x5B, 0x10, 0x1B, 0x10, 0x2A, 0x21, 0x90, 0x53, 0x30, 0x13, 0x10, 0x22, 0x21, 0x90, 0x53,
+    0x30, 0x13, 0x10, 0x22, 0x21, 0x88, 0x53, 0x40, 0x13, 0x08, 0x22, 0x19, 0x90, 0x53, 0x40, 0x13,
+    0x10, 0x1A, 0x19, 0x88, 0x5B, 0x40, 0x1B, 0x08, 0x1A, 0x19, 0x88, 0x63, 0x30, 0x23, 0x08, 0x1A,
+    0x19, 0x88, 0x63, 0x30, 0x23, 0x08, 0x1A, 0x19, 0x88, 0x73, 0x10, 0x33, 0x08, 0x1A, 0x11, 0x02,
+    0x88, 0xC3, 0x08, 0x1A, 0x09, 0x0A, 0x88, 0xC3, 0x08, 0x1A, 0x09, 0x0A, 0x88, 0xC3, 0x08, 0x1A,
+    0x01, 0x12, 0x90, 0xB3, 0x10, 0x1A, 0x22, 0x88, 0xB3, 0x08, 0x22, 0x22, 0x90, 0xA3, 0x10, 0x22,
+    0x22, 0x90, 0xA3, 0x10, 0x22, 0x2A, 0x90, 0x93, 0x10, 0x2A, 0x2A, 0x98, 0x83, 0x18, 0x2A, 0x2A,
+    0xA0, 0x73, 0x20, 0x2A, 0x32, 0xA8, 0x53, 0x28, 0x32, 0x3A, 0xB0, 0x33, 0x30, 0x3A, 0x3A, 0xF8,
+    0x20, 0x3A, 0x42, 0xF8, 0x10, 0x42, 0x4A, 0xF8, 0x00, 0x4A, 0x52, 0xF0, 0x52, 0x5A, 0xE0, 0x5A,
+    0x62, 0xD0, 0x62, 0x72, 0xB0, 0x72, 0x7A, 0xA0, 0x7A, 0x92, 0x70, 0x92, 0xAA, 0x40, 0xAA, 0xFA,
+    0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_L_WIDE[] PROGMEM = {
+    0xF9, 0x21, 0x7A, 0xA9, 0x42, 0x11, 0x92, 0x89, 0x1A, 0x40, 0xAA, 0x79, 0x0A, 0x80, 0x8A, 0x69,
+    0x0A, 0xA0, 0x7A, 0x59, 0x0A, 0xC0, 0x6A, 0x51, 0x0A, 0xD0, 0x62, 0x49, 0x02, 0xF0, 0x52, 0x41,
+    0x02, 0xF8, 0x00, 0x4A, 0x39, 0x02, 0xF8, 0x10, 0x42, 0x31, 0x02, 0xF8, 0x20, 0x3A, 0x29, 0x02,
+    0xF8, 0x30, 0x32, 0x21, 0x0A, 0xF8, 0x30, 0x32, 0x21, 0x02, 0xF8, 0x40, 0x2A, 0x19, 0x02, 0xF8,
+    0x50, 0x22, 0x19, 0x02, 0xF8, 0x50, 0x22, 0x11, 0x02, 0xF8, 0x60, 0x1A, 0x11, 0x02, 0xF8, 0x60,
+    0x1A, 0x09, 0x02, 0xA0, 0x23, 0xA0, 0x12, 0x09, 0x02, 0x90, 0x43, 0x90, 0x12, 0x09, 0x02, 0x88,
+    0x33, 0x10, 0x03, 0x88, 0x12, 0x09, 0x02, 0x80, 0x33, 0x20, 0x03, 0x80, 0x12, 0x01, 0x02, 0x80,
+    0x33, 0x30, 0x03, 0x80, 0x0A, 0x01, 0x02, 0x80, 0x33, 0x30, 0x03, 0x80, 0x0A, 0x01, 0x02, 0x78,
+    0x3B, 0x30, 0x0B, 0x78, 0x0A, 0x01, 0x02, 0x78, 0x43, 0x20, 0x13, 0x78, 0x0A, 0x01, 0x02, 0x78,
+    0x4B, 0x10, 0x1B, 0x78, 0x0A, 0x01, 0x02, 0x78, 0x83, 0x78, 0x0A, 0x01, 0x02, 0x78, 0x83, 0x78,
+    0x0A, 0x01, 0x02, 0x80, 0x73, 0x80, 0x0A, 0x01, 0x02, 0x80, 0x73, 0x80, 0x0A, 0x12, 0x80, 0x63,
+    0x80, 0x12, 0x12, 0x88, 0x53, 0x88, 0x12, 0x12, 0x90, 0x43, 0x90, 0x12, 0x12, 0xA0, 0x23, 0xA0,
+    0x12, 0x1A, 0xF8, 0x60, 0x1A, 0x1A, 0xF8, 0x60, 0x1A, 0x22, 0xF8, 0x50, 0x22, 0x22, 0xF8, 0x50,
+    0x22, 0x2A, 0xF8, 0x40, 0x2A, 0x32, 0xF8, 0x30, 0x32, 0x32, 0xF8, 0x30, 0x32, 0x3A, 0xF8, 0x20,
+    0x3A, 0x42, 0xF8, 0x10, 0x42, 0x4A, 0xF8, 0x00, 0x4A, 0x52, 0xF0, 0x52, 0x62, 0xD0, 0x62, 0x6A,
+    0xC0, 0x6A, 0x7A, 0xA0, 0x7A, 0x8A, 0x80, 0x8A, 0xAA, 0x40, 0xAA, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_R_OPEN[] PROGMEM = {
+    0x7A, 0xF9, 0x21, 0x92, 0xF9, 0x09, 0xA2, 0xF9, 0xB2, 0xE9, 0xAA, 0x40, 0xA9, 0x92, 0x70, 0x91,
+    0x7A, 0xA0, 0x79, 0x72, 0xB0, 0x71, 0x62, 0xD0, 0x61, 0x5A, 0xE0, 0x59, 0x52, 0xF0, 0x51, 0x4A,
+    0xF8, 0x00, 0x49, 0x42, 0xF8, 0x10, 0x41, 0x3A, 0xF8, 0x20, 0x39, 0x3A, 0x70, 0x33, 0x70, 0x39,
+    0x32, 0x68, 0x53, 0x68, 0x31, 0x2A, 0x60, 0x73, 0x60, 0x29, 0x2A, 0x58, 0x83, 0x58, 0x29, 0x2A,
+    0x50, 0x5B, 0x10, 0x1B, 0x50, 0x29, 0x22, 0x50, 0x53, 0x30, 0x13, 0x50, 0x21, 0x22, 0x50, 0x53,
+    0x30, 0x13, 0x50, 0x21, 0x22, 0x48, 0x53, 0x40, 0x13, 0x48, 0x21, 0x1A, 0x50, 0x53, 0x40, 0x13,
+    0x50, 0x19, 0x1A, 0x48, 0x5B, 0x40, 0x1B, 0x48, 0x19, 0x1A, 0x48, 0x63, 0x30, 0x23, 0x48, 0x19,
+    0x1A, 0x48, 0x63, 0x30, 0x23, 0x48, 0x19, 0x1A, 0x48, 0x73, 0x10, 0x33, 0x48, 0x19, 0x1A, 0x48,
+    0xC3, 0x48, 0x02, 0x11, 0x1A, 0x48, 0xC3, 0x48, 0x0A, 0x09, 0x1A, 0x48, 0xC3, 0x48, 0x0A, 0x09,
+    0x1A, 0x50, 0xB3, 0x50, 0x12, 0x01, 0x22, 0x48, 0xB3, 0x48, 0x22, 0x22, 0x50, 0xA3, 0x50, 0x22,
+    0x22, 0x50, 0xA3, 0x50, 0x22, 0x2A, 0x50, 0x93, 0x50, 0x2A, 0x2A, 0x58, 0x83, 0x58, 0x2A, 0x2A,
+    0x60, 0x73, 0x60, 0x2A, 0x32, 0x68, 0x53, 0x68, 0x32, 0x3A, 0x70, 0x33, 0x70, 0x3A, 0x3A, 0xF8,
+    0x20, 0x3A, 0x42, 0xF8, 0x10, 0x42, 0x4A, 0xF8, 0x00, 0x4A, 0x52, 0xF0, 0x52, 0x5A, 0xE0, 0x5A,
+    0x62, 0xD0, 0x62, 0x72, 0xB0, 0x72, 0x7A, 0xA0, 0x7A, 0x92, 0x70, 0x92, 0xAA, 0x40, 0xAA, 0xFA,
+    0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_R_HALF[] PROGMEM = {
+    0x7A, 0xF9, 0x21, 0x92, 0x11, 0x42, 0xA9, 0xFA, 0x12, 0x89, 0xFA, 0x22, 0x79, 0xFA, 0x32, 0x69,
+    0xFA, 0x42, 0x59, 0xFA, 0x4A, 0x51, 0xFA, 0x52, 0x49, 0xFA, 0x5A, 0x41, 0xFA, 0x62, 0x39, 0xFA,
+    0x6A, 0x31, 0xFA, 0x72, 0x29, 0xFA, 0x7A, 0x21, 0xFA, 0x7A, 0x21, 0xFA, 0x82, 0x19, 0xFA, 0x82,
+    0x19, 0xFA, 0x8A, 0x11, 0x2A, 0xFC, 0x44, 0x12, 0x11, 0x2A, 0xFC, 0x44, 0x1A, 0x09, 0x22, 0xFC,
+    0x54, 0x12, 0x09, 0x22, 0x50, 0xA3, 0x50, 0x12, 0x09, 0x22, 0x48, 0xB3, 0x48, 0x12, 0x09, 0x1A,
+    0x50, 0xB3, 0x50, 0x12, 0x01, 0x1A, 0x48, 0xC3, 0x48, 0x12, 0x01, 0x1A, 0x48, 0xC3, 0x48, 0x12,
+    0x01, 0x1A, 0x48, 0xC3, 0x48, 0x12, 0x01, 0x1A, 0x48, 0xC3, 0x48, 0x12, 0x01, 0x1A, 0x48, 0xC3,
+    0x48, 0x12, 0x01, 0x1A, 0x48, 0xC3, 0x48, 0x12, 0x01, 0x1A, 0x48, 0xC3, 0x48, 0x12, 0x01, 0x1A,
+    0x50, 0xB3, 0x50, 0x12, 0x01, 0x22, 0x48, 0xB3, 0x48, 0x22, 0x22, 0x50, 0xA3, 0x50, 0x22, 0x22,
+    0x50, 0xA3, 0x50, 0x22, 0x2A, 0x50, 0x93, 0x50, 0x2A, 0x2A, 0x58, 0x83, 0x58, 0x2A, 0x2A, 0x60,
+    0x73, 0x60, 0x2A, 0x32, 0x68, 0x53, 0x68, 0x32, 0x3A, 0x70, 0x33, 0x70, 0x3A, 0x3A, 0xF8, 0x20,
+    0x3A, 0x42, 0xF8, 0x10, 0x42, 0x4A, 0xF8, 0x00, 0x4A, 0x52, 0xF0, 0x52, 0x5A, 0xE0, 0x5A, 0x62,
+    0xD0, 0x62, 0x72, 0xB0, 0x72, 0x7A, 0xA0, 0x7A, 0x92, 0x70, 0x92, 0xAA, 0x40, 0xAA, 0xFA, 0xA2,
+    0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_R_CLOSED[] PROGMEM = {
+    0x7A, 0xF9, 0x21, 0x92, 0x11, 0x42, 0xA9, 0xFA, 0x12, 0x89, 0xFA, 0x22, 0x79, 0xFA, 0x32, 0x69,
+    0xFA, 0x42, 0x59, 0xFA, 0x4A, 0x51, 0xFA, 0x52, 0x49, 0xFA, 0x5A, 0x41, 0xFA, 0x62, 0x39, 0xFA,
+    0x6A, 0x31, 0xFA, 0x72, 0x29, 0xFA, 0x7A, 0x21, 0xFA, 0x7A, 0x21, 0xFA, 0x82, 0x19, 0xFA, 0x82,
+    0x19, 0xFA, 0x8A, 0x11, 0xFA, 0x8A, 0x11, 0xFA, 0x92, 0x09, 0xFA, 0x92, 0x09, 0xFA, 0x92, 0x09,
+    0xFA, 0x92, 0x09, 0xFA, 0x9A, 0x01, 0xFA, 0x9A, 0x01, 0x7A, 0x9C, 0x7A, 0x01, 0x7A, 0x9C, 0x7A,
+    0x01, 0x7A, 0x9C, 0x7A, 0x01, 0x7A, 0x9C, 0x7A, 0x01, 0xFA, 0x9A, 0x01, 0xFA, 0x9A, 0x01, 0xFA,
+    0x9A, 0x01, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+    0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+    0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_R_LEFT[] PROGMEM = {
+    0x7A, 0xF9, 0x21, 0x92, 0xF9, 0x09, 0xA2, 0xF9, 0xB2, 0xE9, 0xAA, 0x40, 0xA9, 0x92, 0x70, 0x91,
+    0x7A, 0xA0, 0x79, 0x72, 0xB0, 0x71, 0x62, 0xD0, 0x61, 0x5A, 0xE0, 0x59, 0x52, 0xF0, 0x51, 0x4A,
+    0xF8, 0x00, 0x49, 0x42, 0xF8, 0x10, 0x41, 0x3A, 0xF8, 0x20, 0x39, 0x3A, 0x30, 0x33, 0xB0, 0x39,
+    0x32, 0x28, 0x53, 0xA8, 0x31, 0x2A, 0x20, 0x73, 0xA0, 0x29, 0x2A, 0x18, 0x83, 0x98, 0x29, 0x2A,
+    0x10, 0x5B, 0x10, 0x1B, 0x90, 0x29, 0x22, 0x10, 0x53, 0x30, 0x13, 0x90, 0x21, 0x22, 0x10, 0x53,
+    0x30, 0x13, 0x90, 0x21, 0x22, 0x08, 0x53, 0x40, 0x13, 0x88, 0x21, 0x1A, 0x10, 0x53, 0x40, 0x13,
+    0x90, 0x19, 0x1A, 0x08, 0x5B, 0x40, 0x1B, 0x88, 0x19, 0x1A, 0x08, 0x63, 0x30, 0x23, 0x88, 0x19,
+    0x1A, 0x08, 0x63, 0x30, 0x23, 0x88, 0x19, 0x1A, 0x08, 0x73, 0x10, 0x33, 0x88, 0x19, 0x1A, 0x08,
+    0xC3, 0x88, 0x02, 0x11, 0x1A, 0x08, 0xC3, 0x88, 0x0A, 0x09, 0x1A, 0x08, 0xC3, 0x88, 0x0A, 0x09,
+    0x1A, 0x10, 0xB3, 0x90, 0x12, 0x01, 0x22, 0x08, 0xB3, 0x88, 0x22, 0x22, 0x10, 0xA3, 0x90, 0x22,
+    0x22, 0x10, 0xA3, 0x90, 0x22, 0x2A, 0x10, 0x93, 0x90, 0x2A, 0x2A, 0x18, 0x83, 0x98, 0x2A, 0x2A,
+    0x20, 0x73, 0xA0, 0x2A, 0x32, 0x28, 0x53, 0xA8, 0x32, 0x3A, 0x30, 0x33, 0xB0, 0x3A, 0x3A, 0xF8,
+    0x20, 0x3A, 0x42, 0xF8, 0x10, 0x42, 0x4A, 0xF8, 0x00, 0x4A, 0x52, 0xF0, 0x52, 0x5A, 0xE0, 0x5A,
+    0x62, 0xD0, 0x62, 0x72, 0xB0, 0x72, 0x7A, 0xA0, 0x7A, 0x92, 0x70, 0x92, 0xAA, 0x40, 0xAA, 0xFA,
+    0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_R_RIGHT[] PROGMEM = {
+    0x7A, 0xF9, 0x21, 0x92, 0xF9, 0x09, 0xA2, 0xF9, 0xB2, 0xE9, 0xAA, 0x40, 0xA9, 0x92, 0x70, 0x91,
+    0x7A, 0xA0, 0x79, 0x72, 0xB0, 0x71, 0x62, 0xD0, 0x61, 0x5A, 0xE0, 0x59, 0x52, 0xF0, 0x51, 0x4A,
+    0xF8, 0x00, 0x49, 0x42, 0xF8, 0x10, 0x41, 0x3A, 0xF8, 0x20, 0x39, 0x3A, 0xB0, 0x33, 0x30, 0x39,
+    0x32, 0xA8, 0x53, 0x28, 0x31, 0x2A, 0xA0, 0x73, 0x20, 0x29, 0x2A, 0x98, 0x83, 0x18, 0x29, 0x2A,
+    0x90, 0x5B, 0x10, 0x1B, 0x10, 0x29, 0x22, 0x90, 0x53, 0x30, 0x13, 0x10, 0x21, 0x22, 0x90, 0x53,
+    0x30, 0x13, 0x10, 0x21, 0x22, 0x88, 0x53, 0x40, 0x13, 0x08, 0x21, 0x1A, 0x90, 0x53, 0x40, 0x13,
+    0x10, 0x19, 0x1A, 0x88, 0x5B, 0x40, 0x1B, 0x08, 0x19, 0x1A, 0x88, 0x63, 0x30, 0x23, 0x08, 0x19,
+    0x1A, 0x88, 0x63, 0x30, 0x23, 0x08, 0x19, 0x1A, 0x88, 0x73, 0x10, 0x33, 0x08, 0x19, 0x1A, 0x88,
+    0xC3, 0x08, 0x02, 0x11, 0x1A, 0x88, 0xC3, 0x08, 0x0A, 0x09, 0x1A, 0x88, 0xC3, 0x08, 0x0A, 0x09,
+    0x1A, 0x90, 0xB3, 0x10, 0x12, 0x01, 0x22, 0x88, 0xB3, 0x08, 0x22, 0x22, 0x90, 0xA3, 0x10, 0x22,
+    0x22, 0x90, 0xA3, 0x10, 0x22, 0x2A, 0x90, 0x93, 0x10, 0x2A, 0x2A, 0x98, 0x83, 0x18, 0x2A, 0x2A,
+    0xA0, 0x73, 0x20, 0x2A, 0x32, 0xA8, 0x53, 0x28, 0x32, 0x3A, 0xB0, 0x33, 0x30, 0x3A, 0x3A, 0xF8,
+    0x20, 0x3A, 0x42, 0xF8, 0x10, 0x42, 0x4A, 0xF8, 0x00, 0x4A, 0x52, 0xF0, 0x52, 0x5A, 0xE0, 0x5A,
+    0x62, 0xD0, 0x62, 0x72, 0xB0, 0x72, 0x7A, 0xA0, 0x7A, 0x92, 0x70, 0x92, 0xAA, 0x40, 0xAA, 0xFA,
+    0xA2, 0xFA, 0xA2, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_EYE_R_WIDE[] PROGMEM = {
+    0x7A, 0xF9, 0x21, 0x92, 0x11, 0x42, 0xA9, 0xAA, 0x40, 0x1A, 0x89, 0x8A, 0x80, 0x0A, 0x79, 0x7A,
+    0xA0, 0x0A, 0x69, 0x6A, 0xC0, 0x0A, 0x59, 0x62, 0xD0, 0x0A, 0x51, 0x52, 0xF0, 0x02, 0x49, 0x4A,
+    0xF8, 0x00, 0x02, 0x41, 0x42, 0xF8, 0x10, 0x02, 0x39, 0x3A, 0xF8, 0x20, 0x02, 0x31, 0x32, 0xF8,
+    0x30, 0x02, 0x29, 0x32, 0xF8, 0x30, 0x0A, 0x21, 0x2A, 0xF8, 0x40, 0x02, 0x21, 0x22, 0xF8, 0x50,
+    0x02, 0x19, 0x22, 0xF8, 0x50, 0x02, 0x19, 0x1A, 0xF8, 0x60, 0x02, 0x11, 0x1A, 0xF8, 0x60, 0x02,
+    0x11, 0x12, 0xA0, 0x23, 0xA0, 0x02, 0x09, 0x12, 0x90, 0x43, 0x90, 0x02, 0x09, 0x12, 0x88, 0x33,
+    0x10, 0x03, 0x88, 0x02, 0x09, 0x12, 0x80, 0x33, 0x20, 0x03, 0x80, 0x02, 0x09, 0x0A, 0x80, 0x33,
+    0x30, 0x03, 0x80, 0x02, 0x01, 0x0A, 0x80, 0x33, 0x30, 0x03, 0x80, 0x02, 0x01, 0x0A, 0x78, 0x3B,
+    0x30, 0x0B, 0x78, 0x02, 0x01, 0x0A, 0x78, 0x43, 0x20, 0x13, 0x78, 0x02, 0x01, 0x0A, 0x78, 0x4B,
+    0x10, 0x1B, 0x78, 0x02, 0x01, 0x0A, 0x78, 0x83, 0x78, 0x02, 0x01, 0x0A, 0x78, 0x83, 0x78, 0x02,
+    0x01, 0x0A, 0x80, 0x73, 0x80, 0x02, 0x01, 0x0A, 0x80, 0x73, 0x80, 0x02, 0x01, 0x12, 0x80, 0x63,
+    0x80, 0x12, 0x12, 0x88, 0x53, 0x88, 0x12, 0x12, 0x90, 0x43, 0x90, 0x12, 0x12, 0xA0, 0x23, 0xA0,
+    0x12, 0x1A, 0xF8, 0x60, 0x1A, 0x1A, 0xF8, 0x60, 0x1A, 0x22, 0xF8, 0x50, 0x22, 0x22, 0xF8, 0x50,
+    0x22, 0x2A, 0xF8, 0x40, 0x2A, 0x32, 0xF8, 0x30, 0x32, 0x32, 0xF8, 0x30, 0x32, 0x3A, 0xF8, 0x20,
+    0x3A, 0x42, 0xF8, 0x10, 0x42, 0x4A, 0xF8, 0x00, 0x4A, 0x52, 0xF0, 0x52, 0x62, 0xD0, 0x62, 0x6A,
+    0xC0, 0x6A, 0x7A, 0xA0, 0x7A, 0x8A, 0x80, 0x8A, 0xAA, 0x40, 0xAA, 0xFA, 0xA2, 0xFA, 0xA2,
+};
+
+static const uint8_t RLE_MOUTH_SMILE[] PROGMEM = {
+    0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0x1A, 0x14, 0xFA, 0xFA, 0x0A, 0x1C, 0x1A,
+    0x12, 0x24, 0xFA, 0xFA, 0x2C, 0x12, 0x12, 0x24, 0xFA, 0xFA, 0x2C, 0x12, 0x12, 0x24, 0xFA, 0xFA,
+    0x2C, 0x12, 0x12, 0x24, 0xFA, 0xFA, 0x24, 0x1A, 0x12, 0x2C, 0xFA, 0xEA, 0x2C, 0x1A, 0x12, 0x2C,
+    0xFA, 0xEA, 0x2C, 0x1A, 0x12, 0x34, 0xFA, 0xDA, 0x34, 0x1A, 0x1A, 0x2C, 0xFA, 0xDA, 0x2C, 0x22,
+    0x1A, 0x34, 0xFA, 0xCA, 0x34, 0x22, 0x22, 0x34, 0xFA, 0xBA, 0x34, 0x2A, 0x2A, 0x34, 0xFA, 0xAA,
+    0x34, 0x32, 0x2A, 0x44, 0xFA, 0x8A, 0x44, 0x32, 0x32, 0x44, 0xFA, 0x7A, 0x44, 0x3A, 0x3A, 0x4C,
+    0xFA, 0x5A, 0x4C, 0x42, 0x42, 0x54, 0xFA, 0x3A, 0x54, 0x4A, 0x52, 0x5C, 0xFA, 0x0A, 0x5C, 0x5A,
+    0x5A, 0x6C, 0xDA, 0x6C, 0x62, 0x6A, 0x7C, 0x9A, 0x7C, 0x72, 0x7A, 0xFC, 0x7C, 0x82, 0x8A, 0xFC,
+    0x5C, 0x92, 0x9A, 0xFC, 0x3C, 0xA2, 0xBA, 0xFC, 0xC2, 0xDA, 0xBC, 0xE2, 0xFA, 0x32, 0x14, 0xFA,
+    0x32, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82,
+};
+
+static const uint8_t RLE_MOUTH_TALK[] PROGMEM = {
+    0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0x12, 0xFC, 0xFC, 0x54, 0x12, 0x12, 0xFC,
+    0xFC, 0x54, 0x12, 0x12, 0xFC, 0xFC, 0x54, 0x12, 0x2A, 0xFC, 0xFC, 0x24, 0x2A, 0x2A, 0xFC, 0xFC,
+    0x24, 0x2A, 0x2A, 0xFC, 0xFC, 0x24, 0x2A, 0x2A, 0xFC, 0xFC, 0x24, 0x2A, 0x32, 0xFC, 0xFC, 0x14,
+    0x32, 0x32, 0xFC, 0xFC, 0x14, 0x32, 0x3A, 0xFC, 0xFC, 0x04, 0x3A, 0x3A, 0xFC, 0xFC, 0x04, 0x3A,
+    0x42, 0xFC, 0xF4, 0x42, 0x4A, 0xFC, 0xE4, 0x4A, 0x52, 0xA4, 0x85, 0xA4, 0x52, 0x5A, 0x84, 0xB5,
+    0x84, 0x5A, 0x62, 0x74, 0xC5, 0x74, 0x62, 0x6A, 0x64, 0xD5, 0x64, 0x6A, 0x7A, 0x54, 0xD5, 0x54,
+    0x7A, 0x8A, 0x44, 0xD5, 0x44, 0x8A, 0x9A, 0x3C, 0xC5, 0x3C, 0x9A, 0xAA, 0x3C, 0xA5, 0x3C, 0xAA,
+    0xCA, 0x6C, 0x05, 0x6C, 0xCA, 0xEA, 0xA4, 0xEA, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA,
+    0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82,
+};
+
+static const uint8_t RLE_MOUTH_OH[] PROGMEM = {
+    0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA,
+    0x12, 0x54, 0xFA, 0x12, 0xFA, 0x02, 0x74, 0xFA, 0x02, 0xFA, 0x84, 0xFA, 0xEA, 0xA4, 0xEA, 0xEA,
+    0x2C, 0x43, 0x2C, 0xEA, 0xE2, 0x2C, 0x53, 0x2C, 0xE2, 0xDA, 0x2C, 0x63, 0x2C, 0xDA, 0xDA, 0x24,
+    0x73, 0x24, 0xDA, 0xDA, 0x24, 0x73, 0x24, 0xDA, 0xDA, 0x24, 0x73, 0x24, 0xDA, 0xDA, 0x24, 0x73,
+    0x24, 0xDA, 0xDA, 0x24, 0x73, 0x24, 0xDA, 0xDA, 0x24, 0x73, 0x24, 0xDA, 0xDA, 0x24, 0x73, 0x24,
+    0xDA, 0xDA, 0x2C, 0x63, 0x2C, 0xDA, 0xE2, 0x2C, 0x53, 0x2C, 0xE2, 0xEA, 0x2C, 0x43, 0x2C, 0xEA,
+    0xEA, 0xA4, 0xEA, 0xFA, 0x84, 0xFA, 0xFA, 0x02, 0x74, 0xFA, 0x02, 0xFA, 0x12, 0x54, 0xFA, 0x12,
+    0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82, 0xFA, 0xFA, 0x82,
+};
+
+static const uint8_t *const FACE_EYE_L_FRAMES[] PROGMEM = {RLE_EYE_L_OPEN, RLE_EYE_L_HALF, RLE_EYE_L_CLOSED, RLE_EYE_L_LEFT, RLE_EYE_L_RIGHT, RLE_EYE_L_WIDE};
+
+static const uint8_t *const FACE_EYE_R_FRAMES[] PROGMEM = {RLE_EYE_R_OPEN, RLE_EYE_R_HALF, RLE_EYE_R_CLOSED, RLE_EYE_R_LEFT, RLE_EYE_R_RIGHT, RLE_EYE_R_WIDE};
+
+static const uint8_t *const FACE_MOUTH_FRAMES[] PROGMEM = {RLE_MOUTH_SMILE, RLE_MOUTH_TALK, RLE_MOUTH_OH};
+
+// 3024 bytes of frame data
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Face link - commands from the arm controller (robot/, an ESP32) on the
+// hardware serial port. Every message is one 4-byte frame:
+//
+//   0xA5, opcode, arg, opcode ^ arg ^ 0xA5
+//
+// A frame with a bad check byte is dropped and the reader hunts for the next
+// sync byte. Keep the opcodes and expression ids in step with
+// robot/include/face_link.h.
+//
+// D0/D1 are also the USB serial port: unplug the controller's TX while
+// uploading.
+
+const uint32_t FACE_LINK_BAUD = 57600;
+const uint8_t FACE_LINK_SYNC = 0xA5;
+
+// Robot -> face
+const uint8_t FACE_OP_EXPRESSION = 0x01;  // arg: expression, held until the next one
+const uint8_t FACE_OP_REACT = 0x02;       // arg: expression, shown briefly then back
+const uint8_t FACE_OP_BLINK = 0x03;
+const uint8_t FACE_OP_STEP = 0x04;        // arg: sequence step, low byte
+
+// Face -> robot
+const uint8_t FACE_EVT_READY = 0x81;
+const uint8_t FACE_EVT_TAP = 0x82;   // arg: tap zone
+const uint8_t FACE_EVT_HOLD = 0x83;  // long press; arg: tap zone
+
+// Tap zones: where on the screen the press started
+const uint8_t FACE_TAP_CENTER = 0;
+const uint8_t FACE_TAP_LEFT = 1;
+const uint8_t FACE_TAP_RIGHT = 2;
+
+// Wire ids of the expressions
+const uint8_t FACE_EXPR_HAPPY = 0;
+const uint8_t FACE_EXPR_TALK = 1;
+const uint8_t FACE_EXPR_SURPRISE = 2;
+const uint8_t FACE_EXPR_LOOK_LEFT = 3;
+const uint8_t FACE_EXPR_LOOK_RIGHT = 4;
+const uint8_t FACE_EXPR_COUNT = 5;
+
+void faceLinkBegin();
+void faceLinkSend(uint8_t op, uint8_t arg = 0);
+// Never waits: consumes what has arrived and returns true once a whole,
+// valid frame is in
+bool faceLinkRead(uint8_t *op, uint8_t *arg);
+uint16_t faceLinkBadFrames();
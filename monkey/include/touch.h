@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Resistive touch panel. The panel's XM/YP lines are the TFT's A2/A3 (RS and
+// CS), so a sample briefly turns them into analog inputs: touchPoll() must
+// only run between frame pushes, and puts the pins back before returning.
+// Presses are debounced over a few samples and reported once the gesture
+// is known: a short press-and-release is a tap, holding past TOUCH_HOLD_MS
+// is a long press.
+
+enum TouchEvent : uint8_t {
+    TOUCH_NONE,
+    TOUCH_TAP,
+    TOUCH_HOLD
+};
+
+const unsigned long TOUCH_SAMPLE_MS = 20;
+const unsigned long TOUCH_HOLD_MS = 800;
+
+// Screen size after setRotation(); rotation 1 (landscape) is assumed
+void touchBegin(int16_t width, int16_t height);
+
+// Take one sample. Returns the gesture that just completed, if any, with
+// the screen position where the press started
+TouchEvent touchPoll(unsigned long now, int16_t *x, int16_t *y);
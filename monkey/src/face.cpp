@@ -0,0 +1,131 @@
+#include "face.h"
+
+#include "face_frames.h"
+
+static_assert(FACE_EYE_FRAME_COUNT == EYE_FRAME_COUNT, "regenerate include/face_frames.h");
+static_assert(FACE_MOUTH_FRAME_COUNT == MOUTH_FRAME_COUNT, "regenerate include/face_frames.h");
+
+// Unchanged gaps shorter than this are pushed anyway: re-sending a few pixels
+// is cheaper than another setAddrWindow on the 8-bit bus
+const uint8_t SPAN_MERGE_GAP = 4;
+const uint8_t NO_FRAME = 0xFF;
+
+struct FacePart {
+    int16_t x, y;
+    uint8_t w, h;
+    const uint8_t *const *frames;
+    uint8_t shown, wanted;
+};
+
+static MCUFRIEND_kbv *tft = nullptr;
+static FacePart parts[3];
+
+static uint8_t rowOld[FACE_MAX_W];
+static uint8_t rowNew[FACE_MAX_W];
+static uint16_t rowColors[FACE_MAX_W];
+
+static const uint8_t *frameData(const FacePart &part, uint8_t frame) {
+    return (const uint8_t *)pgm_read_word(&part.frames[frame]);
+}
+
+// Expand one row of runs into palette indices; returns the start of the next row
+static const uint8_t *decodeRow(const uint8_t *rle, uint8_t *out, uint8_t w) {
+    uint8_t x = 0;
+    while (x < w) {
+        uint8_t b = pgm_read_byte(rle++);
+        uint8_t run = (b >> 3) + 1;
+        uint8_t color = b & 0x07;
+        if (run > w - x) run = w - x;
+        memset(out + x, color, run);
+        x += run;
+    }
+    return rle;
+}
+
+static void pushSpan(int16_t x, int16_t y, const uint8_t *index, uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+        rowColors[i] = pgm_read_word(&FACE_PALETTE[index[i]]);
+    }
+    tft->setAddrWindow(x, y, x + n - 1, y);
+    tft->pushColors(rowColors, n, true);
+}
+
+static uint16_t blitPart(FacePart &part) {
+    const uint8_t *next = frameData(part, part.wanted);
+    const uint8_t *prev = part.shown == NO_FRAME ? nullptr : frameData(part, part.shown);
+    uint16_t pushed = 0;
+
+    for (uint8_t row = 0; row < part.h; row++) {
+        next = decodeRow(next, rowNew, part.w);
+        if (prev) prev = decodeRow(prev, rowOld, part.w);
+
+        uint8_t x = 0;
+        while (x < part.w) {
+            if (prev && rowNew[x] == rowOld[x]) {
+                x++;
+                continue;
+            }
+            // Grow the span until SPAN_MERGE_GAP identical pixels in a row
+            uint8_t start = x, end = x, gap = 0;
+            for (x++; x < part.w && gap < SPAN_MERGE_GAP; x++) {
+                if (!prev || rowNew[x] != rowOld[x]) {
+                    end = x;
+                    gap = 0;
+                } else {
+                    gap++;
+                }
+            }
+            x = end + 1;
+            pushSpan(part.x + start, part.y + row, rowNew + start, end - start + 1);
+            pushed += end - start + 1;
+        }
+    }
+    part.shown = part.wanted;
+    return pushed;
+}
+
+static void initPart(FacePart &part, int16_t x, int16_t y, uint8_t w, uint8_t h,
+                     const uint8_t *const *frames, uint8_t frame) {
+    part.x = x;
+    part.y = y;
+    part.w = w;
+    part.h = h;
+    part.frames = frames;
+    part.shown = NO_FRAME;
+    part.wanted = frame;
+}
+
+void faceBegin(MCUFRIEND_kbv &display, int cx, int cy, FaceEyes eyes, FaceMouth mouth) {
+    tft = &display;
+    initPart(parts[0], cx + FACE_EYE_L_X, cy + FACE_EYE_L_Y, FACE_EYE_L_W, FACE_EYE_L_H, FACE_EYE_L_FRAMES, eyes);
+    initPart(parts[1], cx + FACE_EYE_R_X, cy + FACE_EYE_R_Y, FACE_EYE_R_W, FACE_EYE_R_H, FACE_EYE_R_FRAMES, eyes);
+    initPart(parts[2], cx + FACE_MOUTH_X, cy + FACE_MOUTH_Y, FACE_MOUTH_W, FACE_MOUTH_H, FACE_MOUTH_FRAMES,
+             mouth);
+    faceRender();
+}
+
+void faceSetEyes(FaceEyes eyes) {
+    parts[0].wanted = eyes;
+    parts[1].wanted = eyes;
+}
+
+void faceSetMouth(FaceMouth mouth) {
+    parts[2].wanted = mouth;
+}
+
+FaceEyes faceEyes() {
+    return (FaceEyes)parts[0].wanted;
+}
+
+FaceMouth faceMouth() {
+    return (FaceMouth)parts[2].wanted;
+}
+
+uint16_t faceRender() {
+    if (!tft) return 0;
+    uint16_t pushed = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        if (parts[i].wanted != parts[i].shown) pushed += blitPart(parts[i]);
+    }
+    return pushed;
+}
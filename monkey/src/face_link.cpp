@@ -0,0 +1,42 @@
+#include "face_link.h"
+
+static uint8_t rxFrame[3];
+static uint8_t rxLen = 0;
+static bool rxSynced = false;
+static uint16_t badFrames = 0;
+
+void faceLinkBegin() {
+    Serial.begin(FACE_LINK_BAUD);
+    faceLinkSend(FACE_EVT_READY);
+}
+
+void faceLinkSend(uint8_t op, uint8_t arg) {
+    uint8_t frame[4] = {FACE_LINK_SYNC, op, arg, (uint8_t)(op ^ arg ^ FACE_LINK_SYNC)};
+    Serial.write(frame, sizeof(frame));
+}
+
+bool faceLinkRead(uint8_t *op, uint8_t *arg) {
+    while (Serial.available() > 0) {
+        uint8_t b = (uint8_t)Serial.read();
+        if (!rxSynced) {
+            rxSynced = b == FACE_LINK_SYNC;
+            rxLen = 0;
+            continue;
+        }
+        rxFrame[rxLen++] = b;
+        if (rxLen < sizeof(rxFrame)) continue;
+        rxSynced = false;
+        if ((rxFrame[0] ^ rxFrame[1] ^ FACE_LINK_SYNC) != rxFrame[2]) {
+            badFrames++;
+            continue;
+        }
+        *op = rxFrame[0];
+        *arg = rxFrame[1];
+        return true;
+    }
+    return false;
+}
+
+uint16_t faceLinkBadFrames() {
+    return badFrames;
+}
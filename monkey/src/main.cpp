@@ -1,22 +1,48 @@
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
 #include <MCUFRIEND_kbv.h>
-#include <TouchScreen.h>
 
-// Touchscreen pins (not used right now)
-const int XP = 8, XM = A2, YP = A3, YM = 9; 
-const int TS_LEFT = 127, TS_RT = 904, TS_TOP = 945, TS_BOT = 92;
+#include "face.h"
+#include "face_link.h"
+#include "touch.h"
 
 MCUFRIEND_kbv tft; 
-TouchScreen ts = TouchScreen(XP, YP, XM, YM, 300);
 
 int16_t TFT_WIDTH, TFT_HEIGHT;
 
 uint16_t monkeyBrown, monkeyTan, black, white, darkBrown;
 
 // Animation variables
+const unsigned long FRAME_MS = 40;
+const unsigned long BLINK_INTERVAL_MS = 2000;
+const unsigned long TALK_FRAME_MS = 120;
+const unsigned long REACT_MS = 1200;        // how long a FACE_OP_REACT expression shows
+const unsigned long STEP_DRIVEN_MS = 1000;  // talk follows FACE_OP_STEP while steps are this recent
+
+// Values are the wire ids from face_link.h
+enum Expression {
+    EXPR_HAPPY = FACE_EXPR_HAPPY,
+    EXPR_TALK = FACE_EXPR_TALK,
+    EXPR_SURPRISE = FACE_EXPR_SURPRISE,
+    EXPR_LOOK_LEFT = FACE_EXPR_LOOK_LEFT,
+    EXPR_LOOK_RIGHT = FACE_EXPR_LOOK_RIGHT
+};
+
+// Eye frames of one blink, one per animation frame
+const FaceEyes BLINK_FRAMES[] = {EYES_HALF, EYES_CLOSED, EYES_CLOSED, EYES_CLOSED, EYES_HALF};
+const uint8_t BLINK_FRAME_COUNT = sizeof(BLINK_FRAMES) / sizeof(BLINK_FRAMES[0]);
+
+Expression expression = EXPR_HAPPY;  // held until the next FACE_OP_EXPRESSION
+Expression showing = EXPR_HAPPY;     // the held one, or a reaction over it
+bool reacting = false;
+unsigned long reactUntil = 0;
 unsigned long lastBlink = 0;
-bool eyesOpen = true;
+uint8_t blinkFrame = 0;  // 0 = not blinking, else 1-based index into BLINK_FRAMES
+unsigned long lastTalkFrame = 0;
+unsigned long lastStepAt = 0;
+bool stepsSeen = false;
+unsigned long nextFrameAt = 0;
+unsigned long nextTouchAt = 0;
 
 // ----------------- FACE DRAWING -----------------
 
@@ -34,30 +60,6 @@ void drawMonkeyBase(int cx, int cy) {
     tft.fillCircle(cx, cy + 20, 70, monkeyTan);
 }
 
-void drawEyes(bool open) {
-    int cx = TFT_WIDTH / 2;
-    int cy = TFT_HEIGHT / 2;
-
-    if (open) {
-        // Open eyes - draw over the eye area only
-        tft.fillCircle(cx - 35, cy - 20, 22, white);
-        tft.fillCircle(cx + 35, cy - 20, 22, white);
-        tft.fillCircle(cx - 35, cy - 20, 12, black);
-        tft.fillCircle(cx + 35, cy - 20, 12, black);
-        // highlights
-        tft.fillCircle(cx - 31, cy - 24, 4, white);
-        tft.fillCircle(cx + 39, cy - 24, 4, white);
-    } else {
-        // Closed eyes - just cover the eye area with closed eyes
-        // First cover the old eyes with face color
-        tft.fillCircle(cx - 35, cy - 20, 25, monkeyTan);
-        tft.fillCircle(cx + 35, cy - 20, 25, monkeyTan);
-        // Then draw closed eye lines
-        tft.fillRect(cx - 45, cy - 22, 20, 4, darkBrown);
-        tft.fillRect(cx + 25, cy - 22, 20, 4, darkBrown);
-    }
-}
-
 void drawHappyFace() {
     int cx = TFT_WIDTH / 2;
     int cy = TFT_HEIGHT / 2;
@@ -65,18 +67,108 @@ void drawHappyFace() {
     tft.fillScreen(white);
     drawMonkeyBase(cx, cy);
 
-    // Draw initial open eyes
-    drawEyes(true);
-
     // Nose (small oval in muzzle)
     tft.fillCircle(cx - 6, cy + 10, 4, black);
     tft.fillCircle(cx + 6, cy + 10, 4, black);
 
-    // Static smile for now
-    for (int i = 0; i < 180; i++) {
-        int x = cx + cos(radians(i)) * 35;
-        int y = cy + sin(radians(i)) * 20 + 35;
-        tft.fillCircle(x, y, 2, darkBrown);
+    // Eyes and mouth are sprites from here on
+    faceBegin(tft, cx, cy, EYES_OPEN, MOUTH_SMILE);
+}
+
+FaceEyes expressionEyes(Expression e) {
+    switch (e) {
+        case EXPR_SURPRISE:   return EYES_WIDE;
+        case EXPR_LOOK_LEFT:  return EYES_LEFT;
+        case EXPR_LOOK_RIGHT: return EYES_RIGHT;
+        default:              return EYES_OPEN;
+    }
+}
+
+FaceMouth expressionMouth(Expression e) {
+    switch (e) {
+        case EXPR_TALK:     return MOUTH_TALK;
+        case EXPR_SURPRISE: return MOUTH_OH;
+        default:            return MOUTH_SMILE;
+    }
+}
+
+void showExpression(Expression e, unsigned long now) {
+    showing = e;
+    if (!blinkFrame) faceSetEyes(expressionEyes(e));
+    faceSetMouth(expressionMouth(e));
+    lastTalkFrame = now;
+}
+
+void startBlink() {
+    if (blinkFrame) return;
+    faceSetEyes(BLINK_FRAMES[0]);
+    blinkFrame = 1;
+}
+
+// Advance blink, talk and reaction timers by one frame; faceRender() pushes the result
+void animateFace(unsigned long now) {
+    if (reacting && (long)(now - reactUntil) >= 0) {
+        reacting = false;
+        showExpression(expression, now);
+    }
+
+    if (blinkFrame) {
+        if (blinkFrame < BLINK_FRAME_COUNT) {
+            faceSetEyes(BLINK_FRAMES[blinkFrame++]);
+        } else {
+            blinkFrame = 0;
+            lastBlink = now;
+            faceSetEyes(expressionEyes(showing));
+        }
+    } else if (now - lastBlink > BLINK_INTERVAL_MS) {
+        startBlink();
+    }
+
+    if (showing == EXPR_TALK && now - lastTalkFrame >= TALK_FRAME_MS) {
+        if (stepsSeen && now - lastStepAt < STEP_DRIVEN_MS) {
+            // Steps open the mouth; it only closes here, so it flaps in time with the arms
+            faceSetMouth(MOUTH_SMILE);
+        } else {
+            lastTalkFrame = now;
+            faceSetMouth(faceMouth() == MOUTH_TALK ? MOUTH_SMILE : MOUTH_TALK);
+        }
+    }
+}
+
+// ----------------- CONTROLLER LINK -----------------
+
+void handleCommand(uint8_t op, uint8_t arg, unsigned long now) {
+    switch (op) {
+        case FACE_OP_EXPRESSION:
+            if (arg >= FACE_EXPR_COUNT) return;
+            expression = (Expression)arg;
+            if (!reacting) showExpression(expression, now);
+            break;
+        case FACE_OP_REACT:
+            if (arg >= FACE_EXPR_COUNT) return;
+            reacting = true;
+            reactUntil = now + REACT_MS;
+            showExpression((Expression)arg, now);
+            break;
+        case FACE_OP_BLINK:
+            startBlink();
+            break;
+        case FACE_OP_STEP:
+            stepsSeen = true;
+            lastStepAt = now;
+            if (showing == EXPR_TALK) {
+                faceSetMouth(MOUTH_TALK);
+                lastTalkFrame = now;
+            }
+            break;
+    }
+}
+
+// Drain whatever frames have arrived; their effect is drawn on the next frame
+void serviceLink(unsigned long now) {
+    uint8_t op, arg;
+    while (faceLinkRead(&op, &arg)) {
+        handleCommand(op, arg, now);
     }
 }
 
@@ -96,28 +188,57 @@ void setup() {
     white       = tft.color565(255, 255, 255);
     darkBrown   = tft.color565(60, 40, 10);
 
+    drawHappyFace();  // show happy monkey
+
     // Initialize animation timers
     lastBlink = millis();
-    
-    drawHappyFace();  // show happy monkey
+    nextFrameAt = lastBlink;
+    nextTouchAt = lastBlink + FRAME_MS / 2;
+    touchBegin(TFT_WIDTH, TFT_HEIGHT);
+
+    faceLinkBegin();  // tells the controller we're up
+}
+
+// ----------------- TOUCH -----------------
+
+// Taps go to the controller (it replays the last skill, a long press stops
+// playback) and get an immediate reaction here: a glance towards the side
+// that was touched
+void handleTouch(TouchEvent event, int16_t x, unsigned long now) {
+    int16_t cx = TFT_WIDTH / 2;
+    uint8_t zone = x < cx - 60 ? FACE_TAP_LEFT : x > cx + 60 ? FACE_TAP_RIGHT : FACE_TAP_CENTER;
+    if (event == TOUCH_TAP) {
+        faceLinkSend(FACE_EVT_TAP, zone);
+        uint8_t look = zone == FACE_TAP_LEFT ? FACE_EXPR_LOOK_LEFT
+                     : zone == FACE_TAP_RIGHT ? FACE_EXPR_LOOK_RIGHT : FACE_EXPR_HAPPY;
+        handleCommand(FACE_OP_REACT, look, now);
+    } else if (event == TOUCH_HOLD) {
+        faceLinkSend(FACE_EVT_HOLD, zone);
+        handleCommand(FACE_OP_REACT, FACE_EXPR_SURPRISE, now);
+    }
 }
 
+// Event loop - nothing blocks: the link is drained on every pass and a
+// frame is animated and pushed whenever its FRAME_MS slot comes up, so a
+// command is on screen by the next frame at the latest
 void loop() {
     unsigned long now = millis();
+    serviceLink(now);
 
-    // Simple blinking animation - blink every 2 seconds
-    if (now - lastBlink > 2000) {
-        if (eyesOpen) {
-            eyesOpen = false;
-            lastBlink = now;
-            drawEyes(false); // Just update eyes, not whole face
-        } else if (now - lastBlink > 200) { // Eyes closed for 200ms
-            eyesOpen = true;
-            lastBlink = now;
-            drawEyes(true); // Just update eyes, not whole face
-        }
+    if ((long)(now - nextFrameAt) >= 0) {
+        // After a long frame, restart the cadence instead of bursting to catch up
+        nextFrameAt = (long)(now - nextFrameAt) >= (long)FRAME_MS ? now + FRAME_MS : nextFrameAt + FRAME_MS;
+        animateFace(now);
+        faceRender();  // only the pixels that changed this frame
     }
 
-    // Small delay
-    delay(50);
+    // Touch samples get their own slots, offset from the frame cadence and
+    // always after this pass's push, so they never split a frame
+    if ((long)(now - nextTouchAt) >= 0) {
+        nextTouchAt = (long)(now - nextTouchAt) >= (long)TOUCH_SAMPLE_MS ? now + TOUCH_SAMPLE_MS
+                                                                         : nextTouchAt + TOUCH_SAMPLE_MS;
+        int16_t x, y;
+        TouchEvent event = touchPoll(now, &x, &y);
+        if (event != TOUCH_NONE) handleTouch(event, x, now);
+    }
 }
@@ -0,0 +1,63 @@
+#include "touch.h"
+
+#include <TouchScreen.h>
+
+// Touchscreen pins and raw calibration for this shield
+const int XP = 8, XM = A2, YP = A3, YM = 9;
+const int TS_LEFT = 127, TS_RT = 904, TS_TOP = 945, TS_BOT = 92;
+const int16_t MIN_PRESSURE = 200, MAX_PRESSURE = 1000;
+
+const uint8_t PRESS_SAMPLES = 2;    // consecutive pressed samples before a touch counts
+const uint8_t RELEASE_SAMPLES = 3;  // consecutive released samples before it ends
+const unsigned long TAP_MAX_MS = 500;
+
+static TouchScreen ts = TouchScreen(XP, YP, XM, YM, 300);
+static int16_t screenW, screenH;
+
+static bool down = false;
+static bool holdSent = false;
+static uint8_t streak = 0;  // samples disagreeing with `down`
+static unsigned long downAt = 0;
+static int16_t downX, downY;
+
+void touchBegin(int16_t width, int16_t height) {
+    screenW = width;
+    screenH = height;
+}
+
+TouchEvent touchPoll(unsigned long now, int16_t *x, int16_t *y) {
+    TSPoint p = ts.getPoint();
+    // Hand A2/A3 back to the TFT: RS and CS, both idle high
+    pinMode(XM, OUTPUT);
+    pinMode(YP, OUTPUT);
+    digitalWrite(XM, HIGH);
+    digitalWrite(YP, HIGH);
+
+    bool pressed = p.z > MIN_PRESSURE && p.z < MAX_PRESSURE;
+    streak = pressed != down ? streak + 1 : 0;
+
+    if (!down) {
+        if (streak < PRESS_SAMPLES) return TOUCH_NONE;
+        down = true;
+        holdSent = false;
+        streak = 0;
+        downAt = now;
+        // Landscape: the panel's y axis runs along the screen's width
+        downX = constrain(map(p.y, TS_TOP, TS_BOT, 0, screenW), 0, screenW - 1);
+        downY = constrain(map(p.x, TS_RT, TS_LEFT, 0, screenH), 0, screenH - 1);
+        return TOUCH_NONE;
+    }
+
+    *x = downX;
+    *y = downY;
+    if (streak >= RELEASE_SAMPLES) {
+        down = false;
+        streak = 0;
+        return !holdSent && now - downAt <= TAP_MAX_MS ? TOUCH_TAP : TOUCH_NONE;
+    }
+    if (!holdSent && now - downAt >= TOUCH_HOLD_MS) {
+        holdSent = true;
+        return TOUCH_HOLD;
+    }
+    return TOUCH_NONE;
+}
@@ -0,0 +1,258 @@
+#!/usr/bin/env python3
+"""Generate include/face_frames.h - the monkey face's sprite frames.
+
+Every animated part of the face (each eye, the mouth) lives in a fixed box
+relative to the screen centre. For each frame of each part this script
+rasterises the whole face as drawMonkeyBase() draws it plus that frame's
+feature shapes, crops the part's box and run-length encodes it, so the Uno
+only ever copies runs out of flash. Circles use the same midpoint routine as
+Adafruit GFX fillCircle(), so box edges line up pixel for pixel with the base
+face the firmware draws at boot.
+
+RLE format: one byte per run, ((length - 1) << 3) | palette index, runs of
+1-32 pixels that never cross a row boundary.
+
+Run from monkey/:  python3 tools/gen_face_frames.py > include/face_frames.h
+"""
+import math
+import sys
+
+
+def color565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+# Same colours as setup() in src/main.cpp
+PALETTE = [
+    ("white", color565(255, 255, 255)),
+    ("monkeyBrown", color565(120, 70, 20)),
+    ("monkeyTan", color565(230, 200, 140)),
+    ("black", color565(0, 0, 0)),
+    ("darkBrown", color565(60, 40, 10)),
+    ("tongue", color565(220, 90, 90)),
+]
+WHITE, BROWN, TAN, BLACK, DARK, TONGUE = range(len(PALETTE))
+
+# Box geometry relative to the face centre: (left, top, width, height)
+EYE_R = 26
+LEFT_EYE = (-35, -20)
+RIGHT_EYE = (35, -20)
+MOUTH_BOX = (-40, 30, 81, 31)
+MAX_RUN = 32
+
+
+class Canvas:
+    """Palette-index raster of one box, in face-centre coordinates."""
+
+    def __init__(self, box):
+        self.x0, self.y0, self.w, self.h = box
+        self.px = [[WHITE] * self.w for _ in range(self.h)]
+
+    def pixel(self, x, y, c, clip=None):
+        if clip and not clip(x, y):
+            return
+        if self.x0 <= x < self.x0 + self.w and self.y0 <= y < self.y0 + self.h:
+            self.px[y - self.y0][x - self.x0] = c
+
+    def vline(self, x, y, h, c, clip=None):
+        for yy in range(y, y + h):
+            self.pixel(x, yy, c, clip)
+
+    def rect(self, x, y, w, h, c, clip=None):
+        for xx in range(x, x + w):
+            self.vline(xx, y, h, c, clip)
+
+    def circle(self, x0, y0, r, c, clip=None):
+        # Adafruit_GFX::fillCircle + fillCircleHelper(corners = 3, delta = 0)
+        self.vline(x0, y0 - r, 2 * r + 1, c, clip)
+        f, ddx, ddy, x, y = 1 - r, 1, -2 * r, 0, r
+        px, py = x, y
+        delta = 1
+        while x < y:
+            if f >= 0:
+                y -= 1
+                ddy += 2
+                f += ddy
+            x += 1
+            ddx += 2
+            f += ddx
+            if x < y + 1:
+                self.vline(x0 + x, y0 - y, 2 * y + delta, c, clip)
+                self.vline(x0 - x, y0 - y, 2 * y + delta, c, clip)
+            if y != py:
+                self.vline(x0 + py, y0 - px, 2 * px + delta, c, clip)
+                self.vline(x0 - py, y0 - px, 2 * px + delta, c, clip)
+                py = y
+            px = x
+
+    def ellipse(self, cx, cy, rx, ry, c, clip=None):
+        for y in range(cy - ry, cy + ry + 1):
+            for x in range(cx - rx, cx + rx + 1):
+                if ((x - cx) / rx) ** 2 + ((y - cy) / ry) ** 2 < 1.0:
+                    self.pixel(x, y, c, clip)
+
+
+def draw_base(cv):
+    # drawMonkeyBase() and the nose from drawHappyFace()
+    cv.circle(0, 0, 100, BROWN)
+    cv.circle(-95, 0, 40, BROWN)
+    cv.circle(95, 0, 40, BROWN)
+    cv.circle(-95, 0, 25, TAN)
+    cv.circle(95, 0, 25, TAN)
+    cv.circle(0, 20, 70, TAN)
+    cv.circle(-6, 10, 4, BLACK)
+    cv.circle(6, 10, 4, BLACK)
+
+
+def eye_open(cv, ex, ey, look=0):
+    cv.circle(ex, ey, 22, WHITE)
+    cv.circle(ex + look, ey, 12, BLACK)
+    cv.circle(ex + look + 4, ey - 4, 4, WHITE)
+
+
+def eye_half(cv, ex, ey):
+    below = lambda x, y: y >= ey - 6
+    cv.circle(ex, ey, 25, TAN)
+    cv.circle(ex, ey, 22, WHITE, below)
+    cv.circle(ex, ey, 12, BLACK, below)
+    cv.circle(ex, ey, 22, DARK, lambda x, y: ey - 9 <= y < ey - 6)
+
+
+def eye_closed(cv, ex, ey):
+    cv.circle(ex, ey, 25, TAN)
+    cv.rect(ex - 10, ey - 2, 20, 4, DARK)
+
+
+def eye_wide(cv, ex, ey):
+    cv.circle(ex, ey, 25, TAN)
+    cv.circle(ex, ey, 24, WHITE)
+    cv.circle(ex, ey, 8, BLACK)
+    cv.circle(ex + 3, ey - 3, 3, WHITE)
+
+
+# Order must match FaceEyes in include/face.h
+EYE_FRAMES = [
+    ("OPEN", eye_open),
+    ("HALF", eye_half),
+    ("CLOSED", eye_closed),
+    ("LEFT", lambda cv, ex, ey: eye_open(cv, ex, ey, -8)),
+    ("RIGHT", lambda cv, ex, ey: eye_open(cv, ex, ey, 8)),
+    ("WIDE", eye_wide),
+]
+
+
+def smile(cv):
+    # The original 180-dot smile; x/y truncate exactly as the int math did
+    for i in range(180):
+        x = math.floor(math.cos(math.radians(i)) * 35)
+        y = math.floor(math.sin(math.radians(i)) * 20 + 35)
+        cv.circle(x, y, 2, DARK)
+
+
+def mouth_talk(cv):
+    cv.ellipse(0, 35, 35, 21, DARK, lambda x, y: y >= 35)
+    cv.ellipse(0, 50, 14, 5, TONGUE, lambda x, y: ((x / 33.0) ** 2 + ((y - 35) / 19.0) ** 2) <= 1.0)
+    cv.rect(-37, 33, 75, 3, DARK)
+
+
+def mouth_oh(cv):
+    cv.ellipse(0, 45, 13, 11, DARK)
+    cv.ellipse(0, 45, 8, 7, BLACK)
+
+
+# Order must match FaceMouth in include/face.h
+MOUTH_FRAMES = [
+    ("SMILE", smile),
+    ("TALK", mouth_talk),
+    ("OH", mouth_oh),
+]
+
+
+def rle(cv):
+    out = []
+    for row in cv.px:
+        x = 0
+        while x < len(row):
+            c, run = row[x], 1
+            while x + run < len(row) and row[x + run] == c and run < MAX_RUN:
+                run += 1
+            out.append(((run - 1) << 3) | c)
+            x += run
+    return out
+
+
+def eye_box(center):
+    ex, ey = center
+    return (ex - EYE_R, ey - EYE_R, 2 * EYE_R + 1, 2 * EYE_R + 1)
+
+
+def render(box, draw):
+    cv = Canvas(box)
+    draw_base(cv)
+    draw(cv)
+    return rle(cv)
+
+
+def emit_bytes(name, data, out):
+    out.append("static const uint8_t %s[] PROGMEM = {" % name)
+    for i in range(0, len(data), 16):
+        out.append("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+    out.append("};")
+
+
+def main():
+    out = [
+        "// Generated by tools/gen_face_frames.py - edit the script, not this file.",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#define FACE_EYE_FRAME_COUNT %d" % len(EYE_FRAMES),
+        "#define FACE_MOUTH_FRAME_COUNT %d" % len(MOUTH_FRAMES),
+        "#define FACE_MAX_W %d" % max(2 * EYE_R + 1, MOUTH_BOX[2]),
+        "",
+        "// Box origins and sizes relative to the face centre",
+    ]
+    for name, (x, y, w, h) in (("EYE_L", eye_box(LEFT_EYE)), ("EYE_R", eye_box(RIGHT_EYE)), ("MOUTH", MOUTH_BOX)):
+        out.append("#define FACE_%s_X %d" % (name, x))
+        out.append("#define FACE_%s_Y %d" % (name, y))
+        out.append("#define FACE_%s_W %d" % (name, w))
+        out.append("#define FACE_%s_H %d" % (name, h))
+    out.append("")
+    out.append("static const uint16_t FACE_PALETTE[] PROGMEM = {")
+    for name, value in PALETTE:
+        out.append("    0x%04X,  // %s" % (value, name))
+    out.append("};")
+
+    total = 0
+    tables = []
+    for side, center in (("EYE_L", LEFT_EYE), ("EYE_R", RIGHT_EYE)):
+        names = []
+        for frame, draw in EYE_FRAMES:
+            data = render(eye_box(center), lambda cv: draw(cv, center[0], center[1]))
+            name = "RLE_%s_%s" % (side, frame)
+            out.append("")
+            emit_bytes(name, data, out)
+            names.append(name)
+            total += len(data)
+        tables.append(("FACE_%s_FRAMES" % side, names))
+    names = []
+    for frame, draw in MOUTH_FRAMES:
+        data = render(MOUTH_BOX, draw)
+        name = "RLE_MOUTH_%s" % frame
+        out.append("")
+        emit_bytes(name, data, out)
+        names.append(name)
+        total += len(data)
+    tables.append(("FACE_MOUTH_FRAMES", names))
+
+    for table, names in tables:
+        out.append("")
+        out.append("static const uint8_t *const %s[] PROGMEM = {%s};" % (table, ", ".join(names)))
+    out.append("")
+    out.append("// %d bytes of frame data" % total)
+    sys.stdout.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()
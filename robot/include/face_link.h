@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+
+// Face link - UART to the monkey display (monkey/, an Arduino Uno) so the
+// face reacts to what the arms do. Every message is one 4-byte frame:
+//
+//   0xA5, opcode, arg, opcode ^ arg ^ 0xA5
+//
+// Frames are small enough that writes never wait on the TX FIFO, and a
+// receiver that joins mid-stream or sees a corrupt frame just hunts for the
+// next sync byte. Keep the opcodes and expression ids in step with
+// monkey/include/face_link.h.
+//
+// Wiring: Serial2 TX (GPIO32) -> Uno RX (D0) directly; Uno TX (D1) -> GPIO33
+// through a 5 V -> 3.3 V divider. GPIO16/17, Serial2's usual pins, carry the
+// PSRAM on the WROVER.
+
+static const uint32_t FACE_LINK_BAUD = 57600; // 0.8% error on the Uno's 16 MHz clock
+static const int FACE_LINK_TX_PIN = 32;
+static const int FACE_LINK_RX_PIN = 33;
+static const uint8_t FACE_LINK_SYNC = 0xA5;
+
+// Robot -> face
+static const uint8_t FACE_OP_EXPRESSION = 0x01; // arg: expression, held until the next one
+static const uint8_t FACE_OP_REACT = 0x02;      // arg: expression, shown briefly then back
+static const uint8_t FACE_OP_BLINK = 0x03;
+static const uint8_t FACE_OP_STEP = 0x04;       // arg: sequence step, low byte; paces the talk mouth
+
+// Face -> robot
+static const uint8_t FACE_EVT_READY = 0x81;     // sent at boot; the robot replies with the current expression
+static const uint8_t FACE_EVT_TAP = 0x82;       // arg: FaceTapZone
+static const uint8_t FACE_EVT_HOLD = 0x83;      // long press; arg: FaceTapZone
+
+enum FaceTapZone : uint8_t { FACE_TAP_CENTER = 0, FACE_TAP_LEFT = 1, FACE_TAP_RIGHT = 2 };
+
+enum FaceExpression : uint8_t {
+  FACE_EXPR_HAPPY = 0,
+  FACE_EXPR_TALK = 1,
+  FACE_EXPR_SURPRISE = 2,
+  FACE_EXPR_LOOK_LEFT = 3,
+  FACE_EXPR_LOOK_RIGHT = 4,
+  FACE_EXPR_COUNT
+};
+
+struct FaceLinkStats {
+  uint32_t framesSent;
+  uint32_t framesReceived;
+  uint32_t badFrames;
+  bool faceSeen; // a READY arrived since boot
+};
+
+// Face events other than READY (taps, long presses), on the network task
+typedef void (*FaceEventHandler)(uint8_t event, uint8_t arg);
+
+void faceLinkBegin();
+void faceLinkSetEventHandler(FaceEventHandler handler);
+void faceLinkSend(uint8_t op, uint8_t arg = 0);
+// Remembered so a face that reboots gets it back on READY
+void faceLinkSetExpression(FaceExpression expression);
+// Network task: drain frames from the face and turn sequence playback into
+// expressions (talk while playing, one STEP per keyframe, happy when done,
+// surprise on abort)
+void faceLinkPoll();
+
+bool parseFaceExpression(const char *name, FaceExpression *out);
+const char *faceExpressionName(FaceExpression expression);
+FaceLinkStats faceLinkStats();
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "joints.h"
+
+// Servo feedback - optional ADC sensing of where the joints really are and
+// how hard they are working, behind ROBOT_FEEDBACK (off by default; the stock
+// arms have no sense wiring). currentAngles[] only records what was written;
+// this measures it.
+//
+// The ADC runs in continuous (DMA) mode across FEEDBACK_CHANNELS, so
+// conversions cost no CPU. Once per control tick the motion task drains the
+// DMA buffer, averages each channel's ~100 samples and compares the result
+// with the planner:
+//   - stall: a joint's measured position trails the commanded one by more
+//     than FEEDBACK_STALL_ERROR_CDEG for FEEDBACK_STALL_MS
+//   - overcurrent: a supply channel stays above FEEDBACK_STALL_MA for
+//     FEEDBACK_STALL_MS (every joint on that supply is flagged)
+// Both are reported, never acted on; the host decides what to do.
+//
+// Each tick's result is one FeedbackSnapshot. The network task sends it as a
+// telemetry datagram to hosts subscribed on the UDP stream port (see
+// processStream() in main.cpp) and keeps the newest for GET /feedback.
+
+#ifndef ROBOT_FEEDBACK
+#define ROBOT_FEEDBACK 0
+#endif
+
+enum FeedbackKind : uint8_t {
+  FEEDBACK_POSITION, // servo pot wiper; scale is centidegrees per count
+  FEEDBACK_CURRENT   // supply shunt amplifier; scale is mA per count
+};
+
+struct FeedbackChannel {
+  uint8_t gpio;      // ADC1 input; ADC2 is unusable while WiFi is up
+  FeedbackKind kind;
+  JointMask joints;  // the one joint a wiper belongs to, or every joint on a supply
+  int16_t zero;      // raw counts at 0 degrees / 0 mA
+  float scale;       // value = (raw - zero) * scale
+};
+
+// ADC1 inputs free on the WROVER: 37/38 are not brought out and 32/33 carry
+// the face link, which leaves 34, 35, 36 (VP) and 39 (VN). Calibrate zero and
+// scale per board; the values below are nominal.
+static constexpr FeedbackChannel FEEDBACK_CHANNELS[] = {
+  // Pot wipers of the two load-bearing shoulders, brought out of the case
+  // through a 10k series resistor; 0-180 degrees spans about 0.25-3.0 V
+  {34, FEEDBACK_POSITION, 1 << 0, 310, 4.945f},  // left_shoulder_vertical
+  {35, FEEDBACK_POSITION, 1 << 3, 310, 4.945f},  // right_shoulder_vertical
+  // Each arm's servo supply through a 50 mOhm high-side shunt and a 20 V/V
+  // amplifier (1 mV per mA), 0-3.1 A full scale at 11 dB attenuation
+  {36, FEEDBACK_CURRENT, 0x07, 0, 0.757f},       // left arm
+  {39, FEEDBACK_CURRENT, 0x38, 0, 0.757f},       // right arm
+};
+
+static constexpr int FEEDBACK_CHANNEL_COUNT = sizeof(FEEDBACK_CHANNELS) / sizeof(FEEDBACK_CHANNELS[0]);
+
+static const uint32_t FEEDBACK_SAMPLE_HZ = 20000; // total across channels; the ESP32 DMA minimum
+static const int FEEDBACK_STALL_ERROR_CDEG = 10 * 100;
+static const unsigned long FEEDBACK_STALL_MS = 250;
+static const int FEEDBACK_STALL_MA = 2000;
+static const uint16_t FEEDBACK_NONE = 0xFFFF;     // joint not sensed
+
+// ADC1 channel of a GPIO, or -1
+constexpr int feedbackAdcChannel(int gpio) {
+  return gpio == 36 ? 0 : gpio == 37 ? 1 : gpio == 38 ? 2 : gpio == 39 ? 3 :
+         gpio >= 32 && gpio <= 35 ? gpio - 28 : -1;
+}
+
+constexpr bool feedbackGpioUnusedAfter(int i, int j) {
+  return j >= FEEDBACK_CHANNEL_COUNT ||
+         (FEEDBACK_CHANNELS[i].gpio != FEEDBACK_CHANNELS[j].gpio && feedbackGpioUnusedAfter(i, j + 1));
+}
+
+constexpr bool feedbackGpioNotServo(int gpio, int j = 0) {
+  return j >= SERVO_COUNT || (JOINTS[j].pin != gpio && feedbackGpioNotServo(gpio, j + 1));
+}
+
+constexpr bool feedbackChannelsValid(int i = 0) {
+  return i >= FEEDBACK_CHANNEL_COUNT ||
+         (feedbackAdcChannel(FEEDBACK_CHANNELS[i].gpio) >= 0 && feedbackGpioUnusedAfter(i, i + 1) &&
+          feedbackGpioNotServo(FEEDBACK_CHANNELS[i].gpio) && FEEDBACK_CHANNELS[i].joints != 0 &&
+          (FEEDBACK_CHANNELS[i].joints >> SERVO_COUNT) == 0 &&
+          // a wiper measures exactly one joint
+          (FEEDBACK_CHANNELS[i].kind != FEEDBACK_POSITION ||
+           (FEEDBACK_CHANNELS[i].joints & (FEEDBACK_CHANNELS[i].joints - 1)) == 0) &&
+          feedbackChannelsValid(i + 1));
+}
+
+static_assert(FEEDBACK_CHANNEL_COUNT > 0 && FEEDBACK_CHANNEL_COUNT <= 8, "ADC1 has eight channels");
+static_assert(feedbackChannelsValid(), "feedback channel on a non-ADC1, shared or servo pin, or bad joint mask");
+
+struct FeedbackSnapshot {
+  uint32_t tick;                    // control ticks since feedbackBegin()
+  uint32_t atMs;                    // device millis() when sampled
+  uint16_t commanded[SERVO_COUNT];  // centidegrees the planner is driving
+  uint16_t measured[SERVO_COUNT];   // centidegrees read back, or FEEDBACK_NONE
+  uint16_t currentMa[SERVO_COUNT];  // supply current of the joint's arm, or FEEDBACK_NONE
+  JointMask sensed;                 // joints with position feedback
+  JointMask stalled;
+  JointMask overcurrent;
+};
+
+struct FeedbackStats {
+  bool running;           // the ADC started
+  uint32_t ticks;
+  uint32_t samples;       // conversions averaged, all channels
+  uint32_t overruns;      // times the DMA buffer filled before it was drained
+  uint32_t stalls;        // stall onsets, all joints
+  uint32_t overcurrents;  // overcurrent onsets, all supplies
+  uint32_t snapshotDrops; // network task fell behind the tick
+};
+
+// Setup: configure and start the continuous ADC; false if the driver refused
+bool feedbackBegin();
+// Motion task, after motionTick(): drain samples, detect stalls, queue a snapshot
+void feedbackTick();
+// Network task: newest snapshot queued since the last call, if any
+bool feedbackTakeSnapshot(FeedbackSnapshot *out);
+FeedbackStats feedbackStats();
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Incremental JSON tokenizer. Bytes can be fed in arbitrary chunks (e.g. the
+// WebServer raw upload callback) and each token is reported as soon as it is
+// complete, so a large document is never held in RAM. Only the current
+// string/number token is buffered; over-long strings are truncated.
+enum JsonStreamEvent {
+  JSON_OBJECT_START,
+  JSON_OBJECT_END,
+  JSON_ARRAY_START,
+  JSON_ARRAY_END,
+  JSON_KEY,      // object key; text is the key
+  JSON_STRING,   // string value
+  JSON_NUMBER,   // text is the number as written
+  JSON_LITERAL,  // text is "true", "false" or "null"
+};
+
+class JsonStreamHandler {
+ public:
+  virtual ~JsonStreamHandler() {}
+  // Return false to stop parsing (the handler keeps its own error)
+  virtual bool onJsonEvent(JsonStreamEvent event, const char* text, size_t len) = 0;
+};
+
+class JsonStreamParser {
+ public:
+  static const size_t MAX_DEPTH = 16;
+  static const size_t MAX_TOKEN = 63;
+
+  explicit JsonStreamParser(JsonStreamHandler& handler) : handler_(handler) { reset(); }
+
+  void reset();
+  // Returns false once the document is malformed or the handler stopped it
+  bool feed(const uint8_t* data, size_t len);
+  // Call after the last byte; true if exactly one complete value was parsed
+  bool finish();
+
+  bool failed() const { return error_ != nullptr; }
+  const char* error() const { return error_; }  // nullptr, or a static message
+  size_t offset() const { return offset_; }     // bytes consumed so far
+
+ private:
+  enum Lex : uint8_t { LEX_NONE, LEX_STRING, LEX_ESCAPE, LEX_UNICODE, LEX_NUMBER, LEX_LITERAL };
+  enum Expect : uint8_t {
+    EXPECT_VALUE,
+    EXPECT_VALUE_OR_END,  // just after '['
+    EXPECT_KEY_OR_END,    // just after '{'
+    EXPECT_KEY,           // after ',' inside an object
+    EXPECT_COLON,
+    EXPECT_COMMA_OR_END,
+    EXPECT_DONE,
+  };
+
+  bool step(char c);
+  bool startValue(char c);
+  bool endToken(JsonStreamEvent event);
+  void valueDone();
+  void appendToken(char c);
+  void appendUtf8(uint32_t cp);
+  bool fail(const char* message);
+  bool inObject() const { return depth_ > 0 && stack_[depth_ - 1] == '{'; }
+
+  JsonStreamHandler& handler_;
+  const char* error_;
+  size_t offset_;
+  char stack_[MAX_DEPTH];
+  uint8_t depth_;
+  Expect expect_;
+  Lex lex_;
+  bool stringIsKey_;
+  uint8_t unicodeDigits_;
+  uint32_t unicode_;
+  char token_[MAX_TOKEN + 1];
+  size_t tokenLen_;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Leveled logging resolved at compile time. Set ROBOT_LOG_LEVEL from
+// platformio.ini build_flags; calls above that level compile to nothing,
+// so debug logging costs nothing in the servo hot paths of release builds.
+#define ROBOT_LOG_LEVEL_NONE  0
+#define ROBOT_LOG_LEVEL_ERROR 1
+#define ROBOT_LOG_LEVEL_WARN  2
+#define ROBOT_LOG_LEVEL_INFO  3
+#define ROBOT_LOG_LEVEL_DEBUG 4
+
+#ifndef ROBOT_LOG_LEVEL
+#define ROBOT_LOG_LEVEL ROBOT_LOG_LEVEL_INFO
+#endif
+
+// ROBOT_LOG_RING=1 sends logs to an in-RAM ring buffer (served by GET /logs)
+// instead of the UART; errors are still echoed to Serial.
+#ifndef ROBOT_LOG_RING
+#define ROBOT_LOG_RING 0
+#endif
+
+#ifndef ROBOT_LOG_RING_SIZE
+#define ROBOT_LOG_RING_SIZE 8192
+#endif
+
+void logPrintf(int level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// Lines dropped because the UART TX buffer was full (non-error levels never block)
+uint32_t logDroppedCount();
+
+#if ROBOT_LOG_RING
+// Ring contents oldest-first as up to two contiguous spans; second may be empty
+void logRingSnapshot(const char** first, size_t* firstLen, const char** second, size_t* secondLen);
+#endif
+
+#if ROBOT_LOG_LEVEL >= ROBOT_LOG_LEVEL_ERROR
+#define LOGE(...) logPrintf(ROBOT_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOGE(...) do {} while (0)
+#endif
+
+#if ROBOT_LOG_LEVEL >= ROBOT_LOG_LEVEL_WARN
+#define LOGW(...) logPrintf(ROBOT_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOGW(...) do {} while (0)
+#endif
+
+#if ROBOT_LOG_LEVEL >= ROBOT_LOG_LEVEL_INFO
+#define LOGI(...) logPrintf(ROBOT_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOGI(...) do {} while (0)
+#endif
+
+#if ROBOT_LOG_LEVEL >= ROBOT_LOG_LEVEL_DEBUG
+#define LOGD(...) logPrintf(ROBOT_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOGD(...) do {} while (0)
+#endif
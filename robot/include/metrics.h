@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Fixed-bucket latency histograms fed from esp_timer_get_time() deltas.
+// Recording is a count-leading-zeros and three adds, with no locks and no
+// allocation, so it can sit in the control tick and in every request. Each
+// series has a single writer task; GET /metrics reads them unlocked and may
+// see one sample torn, which is fine for monitoring.
+//
+// Bucket 0 holds samples below 64 us, bucket i holds [2^(i+5), 2^(i+6)) us,
+// and the last bucket is open-ended (about 1 s and up).
+static const int METRICS_BUCKETS = 16;
+static const int METRICS_MAX_ROUTES = 32; // timedRoute()s in setupServer(), with headroom
+
+struct LatencyHistogram {
+  uint32_t count;
+  uint32_t maxUs;
+  uint64_t sumUs;
+  uint32_t buckets[METRICS_BUCKETS];
+};
+
+enum MetricsSeries {
+  METRIC_JSON_PARSE,    // JSON body parse per request (network task)
+  METRIC_LOOP_BUSY,     // one network loop iteration: handleClient, stream, batch timeout
+  METRIC_LOOP_GAP,      // start-to-start gap of network loop iterations; max is the worst stall
+  METRIC_TICK_JITTER,   // |actual - nominal| control tick interval (motion task)
+  METRIC_TICK_BUSY,     // motion task work per tick
+  METRIC_SERIES_COUNT
+};
+
+const char *metricsSeriesName(MetricsSeries series);
+
+// Upper bound of bucket i in microseconds; 0 for the open-ended last bucket
+uint32_t metricsBucketUpperUs(int bucket);
+
+void metricsRecord(MetricsSeries series, uint32_t us);
+const LatencyHistogram &metricsSeries(MetricsSeries series);
+
+// Routes are registered once from setup(); logs an error and returns -1 when
+// the table is full, leaving that route untimed
+int metricsRegisterRoute(const char *label);
+void metricsRecordRoute(int route, uint32_t us);
+int metricsRouteCount();
+const char *metricsRouteLabel(int route);
+const LatencyHistogram &metricsRoute(int route);
+
+// Clears every histogram (route labels are kept)
+void metricsReset();
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdint.h>
+
+// ESP32 side of lib/motion/motion_hal.h - each joint drives its own LEDC
+// channel at SERVO_PWM_HZ with SERVO_DUTY_BITS of resolution.
+static const uint8_t SERVO_LEDC_CHANNEL_BASE = 0; // servo index i uses channel base + i
+
+// Configure the LEDC channel for servo index i and attach it to JOINTS[i].pin
+void halServoAttach(int servoIndex);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Request arena - one buffer reserved at boot (in PSRAM when the board has
+// it) that HTTP handlers carve their JSON documents and serialized replies
+// from. Handlers run one at a time on the network task, so allocation is a
+// pointer bump and a RequestScope rewinds everything its handler took when it
+// goes out of scope, on every return path. Steady-state request handling
+// therefore leaves the heap alone and cannot fragment it.
+//
+// A request that needs more than is left falls back to malloc for that block
+// and is counted, so an undersized arena shows up in GET /metrics rather than
+// as a truncated reply.
+
+// Reserve the arena; returns false if neither PSRAM nor internal RAM had room
+bool requestArenaBegin(size_t internalBytes, size_t psramBytes);
+
+// Bump-allocate (8-byte aligned); heap fallback when the arena is exhausted
+void *requestArenaAlloc(size_t bytes);
+// Frees heap fallbacks; arena blocks are reclaimed by RequestScope instead
+void requestArenaFree(void *ptr);
+
+size_t requestArenaMark();
+void requestArenaRewind(size_t mark);
+
+size_t requestArenaCapacity();
+size_t requestArenaHighWater();
+uint32_t requestArenaFallbacks();
+bool requestArenaInPsram();
+
+class RequestScope {
+ public:
+  RequestScope() : mark_(requestArenaMark()) {}
+  ~RequestScope() { requestArenaRewind(mark_); }
+
+ private:
+  RequestScope(const RequestScope&);
+  RequestScope& operator=(const RequestScope&);
+  size_t mark_;
+};
+
+// ArduinoJson allocator over the arena; use as ArenaJsonDocument doc(capacity)
+struct ArenaAllocator {
+  void *allocate(size_t size) { return requestArenaAlloc(size); }
+  void deallocate(void *ptr) { requestArenaFree(ptr); }
+  // Only shrinkToFit() reallocates, always to a smaller size, so the block can stay put
+  void *reallocate(void *ptr, size_t) { return ptr; }
+};
+
+typedef BasicJsonDocument<ArenaAllocator> ArenaJsonDocument;
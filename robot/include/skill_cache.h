@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+// Compiled skills kept in LittleFS so a sequence uploaded once can be replayed
+// by name with no body. Each file holds the /sequence.bin encoding and is
+// named after a hash of the skill name; the index (name, size, content CRC,
+// last use) is kept in RAM and mirrored to /skills/index.bin. When the cache
+// runs out of entries or flash, the least recently used skill is evicted.
+// Stores, evictions and removals write the index at once; a play only bumps
+// its use in RAM, since a flash write stalls both cores, and skillCacheFlush()
+// writes the new order back later (a power cut before then only loses LRU
+// order).
+// The CRC is the standard CRC-32 (zlib.crc32) of the file bytes with the
+// skill name taken out (name length byte zeroed, name bytes skipped), so it
+// covers the steps and the header fields that drive playback, and a host can
+// ask whether the robot already holds a motion under any name before
+// uploading it.
+//
+// Not thread-safe: only the network task may call these.
+static const size_t SKILL_CACHE_MAX_ENTRIES = 16;
+static const size_t SKILL_NAME_MAX = 63;
+
+struct SkillCacheEntry {
+  char name[SKILL_NAME_MAX + 1];
+  uint32_t size;      // file size in bytes
+  uint32_t crc;       // content CRC-32, see above
+  uint32_t lastUsed;  // use counter value at the last store or play
+};
+
+// Mount the filesystem (formatting it on first boot) and load the index
+bool skillCacheBegin();
+bool skillCacheReady();
+
+size_t skillCacheCount();
+const SkillCacheEntry* skillCacheEntryAt(size_t index);
+const SkillCacheEntry* skillCacheFind(const char* name);
+const SkillCacheEntry* skillCacheFindByCrc(uint32_t crc);
+size_t skillCacheFreeBytes();
+uint32_t skillCacheEvictions();
+
+// Uploads go to a temporary file and only replace the cached copy on commit
+bool skillCacheBeginWrite(const char* name);
+bool skillCacheReserve(size_t bytes);  // evicts LRU skills until bytes fit
+bool skillCacheWrite(const uint8_t* data, size_t len);
+bool skillCacheCommit();
+void skillCacheAbortWrite();
+
+// Open a cached skill for reading and mark it most recently used
+File skillCacheOpen(const char* name);
+// Write back use order from skillCacheOpen() once plays have been quiet for a
+// while; call from the network task only while no sequence is playing
+void skillCacheFlush();
+bool skillCacheRemove(const char* name);
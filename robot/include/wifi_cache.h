@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+
+// Last good association kept in NVS so a reboot can skip the channel scan
+// and DHCP: WiFi.begin() is handed the cached BSSID and channel, and the
+// cached address is configured statically. That suits a router that
+// reserves the robot's address; if the fast attempt fails the cache is
+// dropped and the next connect scans and asks DHCP as usual.
+//
+// Addresses are stored as IPAddress's uint32_t form.
+struct WiFiCache {
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+};
+
+// False when nothing (or an entry from another layout) is stored
+bool wifiCacheLoad(WiFiCache* out);
+// Writes only when the entry differs from what is stored, to spare the flash
+void wifiCacheStore(const WiFiCache& cache);
+void wifiCacheClear();
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The robot's joints, defined once. Joint count, pins, names, servo
+// calibration and default planner limits all come from JOINTS; numeric ids on
+// the wire are the row number plus one, so id lookup is an array index.
+struct ServoCalibration {
+  uint16_t minUs;  // pulse at 0 degrees (typical SG90/MG90 range 500-2400)
+  uint16_t maxUs;  // pulse at 180 degrees
+  bool inverted;   // mirror-mounted joint: 0 degrees drives to maxUs
+  int8_t trimDeg;  // added to every command to correct horn placement
+};
+
+struct JointDef {
+  uint8_t id;            // numeric id used by the HTTP/UDP commands
+  uint8_t pin;           // servo signal GPIO
+  const char* name;
+  ServoCalibration cal;
+  float maxVelocity;     // default planner limit, deg/s
+  float maxAccel;        // default planner limit, deg/s^2
+};
+
+static constexpr JointDef JOINTS[] = {
+  // 0-2 left arm
+  {1, 13, "left_shoulder_vertical",    {500, 2400, false, 0}, 360, 2400},
+  {2, 14, "left_shoulder_horizontal",  {500, 2400, false, 0}, 360, 2400},
+  {3, 12, "left_elbow_vertical",       {500, 2400, true,  0}, 360, 2400}, // mounted reversed
+  // 3-5 right arm
+  {4, 27, "right_shoulder_vertical",   {500, 2400, false, 0}, 360, 2400},
+  {5, 26, "right_shoulder_horizontal", {500, 2400, false, 0}, 360, 2400},
+  {6, 25, "right_elbow_vertical",      {500, 2400, false, 0}, 360, 2400},
+};
+
+static constexpr int SERVO_COUNT = sizeof(JOINTS) / sizeof(JOINTS[0]);
+
+// Bit i set -> joint index i; widen this type to go past eight joints
+typedef uint8_t JointMask;
+
+// Compile-time checks on the table (C++11 constexpr, hence the recursion)
+constexpr bool jointIdsMatchRows(int i = 0) {
+  return i >= SERVO_COUNT || (JOINTS[i].id == i + 1 && jointIdsMatchRows(i + 1));
+}
+
+constexpr bool jointPinUnusedAfter(int i, int j) {
+  return j >= SERVO_COUNT || (JOINTS[i].pin != JOINTS[j].pin && jointPinUnusedAfter(i, j + 1));
+}
+
+constexpr bool jointPinsUnique(int i = 0) {
+  return i >= SERVO_COUNT || (jointPinUnusedAfter(i, i + 1) && jointPinsUnique(i + 1));
+}
+
+constexpr bool jointCalibrationsValid(int i = 0) {
+  return i >= SERVO_COUNT ||
+         (JOINTS[i].cal.minUs < JOINTS[i].cal.maxUs && JOINTS[i].maxVelocity > 0 &&
+          JOINTS[i].maxAccel > 0 && jointCalibrationsValid(i + 1));
+}
+
+static_assert(SERVO_COUNT > 0, "JOINTS must define at least one joint");
+static_assert(SERVO_COUNT <= 8 * (int)sizeof(JointMask), "JointMask is too narrow for SERVO_COUNT");
+static_assert(SERVO_COUNT <= 16, "each joint needs its own LEDC channel (16 on the ESP32)");
+static_assert(jointIdsMatchRows(), "JOINTS ids must be 1..SERVO_COUNT in row order");
+static_assert(jointPinsUnique(), "two joints share a servo pin");
+static_assert(jointCalibrationsValid(), "joint calibration or planner limits out of range");
+
+// Numeric id -> joint index, or -1
+inline int getServoIndex(int numericId) {
+  return numericId >= 1 && numericId <= SERVO_COUNT ? numericId - 1 : -1;
+}
+
+inline const char* getServoName(int numericId) {
+  int idx = getServoIndex(numericId);
+  return idx < 0 ? "unknown" : JOINTS[idx].name;
+}
@@ -0,0 +1,666 @@
+#include "motion_core.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "logging.h"
+
+static inline int clampInt(int v, int lo, int hi) {
+  return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// Servo output
+
+uint16_t servoDutyLut[SERVO_COUNT][181];
+int currentAngles[SERVO_COUNT];
+
+uint16_t servoPulseUs(int servoIndex, int angle) {
+  const ServoCalibration &cal = JOINTS[servoIndex].cal;
+  int deg = clampInt(angle + cal.trimDeg, 0, 180);
+  if (cal.inverted) deg = 180 - deg;
+  return (uint16_t)(cal.minUs + ((int32_t)(cal.maxUs - cal.minUs) * deg + 90) / 180);
+}
+
+void buildServoLut(int servoIndex) {
+  const uint32_t maxDuty = (1u << SERVO_DUTY_BITS) - 1;
+  for (int angle = 0; angle <= 180; ++angle) {
+    uint32_t us = servoPulseUs(servoIndex, angle);
+    servoDutyLut[servoIndex][angle] = (uint16_t)((us * maxDuty + SERVO_PERIOD_US / 2) / SERVO_PERIOD_US);
+  }
+}
+
+// Planner
+
+JointMotion joints[SERVO_COUNT];
+float jointMaxVelocity[SERVO_COUNT];
+float jointMaxAccel[SERVO_COUNT];
+volatile MotionProfile defaultProfile = PROFILE_TRAPEZOIDAL;
+
+void motionInitJoint(int servoIndex, int cdeg) {
+  jointMaxVelocity[servoIndex] = JOINTS[servoIndex].maxVelocity;
+  jointMaxAccel[servoIndex] = JOINTS[servoIndex].maxAccel;
+  buildServoLut(servoIndex);
+
+  JointMotion &j = joints[servoIndex];
+  j.start = j.target = j.position = cdeg / (float)CDEG_PER_DEG;
+  j.active = false;
+  j.lastDuty = servoDuty(servoIndex, cdeg);
+  halServoWrite(servoIndex, j.lastDuty);
+  currentAngles[servoIndex] = (cdeg + CDEG_PER_DEG / 2) / CDEG_PER_DEG;
+}
+
+const char* motionProfileName(MotionProfile profile) {
+  switch (profile) {
+    case PROFILE_LINEAR: return "linear";
+    case PROFILE_CUBIC: return "cubic";
+    default: return "trapezoidal";
+  }
+}
+
+bool parseMotionProfile(const char* name, MotionProfile* out) {
+  if (!name) return false;
+  if (strcmp(name, "linear") == 0) { *out = PROFILE_LINEAR; return true; }
+  if (strcmp(name, "trapezoidal") == 0) { *out = PROFILE_TRAPEZOIDAL; return true; }
+  if (strcmp(name, "cubic") == 0) { *out = PROFILE_CUBIC; return true; }
+  return false;
+}
+
+// Shortest segment (ms) that moves distance degrees within a joint's limits
+float minSegmentMs(int idx, float distance, MotionProfile profile) {
+  float v = jointMaxVelocity[idx];
+  float a = jointMaxAccel[idx];
+  float tv, ta;
+  switch (profile) {
+    case PROFILE_LINEAR:
+      return distance / v * 1000.0f; // acceleration is unbounded by definition
+    case PROFILE_CUBIC:
+      // smoothstep: peak velocity 1.5 d/T, peak acceleration 6 d/T^2
+      tv = 1.5f * distance / v;
+      ta = sqrtf(6.0f * distance / a);
+      break;
+    default:
+      // quarter-duration ramps: peak velocity d/(0.75T), acceleration d/(0.1875T^2)
+      tv = distance / (0.75f * v);
+      ta = sqrtf(distance / (0.1875f * a));
+      break;
+  }
+  return (tv > ta ? tv : ta) * 1000.0f;
+}
+
+// Normalised position along a segment for normalised time u in [0,1]
+float profileShape(MotionProfile profile, float u) {
+  switch (profile) {
+    case PROFILE_LINEAR:
+      return u;
+    case PROFILE_CUBIC:
+      return u * u * (3.0f - 2.0f * u);
+    default:
+      // accelerate over [0,0.25], cruise, decelerate over [0.75,1]; peak velocity 4/3
+      if (u < 0.25f) return (8.0f / 3.0f) * u * u;
+      if (u > 0.75f) return 1.0f - (8.0f / 3.0f) * (1.0f - u) * (1.0f - u);
+      return (4.0f / 3.0f) * u - (1.0f / 6.0f);
+  }
+}
+
+// Start a coordinated move of the masked joints to angles (centidegrees); all
+// of them arrive together durationMs after startedAt, stretched if any joint's
+// limits need longer. startedAt may be slightly in the past so timeline steps
+// stay anchored to their deadline rather than to the tick that noticed it.
+void plannerMoveToAt(const int angles[SERVO_COUNT], JointMask mask, unsigned long durationMs,
+                     MotionProfile profile, unsigned long startedAt) {
+  float segmentMs = (float)durationMs;
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    if (!(mask & (1 << i))) continue;
+    float target = angles[i] / (float)CDEG_PER_DEG;
+    float needed = minSegmentMs(i, fabsf(target - joints[i].position), profile);
+    if (needed > segmentMs) segmentMs = needed;
+  }
+
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    if (!(mask & (1 << i))) continue;
+    JointMotion &j = joints[i];
+    j.start = j.position;
+    j.target = angles[i] / (float)CDEG_PER_DEG;
+    j.startedAt = startedAt;
+    j.durationMs = (unsigned long)(segmentMs + 0.5f);
+    j.profile = profile;
+    j.active = (j.start != j.target);
+  }
+}
+
+void plannerMoveTo(const int angles[SERVO_COUNT], JointMask mask, unsigned long durationMs, MotionProfile profile) {
+  plannerMoveToAt(angles, mask, durationMs, profile, halMillis());
+}
+
+// Freeze every joint where it currently is
+void plannerHold() {
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    joints[i].target = joints[i].position;
+    joints[i].active = false;
+  }
+}
+
+bool plannerMoving() {
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    if (joints[i].active) return true;
+  }
+  return false;
+}
+
+// Advance active segments and write servos; runs once per control tick
+void plannerTick() {
+  unsigned long now = halMillis();
+
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    JointMotion &j = joints[i];
+    if (!j.active) continue;
+
+    unsigned long elapsed = now - j.startedAt;
+    if (elapsed >= j.durationMs) {
+      j.position = j.target;
+      j.active = false;
+    } else {
+      float u = (float)elapsed / (float)j.durationMs;
+      j.position = j.start + (j.target - j.start) * profileShape(j.profile, u);
+    }
+
+    int cdeg = clampInt((int)lroundf(j.position * CDEG_PER_DEG), 0, MAX_ANGLE_CDEG);
+    uint16_t duty = servoDuty(i, cdeg);
+    if (duty != j.lastDuty) {
+      halServoWrite(i, duty);
+      j.lastDuty = duty;
+      currentAngles[i] = (cdeg + CDEG_PER_DEG / 2) / CDEG_PER_DEG; // whole degrees for status
+    }
+  }
+}
+
+// Network task -> motion task queue
+
+SpscQueue<MotionCommand, MOTION_QUEUE_CAPACITY> motionQueue;
+uint32_t motionQueueDrops = 0;
+
+bool postMotion(const MotionCommand &cmd) {
+  if (motionQueue.push(cmd)) return true;
+  motionQueueDrops++;
+  LOGW("⚠️ Motion queue full, command %d dropped", (int)cmd.type);
+  return false;
+}
+
+bool requestMove(const int angles[SERVO_COUNT], JointMask mask, unsigned long durationMs, bool supersedeScheduled,
+                 bool streamed) {
+  MotionCommand cmd = {};
+  cmd.type = MOTION_MOVE;
+  memcpy(cmd.angles, angles, sizeof(cmd.angles));
+  cmd.mask = mask;
+  cmd.profile = defaultProfile;
+  cmd.supersedeScheduled = supersedeScheduled;
+  cmd.streamed = streamed;
+  cmd.durationMs = durationMs;
+  return postMotion(cmd);
+}
+
+// Batch buffer
+
+BatchedCommand batchBuffer[SERVO_COUNT];
+int batchCount = 0;
+bool batchReady = false;
+unsigned long batchStartTime = 0;
+uint32_t batchTimeouts = 0;
+
+// Initialize batch buffer
+void initializeBatch() {
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    batchBuffer[i].servoId = i + 1;
+    batchBuffer[i].angle = 90 * CDEG_PER_DEG; // default angle
+    batchBuffer[i].timestamp = 0;
+    batchBuffer[i].isSet = false;
+  }
+  batchCount = 0;
+  batchReady = false;
+  batchStartTime = halMillis();
+}
+
+bool executeBatch(unsigned long durationMs, bool supersedeScheduled, bool streamed) {
+  if (batchCount == 0) return true;
+
+  LOGD("🚀 Executing batch of %d servo commands simultaneously", batchCount);
+
+  // Hand all commands in the batch to the planner as one coordinated move
+  int angles[SERVO_COUNT];
+  JointMask mask = 0;
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    if (batchBuffer[i].isSet) {
+      int idx = getServoIndex(batchBuffer[i].servoId);
+      if (idx >= 0) {
+        angles[idx] = batchBuffer[i].angle;
+        mask |= (1 << idx);
+
+        LOGD("  ⚡ Servo %d (%s) -> %.2f°", batchBuffer[i].servoId,
+             getServoName(batchBuffer[i].servoId), batchBuffer[i].angle / (float)CDEG_PER_DEG);
+      }
+    }
+  }
+  bool queued = requestMove(angles, mask, durationMs, supersedeScheduled, streamed);
+
+  // Reset batch
+  initializeBatch();
+  return queued;
+}
+
+// Drop an incomplete batch once it is stale; executing it would move servos
+// to angles from a client that has stopped mid-batch
+void checkBatchTimeout() {
+  if (batchCount > 0 && (halMillis() - batchStartTime) >= BATCH_TIMEOUT) {
+    LOGW("⏰ Batch timeout - dropping %d of %d servo commands", batchCount, SERVO_COUNT);
+    batchTimeouts++;
+    initializeBatch();
+  }
+}
+
+// Stream watchdog
+
+volatile unsigned long streamDeadlineMs = ROBOT_STREAM_DEADLINE_MS;
+volatile StreamTimeoutAction streamTimeoutAction = STREAM_TIMEOUT_HOLD;
+int safePose[SERVO_COUNT] = {90 * CDEG_PER_DEG, 90 * CDEG_PER_DEG, 90 * CDEG_PER_DEG,
+                             90 * CDEG_PER_DEG, 90 * CDEG_PER_DEG, 90 * CDEG_PER_DEG};
+uint32_t streamWatchdogTrips = 0;
+volatile bool streamWatchdogArmed = false;
+static unsigned long streamPoseAt = 0; // halMillis() when the last streamed pose started
+static unsigned long streamPoseMs = 0; // its requested duration
+
+const char* streamTimeoutActionName(StreamTimeoutAction action) {
+  return action == STREAM_TIMEOUT_SAFE_POSE ? "safe_pose" : "hold";
+}
+
+bool parseStreamTimeoutAction(const char* name, StreamTimeoutAction* out) {
+  if (!name) return false;
+  if (strcmp(name, "hold") == 0) { *out = STREAM_TIMEOUT_HOLD; return true; }
+  if (strcmp(name, "safe_pose") == 0) { *out = STREAM_TIMEOUT_SAFE_POSE; return true; }
+  return false;
+}
+
+static void armStreamWatchdog(unsigned long durationMs) {
+  streamPoseAt = halMillis();
+  streamPoseMs = durationMs;
+  streamWatchdogArmed = true;
+}
+
+// Runs once per control tick, after the queue is drained, so a pose that
+// arrived this tick has already re-armed it. The deadline is read here
+// rather than when arming, so a new setting applies to a stream in progress.
+void processStreamWatchdog() {
+  if (!streamWatchdogArmed) return;
+  unsigned long deadline = streamDeadlineMs;
+  if (deadline == 0) return;
+  if (sequenceBusy()) {
+    streamWatchdogArmed = false; // a sequence owns the planner now
+    return;
+  }
+  unsigned long now = halMillis();
+  if (now - streamPoseAt < streamPoseMs + deadline) return;
+  streamWatchdogArmed = false;
+
+  if (streamTimeoutAction == STREAM_TIMEOUT_SAFE_POSE) {
+    streamWatchdogTrips++;
+    LOGW("🛟 No streamed pose for %lums - easing to the safe pose", now - streamPoseAt);
+    plannerMoveTo(safePose, (JointMask)((1 << SERVO_COUNT) - 1), SAFE_POSE_EASE_MS, defaultProfile);
+  } else if (plannerMoving()) {
+    // A pose already reached needs no action; one still in flight is frozen
+    streamWatchdogTrips++;
+    LOGW("🛟 No streamed pose for %lums - holding mid-move", now - streamPoseAt);
+    plannerHold();
+  }
+}
+
+// Scheduled frame
+
+PendingFrame pendingFrame = {{0}, 0, 0, 0, false};
+
+// Overwrite the batch with one pose and execute it in a single pass; a frame
+// always supersedes one that is still scheduled
+bool applyFrame(const int angles[SERVO_COUNT], JointMask mask, unsigned long durationMs) {
+  unsigned long now = halMillis();
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    if (!(mask & (1 << i))) continue;
+    batchBuffer[i].angle = angles[i];
+    batchBuffer[i].timestamp = now;
+    if (!batchBuffer[i].isSet) {
+      batchBuffer[i].isSet = true;
+      batchCount++;
+    }
+  }
+  batchReady = true;
+  return executeBatch(durationMs, true, true);
+}
+
+// Apply a scheduled frame once its deadline passes; runs once per control tick
+void processPendingFrame() {
+  if (!pendingFrame.active) return;
+  if ((long)(halMillis() - pendingFrame.applyAt) < 0) return;
+  pendingFrame.active = false;
+  plannerMoveTo(pendingFrame.angles, pendingFrame.mask, pendingFrame.durationMs, defaultProfile);
+  armStreamWatchdog(pendingFrame.durationMs);
+}
+
+// Servo stacks
+
+static RingBuffer<ServoCommand, STACK_CAPACITY> servoStacks[SERVO_COUNT];
+static unsigned long lastStackExecution[SERVO_COUNT] = {0};
+uint32_t stackDropped[SERVO_COUNT] = {0};
+
+// Queue count angles for one servo. Under STACK_REJECT nothing is queued
+// unless all of them fit; returns false in that case.
+bool enqueueStack(int idx, const int *angles, int count, StackOverflowPolicy policy, int *dropped) {
+  unsigned long now = halMillis();
+  *dropped = 0;
+  halStackLock();
+  if (policy == STACK_REJECT && servoStacks[idx].available() < (size_t)count) {
+    halStackUnlock();
+    return false;
+  }
+  for (int i = 0; i < count; ++i) {
+    ServoCommand cmd = {angles[i], now};
+    if (servoStacks[idx].pushOverwrite(cmd)) (*dropped)++;
+  }
+  stackDropped[idx] += *dropped;
+  halStackUnlock();
+  return true;
+}
+
+bool dequeueStack(int idx, ServoCommand &out, size_t *remaining) {
+  halStackLock();
+  bool ok = servoStacks[idx].pop(out);
+  *remaining = servoStacks[idx].size();
+  halStackUnlock();
+  return ok;
+}
+
+size_t stackDepth(int idx) {
+  halStackLock();
+  size_t depth = servoStacks[idx].size();
+  halStackUnlock();
+  return depth;
+}
+
+void clearStacks() {
+  halStackLock();
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    servoStacks[i].clear();
+  }
+  halStackUnlock();
+}
+
+// Process servo stacks in parallel (keeping for backwards compatibility); runs on the motion task
+void processServoStacks() {
+  unsigned long now = halMillis();
+
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    // Check if it's time to execute next command for this servo
+    if (now - lastStackExecution[i] >= STACK_EXECUTION_INTERVAL) {
+      ServoCommand cmd;
+      size_t remaining;
+      if (dequeueStack(i, cmd, &remaining)) {
+
+        // Hand the command to the planner; it should arrive before the next one is due
+        int angles[SERVO_COUNT];
+        angles[i] = cmd.angle;
+        plannerMoveTo(angles, (JointMask)(1 << i), STACK_EXECUTION_INTERVAL, defaultProfile);
+        lastStackExecution[i] = now;
+        streamWatchdogArmed = false;
+
+        LOGD("⚡ Executed - Servo %d -> %.2f° | Remaining in stack: %u",
+             i + 1, cmd.angle / (float)CDEG_PER_DEG, (unsigned)remaining);
+      }
+    }
+  }
+}
+
+// Sequence executor
+
+SequenceStep sequenceSteps[MAX_SEQUENCE_STEPS];
+int sequenceLength = 0;
+int sequenceCursor = 0;
+unsigned long sequenceStepMs = DEFAULT_STEP_DURATION_MS;
+MotionProfile sequenceProfile = PROFILE_TRAPEZOIDAL;
+unsigned long sequenceStartTime = 0;
+unsigned long sequenceNextStepAt = 0;
+uint32_t sequenceJobId = 0;
+volatile SequenceState sequenceState = SEQ_IDLE;
+char sequenceSkill[SEQUENCE_SKILL_MAX + 1] = "";
+std::atomic<int> sequenceStepsReady{0};
+std::atomic<int> sequenceStepsDone{0};
+uint32_t sequenceUnderruns = 0;
+static bool sequenceStarved = false; // motion task: waiting on the uploader right now
+
+const char* sequenceStateName(SequenceState state) {
+  switch (state) {
+    case SEQ_QUEUED: return "queued";
+    case SEQ_SCHEDULED: return "scheduled";
+    case SEQ_RUNNING: return "running";
+    case SEQ_COMPLETED: return "completed";
+    case SEQ_ABORTED: return "aborted";
+    default: return "idle";
+  }
+}
+
+bool sequenceBusy() {
+  return sequenceState == SEQ_QUEUED || sequenceState == SEQ_SCHEDULED || sequenceState == SEQ_RUNNING;
+}
+
+// A start time is accepted if it is within MAX_START_LEAD_MS of now either way
+// (a slightly late one still joins the timeline in phase)
+bool validStartAt(unsigned long startAt) {
+  long lead = (long)(startAt - halMillis());
+  return lead <= MAX_START_LEAD_MS && lead >= -MAX_START_LEAD_MS;
+}
+
+// Network task: queue playback of the first stepCount entries of sequenceSteps,
+// from startAt (device millis) when timedStart is set, otherwise right away.
+// A pipelined job plays steps as sequencePublishSteps() makes them available.
+// Returns the job id, or 0 if the motion queue was full.
+uint32_t startSequence(const char *skill, int stepCount, unsigned long stepMs, MotionProfile profile,
+                       bool timedStart, unsigned long startAt, bool pipelined) {
+  MotionCommand cmd = {};
+  cmd.type = MOTION_START_SEQUENCE;
+  cmd.stepCount = stepCount;
+  cmd.durationMs = stepMs;
+  cmd.profile = profile;
+  cmd.timedStart = timedStart;
+  cmd.applyAt = startAt;
+
+  if (!pipelined) {
+    sequenceStepsDone.store(0, std::memory_order_relaxed);
+    sequencePublishSteps(stepCount);
+  }
+  SequenceState previous = sequenceState;
+  sequenceState = SEQ_QUEUED; // claim the table before the motion task can see the command
+  strncpy(sequenceSkill, skill, SEQUENCE_SKILL_MAX);
+  sequenceSkill[SEQUENCE_SKILL_MAX] = '\0';
+  sequenceJobId++;
+  if (!postMotion(cmd)) {
+    sequenceState = previous;
+    sequenceJobId--;
+    return 0;
+  }
+  LOGI("▶️ Sequence job %u queued: %d steps @ %lums", (unsigned)sequenceJobId, stepCount, stepMs);
+  return sequenceJobId;
+}
+
+// Network task: the table is idle, so both counters can be rewound
+void sequencePipelineBegin() {
+  sequenceStepsDone.store(0, std::memory_order_relaxed);
+  sequencePublishSteps(0);
+}
+
+// Network task: returns true if a queued or running job will be stopped
+bool requestSequenceAbort() {
+  if (!sequenceBusy()) return false;
+  MotionCommand cmd = {};
+  cmd.type = MOTION_ABORT_SEQUENCE;
+  return postMotion(cmd);
+}
+
+// Motion task: start playing a job handed over by startSequence()
+void beginSequence(int stepCount, unsigned long stepMs, MotionProfile profile, bool timedStart, unsigned long startAt) {
+  unsigned long now = halMillis();
+  sequenceProfile = profile;
+  sequenceLength = stepCount;
+  sequenceCursor = 0;
+  sequenceStepMs = stepMs;
+  sequenceStartTime = timedStart ? startAt : now;
+  sequenceNextStepAt = sequenceStartTime; // first step plays on this tick unless scheduled later
+  sequenceStarved = false;
+  sequenceState = (long)(sequenceStartTime - now) > 0 ? SEQ_SCHEDULED : SEQ_RUNNING;
+}
+
+// Motion task: returns true if a queued or running sequence was stopped
+bool abortSequence() {
+  if (!sequenceBusy()) return false;
+  sequenceState = SEQ_ABORTED;
+  plannerHold(); // stop mid-keyframe instead of finishing the current step
+  LOGI("⏹ Sequence job %u aborted at step %d", (unsigned)sequenceJobId, sequenceCursor);
+  return true;
+}
+
+// Each step is a keyframe reached over the step duration, timed from its deadline
+static void applySequenceStep(const SequenceStep &step, unsigned long deadline) {
+  int angles[SERVO_COUNT];
+  for (int idx = 0; idx < SERVO_COUNT; ++idx) {
+    angles[idx] = step.angles[idx];
+  }
+  plannerMoveToAt(angles, step.mask, sequenceStepMs, sequenceProfile, deadline);
+}
+
+// Overlay the joints src commands onto dst, keeping dst's other targets
+static void foldSequenceStep(SequenceStep &dst, const SequenceStep &src) {
+  for (int idx = 0; idx < SERVO_COUNT; ++idx) {
+    if (src.mask & (1 << idx)) dst.angles[idx] = src.angles[idx];
+  }
+  dst.mask |= src.mask;
+}
+
+// Advance the running sequence; runs once per control tick
+void processSequence() {
+  unsigned long now = halMillis();
+  if (sequenceState == SEQ_SCHEDULED) {
+    if ((long)(now - sequenceStartTime) < 0) return;
+    sequenceState = SEQ_RUNNING;
+    LOGI("▶️ Sequence job %u started on schedule (%ldms after start_at)", (unsigned)sequenceJobId,
+         (long)(now - sequenceStartTime));
+  }
+  if (sequenceState != SEQ_RUNNING) return;
+  if ((long)(now - sequenceNextStepAt) < 0) return;
+
+  int ready = sequenceStepsReady.load(std::memory_order_acquire);
+  if (sequenceCursor < sequenceLength && sequenceCursor >= ready) {
+    // Pipelined upload is behind: hold the pose and re-anchor the timeline so
+    // the next step plays on the tick it arrives
+    if (!sequenceStarved) {
+      sequenceStarved = true;
+      sequenceUnderruns++;
+      LOGW("⏳ Sequence job %u waiting for step %d", (unsigned)sequenceJobId, sequenceCursor + 1);
+    }
+    sequenceNextStepAt = now;
+    return;
+  }
+  sequenceStarved = false;
+
+  // Whole steps already missed (late start or a stalled task) are skipped so
+  // playback stays on the shared timeline, though never past the last step
+  // that has arrived and never past the final pose, which is always played
+  // Delta-encoded steps only list the joints they change, so the targets of
+  // skipped steps are carried into the step playback lands on
+  SequenceStep skipped;
+  skipped.mask = 0;
+  unsigned long behind = now - sequenceNextStepAt;
+  if (behind >= sequenceStepMs && sequenceCursor < sequenceLength) {
+    int skip = (int)(behind / sequenceStepMs);
+    int limit = (ready < sequenceLength ? ready : sequenceLength) - 1;
+    if (skip > limit - sequenceCursor) skip = limit - sequenceCursor;
+    if (skip > 0) {
+      for (int s = sequenceCursor; s < sequenceCursor + skip; ++s) foldSequenceStep(skipped, sequenceSlot(s));
+      sequenceCursor += skip; // the folded slots may be refilled from here
+      sequenceNextStepAt += (unsigned long)skip * sequenceStepMs;
+      sequenceStepsDone.store(sequenceCursor, std::memory_order_release);
+      LOGW("⏩ Sequence job %u skipped %d late steps", (unsigned)sequenceJobId, skip);
+    }
+    // Clamped short of the timeline: re-anchor so this step still gets its
+    // full duration instead of snapping to a deadline long past
+    if (now - sequenceNextStepAt >= sequenceStepMs) sequenceNextStepAt = now;
+  }
+
+  if (sequenceCursor >= sequenceLength) {
+    // Last step has had its full duration to settle
+    sequenceState = SEQ_COMPLETED;
+    LOGI("✅ Sequence job %u completed in %lums", (unsigned)sequenceJobId, now - sequenceStartTime);
+    return;
+  }
+
+  if (skipped.mask) {
+    foldSequenceStep(skipped, sequenceSlot(sequenceCursor));
+    applySequenceStep(skipped, sequenceNextStepAt);
+  } else {
+    applySequenceStep(sequenceSlot(sequenceCursor), sequenceNextStepAt);
+  }
+  LOGD("🔢 Step %d/%d", sequenceCursor + 1, sequenceLength);
+
+  sequenceCursor++;
+  sequenceStepsDone.store(sequenceCursor, std::memory_order_release); // slot may be refilled
+  // Schedule against the previous deadline so a late pass doesn't stretch the timeline
+  sequenceNextStepAt += sequenceStepMs;
+}
+
+// Control tick
+
+void runMotionCommand(const MotionCommand &cmd) {
+  switch (cmd.type) {
+    case MOTION_MOVE:
+      if (cmd.supersedeScheduled) pendingFrame.active = false;
+      plannerMoveTo(cmd.angles, cmd.mask, cmd.durationMs, cmd.profile);
+      if (cmd.streamed) {
+        armStreamWatchdog(cmd.durationMs);
+      } else {
+        streamWatchdogArmed = false;
+      }
+      break;
+    case MOTION_SCHEDULE:
+      memcpy(pendingFrame.angles, cmd.angles, sizeof(pendingFrame.angles));
+      pendingFrame.mask = cmd.mask;
+      pendingFrame.durationMs = cmd.durationMs;
+      pendingFrame.applyAt = cmd.applyAt;
+      pendingFrame.active = true; // replaces any frame still waiting
+      break;
+    case MOTION_START_SEQUENCE:
+      streamWatchdogArmed = false;
+      beginSequence(cmd.stepCount, cmd.durationMs, cmd.profile, cmd.timedStart, cmd.applyAt);
+      break;
+    case MOTION_ABORT_SEQUENCE:
+      abortSequence();
+      break;
+    case MOTION_CALIBRATE: {
+      abortSequence();
+      pendingFrame.active = false;
+      streamWatchdogArmed = false;
+      clearStacks();
+      // Ease all servos back to neutral within the joint limits
+      int neutral[SERVO_COUNT];
+      for (int i = 0; i < SERVO_COUNT; ++i) {
+        neutral[i] = 90 * CDEG_PER_DEG;
+      }
+      plannerMoveTo(neutral, (JointMask)((1 << SERVO_COUNT) - 1), 0, defaultProfile);
+      break;
+    }
+  }
+}
+
+void motionTick() {
+  MotionCommand cmd;
+  while (motionQueue.pop(cmd)) {
+    runMotionCommand(cmd);
+  }
+  processSequence();       // Advance sequence playback against its step deadlines
+  processPendingFrame();   // Apply a scheduled /frame once its time arrives
+  processServoStacks();    // Process servo command stacks in parallel
+  processStreamWatchdog(); // Hold or ease to the safe pose if the stream has stalled
+  plannerTick();           // Interpolate joints toward their targets
+}
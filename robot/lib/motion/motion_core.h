@@ -0,0 +1,288 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "joints.h"
+#include "motion_hal.h"
+#include "ring_buffer.h"
+#include "spsc_queue.h"
+
+// Motion core - batch buffer, per-servo stacks, scheduled frame, sequence
+// executor and planner, with no Arduino, WiFi or HTTP dependency. Hardware
+// access goes through motion_hal.h, so the same code runs on the ESP32 and in
+// the native simulator (pio run -e native). Functions marked "motion task"
+// run from motionTick(); the network task reaches motion state only through
+// motionQueue, the stack lock and the sequence handover in startSequence().
+
+// Angles travel the whole command path as centidegrees (0-18000): JSON
+// accepts fractional degrees, and the binary sequence and stream formats have
+// 16-bit variants, so slow interpolated motion is not quantised to 1 degree
+// (one degree is ~10 us of pulse; one duty step at 16 bits is ~0.3 us).
+static const int CDEG_PER_DEG = 100;
+static const int MAX_ANGLE_CDEG = 180 * CDEG_PER_DEG;
+
+// Servo output - per-servo calibration is folded into a 181-entry duty table
+// when the joints are initialised; sub-degree angles interpolate between
+// neighbouring entries, so a write is two table loads, a multiply and one
+// halServoWrite().
+static const uint8_t SERVO_DUTY_BITS = 16;
+static const uint32_t SERVO_PWM_HZ = 50;
+static const uint32_t SERVO_PERIOD_US = 1000000 / SERVO_PWM_HZ;
+
+extern uint16_t servoDutyLut[SERVO_COUNT][181];
+extern int currentAngles[SERVO_COUNT]; // whole degrees, for status replies
+
+// Pulse width for a commanded angle (whole degrees) after trim and inversion
+uint16_t servoPulseUs(int servoIndex, int angle);
+void buildServoLut(int servoIndex);
+
+// Duty for an angle in centidegrees; cdeg must already be within 0-18000
+inline uint16_t servoDuty(int servoIndex, int cdeg) {
+  const uint16_t *lut = servoDutyLut[servoIndex];
+  int deg = cdeg / CDEG_PER_DEG;
+  int frac = cdeg % CDEG_PER_DEG;
+  if (frac == 0) return lut[deg];
+  return (uint16_t)(lut[deg] + ((int32_t)(lut[deg + 1] - lut[deg]) * frac) / CDEG_PER_DEG);
+}
+
+// Limits, duty table and planner state for one joint, starting at cdeg; the
+// servo output must be ready because the starting duty is written right away
+void motionInitJoint(int servoIndex, int cdeg);
+
+// Motion planner - every path hands target angles to the planner, which
+// interpolates each joint at a fixed 50 Hz tick (the servo PWM rate) within
+// per-joint velocity and acceleration limits instead of slamming to the target.
+// Planner state belongs to the motion task.
+enum MotionProfile { PROFILE_LINEAR, PROFILE_TRAPEZOIDAL, PROFILE_CUBIC };
+
+static const unsigned long CONTROL_TICK_MS = 20;
+
+struct JointMotion {
+  float start;              // degrees at segment start
+  float target;             // degrees at segment end
+  float position;           // current interpolated degrees
+  unsigned long startedAt;  // halMillis() when the segment began
+  unsigned long durationMs; // segment length after limits are applied
+  MotionProfile profile;
+  uint16_t lastDuty;        // last duty sent to the servo
+  bool active;
+};
+
+extern JointMotion joints[SERVO_COUNT];
+extern float jointMaxVelocity[SERVO_COUNT];  // deg/s, defaults from JOINTS, tunable via POST /planner
+extern float jointMaxAccel[SERVO_COUNT];     // deg/s^2
+extern volatile MotionProfile defaultProfile;
+
+const char* motionProfileName(MotionProfile profile);
+bool parseMotionProfile(const char* name, MotionProfile* out);
+float minSegmentMs(int idx, float distance, MotionProfile profile);
+float profileShape(MotionProfile profile, float u);
+void plannerMoveToAt(const int angles[SERVO_COUNT], JointMask mask, unsigned long durationMs,
+                     MotionProfile profile, unsigned long startedAt);
+void plannerMoveTo(const int angles[SERVO_COUNT], JointMask mask, unsigned long durationMs, MotionProfile profile);
+void plannerHold();
+bool plannerMoving();
+void plannerTick();
+
+// Commands from the network task (HTTP handlers, UDP stream, batch timeout)
+// on core 0 to the motion task on core 1. The network task is the only
+// producer and the motion task the only consumer, so a lock-free SPSC ring is
+// enough and neither side ever blocks on the other.
+enum MotionCommandType {
+  MOTION_MOVE,           // start a planner move now
+  MOTION_SCHEDULE,       // hold a frame until applyAt, replacing any waiting one
+  MOTION_START_SEQUENCE, // begin playing the step table
+  MOTION_ABORT_SEQUENCE,
+  MOTION_CALIBRATE       // abort, clear stacks and scheduled frame, ease to neutral
+};
+
+struct MotionCommand {
+  MotionCommandType type;
+  int angles[SERVO_COUNT];  // centidegrees
+  JointMask mask;
+  MotionProfile profile;
+  bool supersedeScheduled;  // MOTION_MOVE: drop a scheduled frame that hasn't fired
+  bool streamed;            // MOTION_MOVE: a /frame or UDP stream pose; arms the stream watchdog
+  unsigned long durationMs; // move duration, or step duration for sequences
+  unsigned long applyAt;    // MOTION_SCHEDULE deadline, or MOTION_START_SEQUENCE start (millis)
+  bool timedStart;          // MOTION_START_SEQUENCE: start at applyAt instead of on receipt
+  int stepCount;            // MOTION_START_SEQUENCE
+};
+
+static const size_t MOTION_QUEUE_CAPACITY = 32;
+extern SpscQueue<MotionCommand, MOTION_QUEUE_CAPACITY> motionQueue;
+extern uint32_t motionQueueDrops;
+
+bool postMotion(const MotionCommand &cmd);
+bool requestMove(const int angles[SERVO_COUNT], JointMask mask, unsigned long durationMs, bool supersedeScheduled,
+                 bool streamed = false);
+
+// Motion task: run one queued command
+void runMotionCommand(const MotionCommand &cmd);
+
+// Motion task: one control tick - drain the queue, advance sequence playback,
+// the scheduled frame and the stacks, check the stream watchdog, then
+// interpolate and write the servos
+void motionTick();
+
+// Batch collection for 6 servo commands (POST /servo); network task
+struct BatchedCommand {
+  int servoId;
+  int angle;                // centidegrees
+  unsigned long timestamp;
+  bool isSet;
+};
+
+// An incomplete batch this old is stale (the client stopped part-way) and is
+// dropped rather than executed
+static const unsigned long BATCH_TIMEOUT = 1000;
+
+extern BatchedCommand batchBuffer[SERVO_COUNT];
+extern int batchCount;
+extern bool batchReady;
+extern unsigned long batchStartTime;
+extern uint32_t batchTimeouts; // incomplete batches dropped
+
+void initializeBatch();
+// Execute the current batch; durationMs 0 moves as fast as the joint limits allow.
+// Returns false if the motion queue had no room (the batch is still cleared).
+bool executeBatch(unsigned long durationMs = 0, bool supersedeScheduled = false, bool streamed = false);
+void checkBatchTimeout();
+
+// Whole-pose frames (POST /frame, UDP stream) - all six angles land in the
+// batch at once and execute immediately, or at an optional device-clock time
+static const unsigned long MAX_FRAME_LEAD_MS = 10000;
+
+// Owned by the motion task
+struct PendingFrame {
+  int angles[SERVO_COUNT]; // centidegrees
+  JointMask mask;          // bit i set -> servo index i has an angle
+  unsigned long durationMs;
+  unsigned long applyAt;   // halMillis() deadline
+  bool active;
+};
+
+extern PendingFrame pendingFrame;
+
+bool applyFrame(const int angles[SERVO_COUNT], JointMask mask, unsigned long durationMs = 0);
+void processPendingFrame();
+
+// Stream watchdog - every /frame and UDP stream pose arms it. If the next pose
+// is more than streamDeadlineMs late (counted from the end of the current
+// pose's duration), the client is taken to have stalled: the motion task
+// freezes the arms where they are, or eases them to safePose. Sequences,
+// stacks, /servo batches and calibration disarm it, since they own the planner
+// from then on. The safe pose action suits continuous streaming; one-shot
+// /frame clients will see the arms return to it once they stop sending.
+enum StreamTimeoutAction { STREAM_TIMEOUT_HOLD, STREAM_TIMEOUT_SAFE_POSE };
+
+#ifndef ROBOT_STREAM_DEADLINE_MS
+#define ROBOT_STREAM_DEADLINE_MS 500
+#endif
+static const unsigned long MAX_STREAM_DEADLINE_MS = 10000;
+static const unsigned long SAFE_POSE_EASE_MS = 1500; // planner limits may stretch it
+
+// Tunable from the network task (POST /watchdog); deadline 0 disables
+extern volatile unsigned long streamDeadlineMs;
+extern volatile StreamTimeoutAction streamTimeoutAction;
+extern int safePose[SERVO_COUNT]; // centidegrees
+// Motion task
+extern uint32_t streamWatchdogTrips;
+extern volatile bool streamWatchdogArmed;
+
+const char* streamTimeoutActionName(StreamTimeoutAction action);
+bool parseStreamTimeoutAction(const char* name, StreamTimeoutAction* out);
+void processStreamWatchdog();
+
+// Command stacks for each servo - statically allocated FIFOs filled by
+// POST /stack on the network task and drained by the motion task
+struct ServoCommand {
+  int angle;                // centidegrees
+  unsigned long timestamp;
+};
+
+static const size_t STACK_CAPACITY = 64;
+static const unsigned long STACK_EXECUTION_INTERVAL = 50; // Execute stack every 50ms
+
+enum StackOverflowPolicy { STACK_REJECT, STACK_DROP_OLDEST };
+
+extern uint32_t stackDropped[SERVO_COUNT]; // commands lost to drop-oldest overflow
+
+bool enqueueStack(int idx, const int *angles, int count, StackOverflowPolicy policy, int *dropped);
+bool dequeueStack(int idx, ServoCommand &out, size_t *remaining);
+size_t stackDepth(int idx);
+void clearStacks();
+void processServoStacks();
+
+// Sequence timeline executor - steps are parsed once into a compact table and
+// advanced by the motion task against deadlines so the server stays
+// responsive. The network task fills the table only while no job is queued or
+// running, then hands it over with MOTION_START_SEQUENCE.
+//
+// A job may carry an absolute start time in device millis() (start_at_ms) so
+// several robots uploaded ahead of time begin in phase. The host estimates
+// each robot's clock offset with GET /time. Every step is anchored to its
+// deadline, and a job that starts late skips to the step that should be
+// playing instead of running behind the others.
+//
+// Pipelined jobs (POST /sequence.bin?pipeline=1) start as soon as their first
+// step has arrived and may be longer than the table, which then acts as a
+// lookahead ring: step n lives in slot n % MAX_SEQUENCE_STEPS. The uploader
+// publishes steps through sequenceStepsReady and may only refill a slot once
+// sequenceStepsDone shows the executor has played it; until then it waits,
+// which stops it reading the HTTP body (backpressure). If playback catches up
+// with the upload, the pose holds and the timeline resumes from the tick the
+// next step arrives.
+static const int MAX_SEQUENCE_STEPS = 512;
+static const unsigned long DEFAULT_STEP_DURATION_MS = 400;
+static const unsigned long MIN_STEP_DURATION_MS = 20;
+static const unsigned long MAX_STEP_DURATION_MS = 10000;
+static const long MAX_START_LEAD_MS = 30000; // start_at_ms must be within this of now
+static const size_t SEQUENCE_SKILL_MAX = 63;
+static const int MAX_PIPELINED_STEPS = 65535; // the binary header's step count field
+
+struct SequenceStep {
+  uint16_t angles[SERVO_COUNT]; // centidegrees by servo index, valid where mask bit is set
+  JointMask mask;               // bit i set -> servo index i is commanded in this step
+};
+
+enum SequenceState { SEQ_IDLE, SEQ_QUEUED, SEQ_SCHEDULED, SEQ_RUNNING, SEQ_COMPLETED, SEQ_ABORTED };
+
+extern SequenceStep sequenceSteps[MAX_SEQUENCE_STEPS];
+extern int sequenceLength;
+extern int sequenceCursor;            // index of the next step to play
+extern unsigned long sequenceStepMs;
+extern MotionProfile sequenceProfile;
+extern unsigned long sequenceStartTime;
+extern unsigned long sequenceNextStepAt;
+extern uint32_t sequenceJobId;
+extern volatile SequenceState sequenceState;
+extern char sequenceSkill[SEQUENCE_SKILL_MAX + 1];
+extern std::atomic<int> sequenceStepsReady; // steps written to the table; network task
+extern std::atomic<int> sequenceStepsDone;  // steps the executor is finished with; motion task
+extern uint32_t sequenceUnderruns;          // times a pipelined job waited for its next step
+
+const char* sequenceStateName(SequenceState state);
+// True while the step table belongs to a queued, scheduled or running job
+bool sequenceBusy();
+bool validStartAt(unsigned long startAt);
+uint32_t startSequence(const char *skill, int stepCount, unsigned long stepMs, MotionProfile profile,
+                       bool timedStart = false, unsigned long startAt = 0, bool pipelined = false);
+// Network task, pipelined uploads: claim the ring before writing step 0, then
+// publish each completed step; sequenceSlotFree() says whether step n may be written
+void sequencePipelineBegin();
+inline SequenceStep &sequenceSlot(int step) {
+  return sequenceSteps[step % MAX_SEQUENCE_STEPS];
+}
+inline bool sequenceSlotFree(int step) {
+  return step - sequenceStepsDone.load(std::memory_order_acquire) < MAX_SEQUENCE_STEPS;
+}
+inline void sequencePublishSteps(int ready) {
+  sequenceStepsReady.store(ready, std::memory_order_release);
+}
+bool requestSequenceAbort();
+void beginSequence(int stepCount, unsigned long stepMs, MotionProfile profile, bool timedStart, unsigned long startAt);
+bool abortSequence();
+void processSequence();
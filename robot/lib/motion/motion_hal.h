@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+
+// Everything the motion core needs from the hardware, implemented once per
+// target: src/motion_hal_esp32.cpp on the robot (millis, LEDC, a portMUX) and
+// src/native/sim_hal.cpp for the native build (virtual clock, simulated
+// servos). Keep it this small - anything else belongs in the firmware glue.
+
+// Monotonic milliseconds; callers compare with wrap-safe subtraction like millis()
+unsigned long halMillis();
+
+// Drive servo index i with a SERVO_DUTY_BITS duty at SERVO_PWM_HZ (motion task only)
+void halServoWrite(int servoIndex, uint16_t duty);
+
+// Guard the servo stacks, which the network task fills while the motion task drains them
+void halStackLock();
+void halStackUnlock();
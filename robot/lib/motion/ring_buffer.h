@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed-capacity FIFO with no heap use. Not thread-safe: callers sharing one
+// across tasks must hold a lock around each call.
+template <typename T, size_t N>
+class RingBuffer {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+ public:
+  // Returns false when full and leaves the buffer untouched
+  bool push(const T& item) {
+    if (full()) return false;
+    items_[head_++ & (N - 1)] = item;
+    return true;
+  }
+
+  // Always stores the item; returns true if the oldest entry was dropped to make room
+  bool pushOverwrite(const T& item) {
+    bool dropped = full();
+    if (dropped) tail_++;
+    items_[head_++ & (N - 1)] = item;
+    return dropped;
+  }
+
+  bool pop(T& out) {
+    if (empty()) return false;
+    out = items_[tail_++ & (N - 1)];
+    return true;
+  }
+
+  void clear() { tail_ = head_; }
+
+  size_t size() const { return head_ - tail_; }
+  size_t available() const { return N - size(); }
+  bool empty() const { return head_ == tail_; }
+  bool full() const { return size() == N; }
+  static constexpr size_t capacity() { return N; }
+
+ private:
+  T items_[N];
+  uint32_t head_ = 0;  // free-running write count
+  uint32_t tail_ = 0;  // free-running read count
+};
@@ -0,0 +1,130 @@
+#include "face_link.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+#include "logging.h"
+#include "motion_core.h"
+
+static const char *const EXPRESSION_NAMES[FACE_EXPR_COUNT] = {"happy", "talk", "surprise", "look_left",
+                                                                "look_right"};
+
+static FaceLinkStats stats = {};
+static FaceExpression expression = FACE_EXPR_HAPPY;
+static FaceEventHandler eventHandler = nullptr;
+
+// Receive state: bytes of the frame collected so far, after the sync byte
+static uint8_t rxFrame[3];
+static uint8_t rxLen = 0;
+static bool rxSynced = false;
+
+// Playback as last seen by faceLinkPoll()
+static SequenceState seenState = SEQ_IDLE;
+static int seenCursor = -1;
+
+void faceLinkBegin() {
+  Serial2.begin(FACE_LINK_BAUD, SERIAL_8N1, FACE_LINK_RX_PIN, FACE_LINK_TX_PIN);
+  faceLinkSend(FACE_OP_EXPRESSION, expression);
+  LOGI("✅ Face link on Serial2 (TX %d, RX %d) at %lu baud", FACE_LINK_TX_PIN, FACE_LINK_RX_PIN,
+       (unsigned long)FACE_LINK_BAUD);
+}
+
+void faceLinkSetEventHandler(FaceEventHandler handler) {
+  eventHandler = handler;
+}
+
+void faceLinkSend(uint8_t op, uint8_t arg) {
+  uint8_t frame[4] = {FACE_LINK_SYNC, op, arg, (uint8_t)(op ^ arg ^ FACE_LINK_SYNC)};
+  Serial2.write(frame, sizeof(frame));
+  stats.framesSent++;
+}
+
+void faceLinkSetExpression(FaceExpression e) {
+  expression = e;
+  faceLinkSend(FACE_OP_EXPRESSION, e);
+}
+
+static void handleFrame(uint8_t op, uint8_t arg) {
+  switch (op) {
+    case FACE_EVT_READY:
+      if (!stats.faceSeen) LOGI("🐵 Face display is up");
+      stats.faceSeen = true;
+      faceLinkSend(FACE_OP_EXPRESSION, expression);
+      break;
+    case FACE_EVT_TAP:
+    case FACE_EVT_HOLD:
+      if (eventHandler) eventHandler(op, arg);
+      break;
+    default:
+      LOGD("Face link: unknown event 0x%02x", op);
+      break;
+  }
+}
+
+static void readFrames() {
+  int avail = Serial2.available();
+  while (avail-- > 0) {
+    uint8_t b = (uint8_t)Serial2.read();
+    if (!rxSynced) {
+      rxSynced = b == FACE_LINK_SYNC;
+      rxLen = 0;
+      continue;
+    }
+    rxFrame[rxLen++] = b;
+    if (rxLen < sizeof(rxFrame)) continue;
+    rxSynced = false;
+    if ((rxFrame[0] ^ rxFrame[1] ^ FACE_LINK_SYNC) != rxFrame[2]) {
+      stats.badFrames++;
+      continue;
+    }
+    stats.framesReceived++;
+    handleFrame(rxFrame[0], rxFrame[1]);
+  }
+}
+
+// Polled every network loop (about 1 ms), so each keyframe reaches the face
+// well within one of its 40 ms animation frames
+static void followSequence() {
+  SequenceState state = sequenceState;
+  int cursor = sequenceCursor;
+  if (state != seenState) {
+    if (state == SEQ_RUNNING) {
+      faceLinkSetExpression(FACE_EXPR_TALK);
+    } else if (state == SEQ_COMPLETED) {
+      faceLinkSetExpression(FACE_EXPR_HAPPY);
+    } else if (state == SEQ_ABORTED) {
+      faceLinkSetExpression(FACE_EXPR_HAPPY);
+      faceLinkSend(FACE_OP_REACT, FACE_EXPR_SURPRISE);
+    }
+    seenState = state;
+    seenCursor = -1;
+  }
+  if (state == SEQ_RUNNING && cursor != seenCursor) {
+    faceLinkSend(FACE_OP_STEP, (uint8_t)cursor);
+    seenCursor = cursor;
+  }
+}
+
+void faceLinkPoll() {
+  readFrames();
+  followSequence();
+}
+
+bool parseFaceExpression(const char *name, FaceExpression *out) {
+  if (!name) return false;
+  for (int i = 0; i < FACE_EXPR_COUNT; ++i) {
+    if (strcmp(name, EXPRESSION_NAMES[i]) == 0) {
+      *out = (FaceExpression)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+const char *faceExpressionName(FaceExpression e) {
+  return e < FACE_EXPR_COUNT ? EXPRESSION_NAMES[e] : "unknown";
+}
+
+FaceLinkStats faceLinkStats() {
+  return stats;
+}
@@ -0,0 +1,197 @@
+#include "feedback.h"
+
+#if ROBOT_FEEDBACK
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include <math.h>
+
+#include "logging.h"
+#include "motion_core.h"
+#include "spsc_queue.h"
+
+// At 20 kHz two bytes per conversion arrive at 40 KB/s, 800 bytes a tick; the
+// driver buffer covers about 50 ms of a late tick before it overruns
+static const uint32_t DMA_BUFFER_BYTES = 2048;
+static const uint32_t DMA_FRAME_BYTES = 256;
+static const int MAX_READS_PER_TICK = 16; // bounds the drain if the driver misbehaves
+
+static FeedbackStats stats = {};
+static SpscQueue<FeedbackSnapshot, 4> snapshots; // motion task -> network task
+
+// Motion task state
+static int8_t channelOfAdc[8];                     // ADC1 channel -> FEEDBACK_CHANNELS row, or -1
+static int32_t rawValue[FEEDBACK_CHANNEL_COUNT];   // last per-tick average, -1 before the first
+static unsigned long stallSince[SERVO_COUNT];      // 0 while within tolerance
+static unsigned long overSince[FEEDBACK_CHANNEL_COUNT];
+static JointMask stalled = 0;
+static JointMask overcurrent = 0;
+
+bool feedbackBegin() {
+  uint32_t adcMask = 0;
+  adc_digi_pattern_config_t pattern[FEEDBACK_CHANNEL_COUNT] = {};
+  for (int i = 0; i < 8; ++i) channelOfAdc[i] = -1;
+  for (int c = 0; c < FEEDBACK_CHANNEL_COUNT; ++c) {
+    int ch = feedbackAdcChannel(FEEDBACK_CHANNELS[c].gpio);
+    channelOfAdc[ch] = (int8_t)c;
+    adcMask |= 1u << ch;
+    pattern[c].atten = ADC_ATTEN_DB_11;
+    pattern[c].channel = (uint8_t)ch;
+    pattern[c].unit = 0; // ADC1
+    pattern[c].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    rawValue[c] = -1;
+  }
+
+  adc_digi_init_config_t init = {};
+  init.max_store_buf_size = DMA_BUFFER_BYTES;
+  init.conv_num_each_intr = DMA_FRAME_BYTES;
+  init.adc1_chan_mask = adcMask;
+  init.adc2_chan_mask = 0;
+  if (adc_digi_initialize(&init) != ESP_OK) {
+    LOGE("❌ Feedback ADC: driver init failed");
+    return false;
+  }
+
+  adc_digi_configuration_t cfg = {};
+  cfg.conv_limit_en = true; // required on the ESP32
+  cfg.conv_limit_num = 250;
+  cfg.pattern_num = FEEDBACK_CHANNEL_COUNT;
+  cfg.adc_pattern = pattern;
+  cfg.sample_freq_hz = FEEDBACK_SAMPLE_HZ;
+  cfg.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  cfg.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+  if (adc_digi_controller_configure(&cfg) != ESP_OK || adc_digi_start() != ESP_OK) {
+    adc_digi_deinitialize();
+    LOGE("❌ Feedback ADC: continuous mode failed to start");
+    return false;
+  }
+  stats.running = true;
+  LOGI("✅ Feedback ADC: %d channels at %lu Hz", FEEDBACK_CHANNEL_COUNT, (unsigned long)FEEDBACK_SAMPLE_HZ);
+  return true;
+}
+
+// Average every conversion that arrived since the last tick, per channel
+static void drainSamples() {
+  uint8_t buf[DMA_FRAME_BYTES];
+  uint32_t sum[FEEDBACK_CHANNEL_COUNT] = {0};
+  uint16_t count[FEEDBACK_CHANNEL_COUNT] = {0};
+  for (int r = 0; r < MAX_READS_PER_TICK; ++r) {
+    uint32_t got = 0;
+    esp_err_t err = adc_digi_read_bytes(buf, sizeof(buf), &got, 0);
+    if (err == ESP_ERR_INVALID_STATE) {
+      stats.overruns++; // data is still returned; older samples were lost
+    } else if (err != ESP_OK) {
+      break; // ESP_ERR_TIMEOUT: drained
+    }
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= got; i += SOC_ADC_DIGI_RESULT_BYTES) {
+      const adc_digi_output_data_t *out = (const adc_digi_output_data_t *)&buf[i];
+      if (out->type1.channel >= 8) continue;
+      int c = channelOfAdc[out->type1.channel];
+      if (c < 0) continue;
+      sum[c] += out->type1.data;
+      count[c]++;
+    }
+    if (got < sizeof(buf)) break;
+  }
+  for (int c = 0; c < FEEDBACK_CHANNEL_COUNT; ++c) {
+    if (count[c] == 0) continue; // keep the previous average
+    rawValue[c] = (int32_t)((sum[c] + count[c] / 2) / count[c]);
+    stats.samples += count[c];
+  }
+}
+
+static int32_t scaled(int c) {
+  const FeedbackChannel &ch = FEEDBACK_CHANNELS[c];
+  return (int32_t)lroundf((rawValue[c] - ch.zero) * ch.scale);
+}
+
+static uint16_t clampU16(int32_t v, int32_t hi) {
+  return (uint16_t)(v < 0 ? 0 : (v > hi ? hi : v));
+}
+
+void feedbackTick() {
+  if (!stats.running) return;
+  drainSamples();
+  unsigned long now = millis();
+
+  FeedbackSnapshot snap;
+  snap.tick = stats.ticks++;
+  snap.atMs = now;
+  snap.sensed = 0;
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    snap.commanded[i] = clampU16((int32_t)lroundf(joints[i].position * CDEG_PER_DEG), MAX_ANGLE_CDEG);
+    snap.measured[i] = FEEDBACK_NONE;
+    snap.currentMa[i] = FEEDBACK_NONE;
+  }
+
+  JointMask nowStalled = 0;
+  JointMask nowOver = 0;
+  for (int c = 0; c < FEEDBACK_CHANNEL_COUNT; ++c) {
+    if (rawValue[c] < 0) continue;
+    const FeedbackChannel &ch = FEEDBACK_CHANNELS[c];
+    int32_t value = scaled(c);
+    if (ch.kind == FEEDBACK_POSITION) {
+      int i = __builtin_ctz(ch.joints);
+      snap.measured[i] = clampU16(value, MAX_ANGLE_CDEG);
+      snap.sensed |= ch.joints;
+      // The servo lags the planner by its own response time, so only a
+      // sustained error counts
+      int32_t error = (int32_t)snap.measured[i] - (int32_t)snap.commanded[i];
+      if (error < 0) error = -error;
+      if (error <= FEEDBACK_STALL_ERROR_CDEG) {
+        stallSince[i] = 0;
+      } else if (stallSince[i] == 0) {
+        stallSince[i] = now;
+      } else if (now - stallSince[i] >= FEEDBACK_STALL_MS) {
+        nowStalled |= ch.joints;
+      }
+    } else {
+      uint16_t ma = clampU16(value, 0xFFFE);
+      for (int i = 0; i < SERVO_COUNT; ++i) {
+        if (ch.joints & (1 << i)) snap.currentMa[i] = ma;
+      }
+      if (value <= FEEDBACK_STALL_MA) {
+        overSince[c] = 0;
+      } else if (overSince[c] == 0) {
+        overSince[c] = now;
+      } else if (now - overSince[c] >= FEEDBACK_STALL_MS) {
+        nowOver |= ch.joints;
+      }
+    }
+  }
+
+  // Count and log onsets only; a joint stays flagged while the condition lasts
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    JointMask bit = (JointMask)(1 << i);
+    if ((nowStalled & bit) && !(stalled & bit)) {
+      stats.stalls++;
+      LOGW("🧱 Joint %d (%s) stalled: at %.1f°, commanded %.1f°", i + 1, JOINTS[i].name,
+           snap.measured[i] / (float)CDEG_PER_DEG, snap.commanded[i] / (float)CDEG_PER_DEG);
+    }
+  }
+  for (int c = 0; c < FEEDBACK_CHANNEL_COUNT; ++c) {
+    const FeedbackChannel &ch = FEEDBACK_CHANNELS[c];
+    if (ch.kind == FEEDBACK_CURRENT && (nowOver & ch.joints) && !(overcurrent & ch.joints)) {
+      stats.overcurrents++;
+      LOGW("🔥 Supply on GPIO%d over %d mA (%ld mA)", ch.gpio, FEEDBACK_STALL_MA, (long)scaled(c));
+    }
+  }
+  stalled = nowStalled;
+  overcurrent = nowOver;
+  snap.stalled = stalled;
+  snap.overcurrent = overcurrent;
+
+  if (!snapshots.push(snap)) stats.snapshotDrops++;
+}
+
+bool feedbackTakeSnapshot(FeedbackSnapshot *out) {
+  bool any = false;
+  while (snapshots.pop(*out)) any = true;
+  return any;
+}
+
+FeedbackStats feedbackStats() {
+  return stats;
+}
+
+#endif // ROBOT_FEEDBACK
@@ -0,0 +1,231 @@
+#include "json_stream.h"
+
+#include <string.h>
+
+static bool isJsonSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool isNumberChar(char c) {
+  return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+void JsonStreamParser::reset() {
+  error_ = nullptr;
+  offset_ = 0;
+  depth_ = 0;
+  expect_ = EXPECT_VALUE;
+  lex_ = LEX_NONE;
+  stringIsKey_ = false;
+  unicodeDigits_ = 0;
+  unicode_ = 0;
+  tokenLen_ = 0;
+  token_[0] = '\0';
+}
+
+bool JsonStreamParser::fail(const char* message) {
+  if (!error_) error_ = message;
+  return false;
+}
+
+void JsonStreamParser::appendToken(char c) {
+  if (tokenLen_ < MAX_TOKEN) token_[tokenLen_++] = c;
+}
+
+void JsonStreamParser::appendUtf8(uint32_t cp) {
+  if (cp < 0x80) {
+    appendToken((char)cp);
+  } else if (cp < 0x800) {
+    appendToken((char)(0xC0 | (cp >> 6)));
+    appendToken((char)(0x80 | (cp & 0x3F)));
+  } else {
+    appendToken((char)(0xE0 | (cp >> 12)));
+    appendToken((char)(0x80 | ((cp >> 6) & 0x3F)));
+    appendToken((char)(0x80 | (cp & 0x3F)));
+  }
+}
+
+// A scalar or container close just finished; work out what may follow it
+void JsonStreamParser::valueDone() {
+  expect_ = depth_ == 0 ? EXPECT_DONE : EXPECT_COMMA_OR_END;
+}
+
+bool JsonStreamParser::endToken(JsonStreamEvent event) {
+  token_[tokenLen_] = '\0';
+  lex_ = LEX_NONE;
+  bool ok = handler_.onJsonEvent(event, token_, tokenLen_);
+  tokenLen_ = 0;
+  if (!ok) return fail("Rejected by handler");
+  if (event == JSON_KEY) {
+    expect_ = EXPECT_COLON;
+  } else {
+    valueDone();
+  }
+  return true;
+}
+
+bool JsonStreamParser::startValue(char c) {
+  if (c == '{' || c == '[') {
+    if (depth_ == MAX_DEPTH) return fail("Nesting too deep");
+    stack_[depth_++] = c;
+    expect_ = c == '{' ? EXPECT_KEY_OR_END : EXPECT_VALUE_OR_END;
+    if (!handler_.onJsonEvent(c == '{' ? JSON_OBJECT_START : JSON_ARRAY_START, "", 0)) {
+      return fail("Rejected by handler");
+    }
+    return true;
+  }
+  if (c == '"') {
+    lex_ = LEX_STRING;
+    stringIsKey_ = false;
+    return true;
+  }
+  if (c == '-' || (c >= '0' && c <= '9')) {
+    lex_ = LEX_NUMBER;
+    appendToken(c);
+    return true;
+  }
+  if (c == 't' || c == 'f' || c == 'n') {
+    lex_ = LEX_LITERAL;
+    appendToken(c);
+    return true;
+  }
+  return fail("Unexpected character");
+}
+
+bool JsonStreamParser::step(char c) {
+  switch (lex_) {
+    case LEX_STRING:
+      if (c == '"') return endToken(stringIsKey_ ? JSON_KEY : JSON_STRING);
+      if (c == '\\') {
+        lex_ = LEX_ESCAPE;
+      } else if ((uint8_t)c < 0x20) {
+        return fail("Control character in string");
+      } else {
+        appendToken(c);
+      }
+      return true;
+
+    case LEX_ESCAPE:
+      lex_ = LEX_STRING;
+      switch (c) {
+        case '"': case '\\': case '/': appendToken(c); return true;
+        case 'b': appendToken('\b'); return true;
+        case 'f': appendToken('\f'); return true;
+        case 'n': appendToken('\n'); return true;
+        case 'r': appendToken('\r'); return true;
+        case 't': appendToken('\t'); return true;
+        case 'u':
+          lex_ = LEX_UNICODE;
+          unicodeDigits_ = 0;
+          unicode_ = 0;
+          return true;
+        default:
+          return fail("Bad escape");
+      }
+
+    case LEX_UNICODE: {
+      int v = hexValue(c);
+      if (v < 0) return fail("Bad \\u escape");
+      unicode_ = (unicode_ << 4) | (uint32_t)v;
+      if (++unicodeDigits_ == 4) {
+        // Surrogate halves are not paired up; they decode as '?'
+        appendUtf8(unicode_ >= 0xD800 && unicode_ <= 0xDFFF ? '?' : unicode_);
+        lex_ = LEX_STRING;
+      }
+      return true;
+    }
+
+    case LEX_NUMBER:
+      if (isNumberChar(c)) {
+        if (tokenLen_ == MAX_TOKEN) return fail("Number too long");
+        appendToken(c);
+        return true;
+      }
+      if (!endToken(JSON_NUMBER)) return false;
+      break;  // c is the delimiter; handle it below
+
+    case LEX_LITERAL:
+      if (c >= 'a' && c <= 'z') {
+        if (tokenLen_ == 5) return fail("Bad literal");
+        appendToken(c);
+        return true;
+      }
+      token_[tokenLen_] = '\0';
+      if (strcmp(token_, "true") != 0 && strcmp(token_, "false") != 0 && strcmp(token_, "null") != 0) {
+        return fail("Bad literal");
+      }
+      if (!endToken(JSON_LITERAL)) return false;
+      break;
+
+    case LEX_NONE:
+      break;
+  }
+
+  if (isJsonSpace(c)) return true;
+
+  switch (expect_) {
+    case EXPECT_VALUE_OR_END:
+      if (c == ']') break;
+      // fall through
+    case EXPECT_VALUE:
+      return startValue(c);
+
+    case EXPECT_KEY_OR_END:
+      if (c == '}') break;
+      // fall through
+    case EXPECT_KEY:
+      if (c != '"') return fail("Expected key");
+      lex_ = LEX_STRING;
+      stringIsKey_ = true;
+      return true;
+
+    case EXPECT_COLON:
+      if (c != ':') return fail("Expected ':'");
+      expect_ = EXPECT_VALUE;
+      return true;
+
+    case EXPECT_COMMA_OR_END:
+      if (c == ',') {
+        expect_ = inObject() ? EXPECT_KEY : EXPECT_VALUE;
+        return true;
+      }
+      if (c == '}' || c == ']') break;
+      return fail("Expected ',' or closing bracket");
+
+    case EXPECT_DONE:
+      return fail("Trailing data");
+  }
+
+  // Closing a container
+  if ((c == '}') != inObject()) return fail("Mismatched bracket");
+  depth_--;
+  if (!handler_.onJsonEvent(c == '}' ? JSON_OBJECT_END : JSON_ARRAY_END, "", 0)) {
+    return fail("Rejected by handler");
+  }
+  valueDone();
+  return true;
+}
+
+bool JsonStreamParser::feed(const uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len && !error_; ++i) {
+    offset_++;
+    step((char)data[i]);
+  }
+  return !error_;
+}
+
+bool JsonStreamParser::finish() {
+  if (error_) return false;
+  // A bare top-level number or literal has no delimiter after it
+  if (lex_ == LEX_NUMBER || lex_ == LEX_LITERAL) step(' ');
+  if (error_) return false;
+  if (expect_ != EXPECT_DONE || lex_ != LEX_NONE) return fail("Incomplete document");
+  return true;
+}
@@ -0,0 +1,86 @@
+#include "logging.h"
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+static const size_t LOG_LINE_MAX = 192;
+static uint32_t droppedLines = 0;
+
+static char levelChar(int level) {
+  switch (level) {
+    case ROBOT_LOG_LEVEL_ERROR: return 'E';
+    case ROBOT_LOG_LEVEL_WARN: return 'W';
+    case ROBOT_LOG_LEVEL_INFO: return 'I';
+    default: return 'D';
+  }
+}
+
+#if ROBOT_LOG_RING
+static char logRing[ROBOT_LOG_RING_SIZE];
+static size_t ringHead = 0;   // next write position
+static bool ringWrapped = false;
+static portMUX_TYPE ringLock = portMUX_INITIALIZER_UNLOCKED; // request and motion tasks both log
+
+static void ringWrite(const char* line, size_t len) {
+  portENTER_CRITICAL(&ringLock);
+  for (size_t i = 0; i < len; ++i) {
+    logRing[ringHead++] = line[i];
+    if (ringHead == ROBOT_LOG_RING_SIZE) {
+      ringHead = 0;
+      ringWrapped = true;
+    }
+  }
+  portEXIT_CRITICAL(&ringLock);
+}
+
+// Spans point into the live ring, so lines logged while the caller sends them
+// may show up torn at the oldest end
+void logRingSnapshot(const char** first, size_t* firstLen, const char** second, size_t* secondLen) {
+  portENTER_CRITICAL(&ringLock);
+  if (ringWrapped) {
+    *first = logRing + ringHead;
+    *firstLen = ROBOT_LOG_RING_SIZE - ringHead;
+    *second = logRing;
+    *secondLen = ringHead;
+  } else {
+    *first = logRing;
+    *firstLen = ringHead;
+    *second = logRing;
+    *secondLen = 0;
+  }
+  portEXIT_CRITICAL(&ringLock);
+}
+#endif
+
+void logPrintf(int level, const char* fmt, ...) {
+  char line[LOG_LINE_MAX];
+  int prefix = snprintf(line, sizeof(line), "[%lu] %c ", millis(), levelChar(level));
+
+  va_list args;
+  va_start(args, fmt);
+  int body = vsnprintf(line + prefix, sizeof(line) - prefix - 1, fmt, args);
+  va_end(args);
+
+  size_t len = prefix + (body < 0 ? 0 : body);
+  if (len > sizeof(line) - 2) len = sizeof(line) - 2; // truncated; keep room for the newline
+  line[len++] = '\n';
+  line[len] = '\0';
+
+#if ROBOT_LOG_RING
+  ringWrite(line, len);
+  if (level != ROBOT_LOG_LEVEL_ERROR) return;
+#endif
+
+  // Errors always reach the UART; everything else is dropped rather than
+  // stalling the caller when the TX buffer can't take the whole line
+  if (level != ROBOT_LOG_LEVEL_ERROR && Serial.availableForWrite() < (int)len) {
+    droppedLines++;
+    return;
+  }
+  Serial.write((const uint8_t*)line, len);
+}
+
+uint32_t logDroppedCount() {
+  return droppedLines;
+}
@@ -1,173 +1,298 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <WebServer.h>
-#include <ESP32Servo.h>
+#include <WiFiUdp.h>
 #include <ArduinoJson.h>
-#include <queue>
+#include <esp_system.h>
+#include <esp_task_wdt.h>
+#include <esp_timer.h>
+#include <uri/UriBraces.h>
+
+#include "face_link.h"
+#include "feedback.h"
+#include "json_stream.h"
+#include "logging.h"
+#include "metrics.h"
+#include "motion_core.h"
+#include "motion_hal_esp32.h"
+#include "request_arena.h"
+#include "skill_cache.h"
+#include "wifi_cache.h"
 
 // WiFi credentials (provided)
 const char* WIFI_SSID = "HackTheNorth";
 const char* WIFI_PASS = "HTN2025!";
 
+// ROBOT_FAST_BOOT=1 (the default) gets from power-on to serving as quickly as
+// possible: no serial countdown or banner, servos up in one pass, and WiFi
+// connects in the background from the NVS cache (include/wifi_cache.h)
+// while the rest of setup() runs. 0 keeps the verbose, blocking boot.
+#ifndef ROBOT_FAST_BOOT
+#define ROBOT_FAST_BOOT 1
+#endif
+static const bool FAST_BOOT = ROBOT_FAST_BOOT != 0;
+
 // Heartbeat LED (on many ESP32 boards GPIO2 has onboard LED; adjust if needed)
 const int LED_PIN = 2;
 
-// Servo configuration
-static const int SERVO_COUNT = 6; // 0-2 left arm, 3-5 right arm
-int SERVO_PINS[SERVO_COUNT] = {13, 14, 12, 27, 26, 25};
-Servo servos[SERVO_COUNT];
-int currentAngles[SERVO_COUNT];
-
-// Servo command structure
-struct ServoCommand {
-  int angle;
-  unsigned long timestamp;
-};
+// Joints, servo output, planner, stacks, batch buffer and the sequence
+// executor live in lib/motion (motion_core.h); this file is the WiFi, HTTP
+// and UDP glue around them plus the two tasks that drive it
+
+// JSON angle in degrees (integer or fractional) -> centidegrees, or -1 if
+// missing or outside 0-180
+int jsonAngleCdeg(JsonVariant v) {
+  if (!v.is<float>()) return -1;
+  float deg = v.as<float>();
+  if (!(deg >= 0.0f && deg <= 180.0f)) return -1;
+  return (int)lroundf(deg * CDEG_PER_DEG);
+}
 
-// Batch collection structure
-struct BatchedCommand {
-  int servoId;
-  int angle;
-  unsigned long timestamp;
-  bool isSet;
+// UDP pose streaming for teleoperation - one fixed-size datagram per pose,
+// fed through the same batch path as /frame without any HTTP overhead.
+//
+// Packets (little-endian), both with a sequence number at [2..5]:
+//   'P','S' (12 bytes): [6..11] degrees for servo ids 1-6 (0-180, or 0xFF to hold)
+//   'P','C' (18 bytes): [6..17] u16 centidegrees for servo ids 1-6 (0-18000, or 0xFFFF to hold)
+//   'S','A' (2 bytes): abort the running sequence, like POST /sequence/abort;
+//     still heard while a pipelined upload holds the HTTP server
+static const uint16_t STREAM_UDP_PORT = 4210;
+static const size_t STREAM_PACKET_SIZE = 6 + SERVO_COUNT;
+static const size_t STREAM_PACKET_CDEG_SIZE = 6 + 2 * SERVO_COUNT;
+static const uint8_t STREAM_HOLD = 0xFF;
+static const uint16_t STREAM_HOLD_CDEG = 0xFFFF;
+static const unsigned long STREAM_RESYNC_MS = 1000; // accept any sequence number after this much silence
+
+WiFiUDP streamUdp;
+
+struct StreamStats {
+  uint32_t lastSeq;
+  unsigned long lastPacketAt;
+  bool synced;            // false until the first packet (or after a resync gap)
+  uint32_t received;
+  uint32_t applied;
+  uint32_t droppedStale;
+  uint32_t droppedMalformed;
+  uint32_t droppedBusy;   // motion queue was full
 };
 
-// Batch collection for 6 servo commands
-BatchedCommand batchBuffer[SERVO_COUNT];
-int batchCount = 0;
-bool batchReady = false;
-unsigned long batchStartTime = 0;
-const unsigned long BATCH_TIMEOUT = 1000; // 1 second timeout to auto-execute incomplete batches
-
-// Command stacks for each servo (using std::queue as a stack)
-std::queue<ServoCommand> servoStacks[SERVO_COUNT];
-
-// Servo ID mapping for numeric commands (1-6 instead of names)
-struct ServoMapping {
-  int id;        // Numeric ID (1-6)
-  int index;     // Array index (0-5)
-  const char* name; // Description for debugging
+StreamStats streamStats = {0, 0, false, 0, 0, 0, 0, 0};
+
+#if ROBOT_FEEDBACK
+// Telemetry on the same port - a host sends the 2-byte 'T','S' to subscribe
+// and gets one 'T','F' datagram per control tick until TELEMETRY_LEASE_MS
+// after its latest subscribe, so it renews every few seconds. One subscriber
+// at a time; the newest one wins. Little-endian:
+//   [2..5] tick, [6..9] device millis(), [10] sensed mask, [11] stalled mask,
+//   [12] overcurrent mask, [13] reserved, then per servo id 1-6: u16
+//   commanded centidegrees, u16 measured centidegrees, u16 supply mA
+//   (0xFFFF where not sensed)
+static const size_t TELEMETRY_PACKET_SIZE = 14 + 6 * SERVO_COUNT;
+static const unsigned long TELEMETRY_LEASE_MS = 5000;
+
+struct TelemetrySubscriber {
+  IPAddress ip;
+  uint16_t port;
+  unsigned long renewedAt;
+  bool active;
+  uint32_t sent;
 };
 
-static const ServoMapping SERVO_MAP[] = {
-  {1,0,"left_shoulder_vertical"},
-  {2,1,"left_shoulder_horizontal"},
-  {3,2,"left_elbow_vertical"},
-  {4,3,"right_shoulder_vertical"},
-  {5,4,"right_shoulder_horizontal"},
-  {6,5,"right_elbow_vertical"}
-};
-static const int SERVO_MAP_SIZE = sizeof(SERVO_MAP)/sizeof(ServoMapping);
+TelemetrySubscriber telemetrySub = {};
+FeedbackSnapshot latestFeedback = {};
+bool haveFeedback = false;
 
-// Function to get servo index from numeric ID (1-6)
-int getServoIndex(int numericId) {
-  for(int i=0;i<SERVO_MAP_SIZE;++i) {
-    if(SERVO_MAP[i].id==numericId) return SERVO_MAP[i].index;
+void subscribeTelemetry() {
+  IPAddress ip = streamUdp.remoteIP();
+  uint16_t port = streamUdp.remotePort();
+  if (!telemetrySub.active || ip != telemetrySub.ip || port != telemetrySub.port) {
+    LOGI("📈 Telemetry to %s:%u", ip.toString().c_str(), port);
+    telemetrySub.sent = 0;
   }
-  return -1;
+  telemetrySub.ip = ip;
+  telemetrySub.port = port;
+  telemetrySub.renewedAt = millis();
+  telemetrySub.active = true;
 }
 
-const char* getServoName(int numericId) {
-  for(int i=0;i<SERVO_MAP_SIZE;++i) {
-    if(SERVO_MAP[i].id==numericId) return SERVO_MAP[i].name;
-  }
-  return "unknown";
+static void putU16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
 }
 
-// Function to invert angle for servo on pin 12 (index 2 - left_elbow_vertical)
-int adjustAngleForServo(int servoIndex, int angle) {
-  // Invert angle for servo at index 2 (pin 12)
-  if (servoIndex == 2) {
-    return 180 - angle;
-  }
-  return angle;
+static void putU32(uint8_t *p, uint32_t v) {
+  putU16(p, (uint16_t)v);
+  putU16(p + 2, (uint16_t)(v >> 16));
 }
 
-// Initialize batch buffer
-void initializeBatch() {
+// Network task: forward the newest feedback snapshot to the subscriber
+void sendTelemetry() {
+  if (!feedbackTakeSnapshot(&latestFeedback)) return;
+  haveFeedback = true;
+  if (!telemetrySub.active) return;
+  if (millis() - telemetrySub.renewedAt >= TELEMETRY_LEASE_MS) {
+    telemetrySub.active = false;
+    LOGI("📈 Telemetry lease expired after %u datagrams", (unsigned)telemetrySub.sent);
+    return;
+  }
+
+  const FeedbackSnapshot &s = latestFeedback;
+  uint8_t packet[TELEMETRY_PACKET_SIZE];
+  packet[0] = 'T';
+  packet[1] = 'F';
+  putU32(packet + 2, s.tick);
+  putU32(packet + 6, s.atMs);
+  packet[10] = s.sensed;
+  packet[11] = s.stalled;
+  packet[12] = s.overcurrent;
+  packet[13] = 0;
   for (int i = 0; i < SERVO_COUNT; ++i) {
-    batchBuffer[i].servoId = i + 1;
-    batchBuffer[i].angle = 90; // default angle
-    batchBuffer[i].timestamp = 0;
-    batchBuffer[i].isSet = false;
+    uint8_t *p = packet + 14 + 6 * i;
+    putU16(p, s.commanded[i]);
+    putU16(p + 2, s.measured[i]);
+    putU16(p + 4, s.currentMa[i]);
   }
-  batchCount = 0;
-  batchReady = false;
-  batchStartTime = millis();
+  streamUdp.beginPacket(telemetrySub.ip, telemetrySub.port);
+  streamUdp.write(packet, sizeof(packet));
+  if (streamUdp.endPacket()) telemetrySub.sent++;
 }
+#endif
+
+// Drain pending datagrams and apply only the newest valid pose; runs on the network task
+void processStream() {
+  uint8_t packet[STREAM_PACKET_CDEG_SIZE];
+  uint8_t latest[STREAM_PACKET_CDEG_SIZE];
+  bool haveLatest = false;
+
+  int size;
+  while ((size = streamUdp.parsePacket()) > 0) {
+    streamStats.received++;
+    if (size == 2) {
+      bool known = streamUdp.read(packet, 2) == 2;
+      if (known && packet[0] == 'S' && packet[1] == 'A') {
+        LOGI("📡 UDP sequence abort from %s", streamUdp.remoteIP().toString().c_str());
+        requestSequenceAbort();
+#if ROBOT_FEEDBACK
+      } else if (known && packet[0] == 'T' && packet[1] == 'S') {
+        subscribeTelemetry();
+#endif
+      } else {
+        streamStats.droppedMalformed++;
+      }
+      continue;
+    }
+    bool valid = (size == (int)STREAM_PACKET_SIZE || size == (int)STREAM_PACKET_CDEG_SIZE) &&
+                 streamUdp.read(packet, size) == size && packet[0] == 'P' &&
+                 (packet[1] == 'S' ? size == (int)STREAM_PACKET_SIZE
+                                   : packet[1] == 'C' && size == (int)STREAM_PACKET_CDEG_SIZE);
+    if (!valid) {
+      streamStats.droppedMalformed++;
+      continue;
+    }
+
+    uint32_t seq = (uint32_t)packet[2] | ((uint32_t)packet[3] << 8) |
+                   ((uint32_t)packet[4] << 16) | ((uint32_t)packet[5] << 24);
+    unsigned long now = millis();
+    if (streamStats.synced && now - streamStats.lastPacketAt >= STREAM_RESYNC_MS) {
+      streamStats.synced = false; // sender probably restarted its counter
+    }
+    // Wrap-safe comparison: anything not strictly newer is stale or duplicated
+    if (streamStats.synced && (int32_t)(seq - streamStats.lastSeq) <= 0) {
+      streamStats.droppedStale++;
+      continue;
+    }
 
-// Execute the current batch
-void executeBatch() {
-  if (batchCount == 0) return;
+    streamStats.synced = true;
+    streamStats.lastSeq = seq;
+    streamStats.lastPacketAt = now;
+    memcpy(latest, packet, size);
+    haveLatest = true;
+  }
 
-  Serial.println("🚀 Executing batch of " + String(batchCount) + " servo commands simultaneously:");
+  if (!haveLatest) return;
 
-  // Execute all commands in the batch at the same time
+  bool centidegrees = latest[1] == 'C';
+  int angles[SERVO_COUNT];
+  JointMask mask = 0;
   for (int i = 0; i < SERVO_COUNT; ++i) {
-    if (batchBuffer[i].isSet) {
-      int idx = getServoIndex(batchBuffer[i].servoId);
-      if (idx >= 0) {
-        int adjustedAngle = adjustAngleForServo(idx, batchBuffer[i].angle);
-        servos[idx].write(adjustedAngle);
-        currentAngles[idx] = batchBuffer[i].angle; // Store original angle for status
-
-        Serial.print("  ⚡ Servo ");
-        Serial.print(batchBuffer[i].servoId);
-        Serial.print(" (");
-        Serial.print(getServoName(batchBuffer[i].servoId));
-        Serial.print(") -> ");
-        Serial.print(batchBuffer[i].angle);
-        if (idx == 2) { // Show inverted angle for pin 12
-          Serial.print("° (inverted to ");
-          Serial.print(adjustedAngle);
-          Serial.print("°)");
-        } else {
-          Serial.print("°");
-        }
-        Serial.println();
-      }
+    int cdeg;
+    if (centidegrees) {
+      uint16_t v = (uint16_t)(latest[6 + 2 * i] | (latest[7 + 2 * i] << 8));
+      if (v == STREAM_HOLD_CDEG) continue;
+      cdeg = v;
+    } else {
+      if (latest[6 + i] == STREAM_HOLD) continue;
+      cdeg = latest[6 + i] * CDEG_PER_DEG;
+    }
+    if (cdeg > MAX_ANGLE_CDEG) {
+      streamStats.droppedMalformed++;
+      return;
     }
+    angles[i] = cdeg;
+    mask |= (1 << i);
+  }
+  // Live stream supersedes any scheduled /frame
+  if (applyFrame(angles, mask)) {
+    streamStats.applied++;
+  } else {
+    streamStats.droppedBusy++;
   }
-
-  Serial.println("✅ Batch execution complete!");
-
-  // Reset batch
-  initializeBatch();
 }
 
-// Check if batch should be auto-executed due to timeout
-void checkBatchTimeout() {
-  if (batchCount > 0 && (millis() - batchStartTime) >= BATCH_TIMEOUT) {
-    Serial.println("⏰ Batch timeout reached - executing incomplete batch");
-    executeBatch();
+void fillSequenceStatus(JsonDocument &doc) {
+  doc["job_id"] = sequenceJobId;
+  doc["state"] = sequenceStateName(sequenceState);
+  doc["skill"] = sequenceSkill;
+  doc["steps"] = sequenceLength;
+  doc["steps_executed"] = sequenceCursor;
+  doc["steps_received"] = sequenceStepsReady.load();
+  doc["underruns"] = sequenceUnderruns;
+  doc["step_ms"] = sequenceStepMs;
+  doc["profile"] = motionProfileName(sequenceProfile);
+  if (sequenceState == SEQ_RUNNING) {
+    doc["elapsed_ms"] = millis() - sequenceStartTime;
+  } else if (sequenceState == SEQ_SCHEDULED) {
+    doc["start_at_ms"] = sequenceStartTime;
+    doc["starts_in_ms"] = (long)(sequenceStartTime - millis());
   }
 }
 
-// Pulse range typical for SG90/MG90 etc.
-const int SERVO_MIN_US = 500;  // microseconds
-const int SERVO_MAX_US = 2400; // microseconds
-
 // HTTP server on port 80
 WebServer server(80);
 
 unsigned long lastBlink = 0;
 bool ledState = false;
-unsigned long lastStackExecution[SERVO_COUNT] = {0};
-const unsigned long STACK_EXECUTION_INTERVAL = 50; // Execute stack every 50ms
 
+// deserializeJson with its run time fed to the json_parse histogram
+template <typename TInput>
+DeserializationError parseJson(JsonDocument &doc, const TInput &input) {
+  int64_t t0 = esp_timer_get_time();
+  DeserializationError error = deserializeJson(doc, input);
+  metricsRecord(METRIC_JSON_PARSE, (uint32_t)(esp_timer_get_time() - t0));
+  return error;
+}
+
+// Per-request JSON documents and replies come from the request arena; the
+// PSRAM size leaves room for the full /metrics document plus its reply
+static const size_t REQUEST_ARENA_INTERNAL_BYTES = 24 * 1024;
+static const size_t REQUEST_ARENA_PSRAM_BYTES = 64 * 1024;
+
+// Serialize into the arena and send it as-is, with no String copy of the body
 void sendJson(const JsonDocument &doc, int status = 200) {
-  String out;
-  serializeJson(doc, out);
-  server.send(status, "application/json", out);
+  size_t len = measureJson(doc);
+  char *out = (char *)requestArenaAlloc(len + 1);
+  serializeJson(doc, out, len + 1);
+  server.send_P(status, "application/json", out, len);
+  requestArenaFree(out);
 }
 
 void handleRoot() {
-  Serial.println("📡 GET / - Status request received");
-  StaticJsonDocument<1024> doc;
+  LOGD("📡 GET / - Status request received");
+  ArenaJsonDocument doc(1536);
   doc["status"] = "ok";
   JsonArray pins = doc.createNestedArray("pins");
   for (int i = 0; i < SERVO_COUNT; ++i) {
-    pins.add(SERVO_PINS[i]);
+    pins.add(JOINTS[i].pin);
   }
   JsonArray angles = doc.createNestedArray("angles");
   for (int i = 0; i < SERVO_COUNT; ++i) {
@@ -177,24 +302,49 @@ void handleRoot() {
   // Add stack status
   JsonArray stackSizes = doc.createNestedArray("stack_sizes");
   for (int i = 0; i < SERVO_COUNT; ++i) {
-    stackSizes.add(servoStacks[i].size());
+    stackSizes.add(stackDepth(i));
   }
+  doc["stack_capacity"] = STACK_CAPACITY;
 
   // Add batch status
   doc["batch_count"] = batchCount;
   doc["batch_ready"] = batchReady;
   doc["batch_timeout_remaining"] = BATCH_TIMEOUT - (millis() - batchStartTime);
 
+  // Add planner status
+  JsonObject planner = doc.createNestedObject("planner");
+  planner["profile"] = motionProfileName(defaultProfile);
+  planner["moving"] = plannerMoving();
+
+  // Add stream status
+  JsonObject stream = doc.createNestedObject("stream");
+  stream["udp_port"] = STREAM_UDP_PORT;
+  stream["last_seq"] = streamStats.lastSeq;
+  stream["received"] = streamStats.received;
+  stream["applied"] = streamStats.applied;
+  stream["dropped_stale"] = streamStats.droppedStale;
+  stream["dropped_malformed"] = streamStats.droppedMalformed;
+  stream["dropped_busy"] = streamStats.droppedBusy;
+
+  // Add sequence status
+  JsonObject seq = doc.createNestedObject("sequence");
+  seq["job_id"] = sequenceJobId;
+  seq["state"] = sequenceStateName(sequenceState);
+  seq["steps"] = sequenceLength;
+  seq["steps_executed"] = sequenceCursor;
+
   doc["mapping"] = "indices 0-2 left arm joints, 3-5 right arm joints";
+  doc["motion_queue_depth"] = motionQueue.size();
+  doc["motion_queue_drops"] = motionQueueDrops;
   doc["free_heap"] = ESP.getFreeHeap();
-  Serial.println("✅ Status response sent");
+  doc["log_dropped"] = logDroppedCount();
+  doc["skills_cached"] = skillCacheCount();
   sendJson(doc);
 }
 
 // Simple servo command handler - collects 6 commands before executing
 void handleServos() {
-  Serial.print("📡 POST /servo - Servo command received from ");
-  Serial.println(server.client().remoteIP());
+  LOGD("📡 POST /servo - Servo command received from %s", server.client().remoteIP().toString().c_str());
 
   if (!server.hasArg("plain")) {
     server.send(400, "application/json", "{\"error\":\"Missing body\"}");
@@ -204,16 +354,14 @@ void handleServos() {
   String body = server.arg("plain");
   body.trim();
 
-  Serial.print("📥 Raw command: ");
-  Serial.println(body);
+  LOGD("📥 Raw command: %s", body.c_str());
 
   // Simple JSON parsing - just looking for id and angle
   StaticJsonDocument<256> doc;
-  DeserializationError error = deserializeJson(doc, body);
+  DeserializationError error = parseJson(doc, body);
 
   if (error) {
-    Serial.print("❌ JSON error: ");
-    Serial.println(error.c_str());
+    LOGW("❌ JSON error: %s", error.c_str());
     server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
     return;
   }
@@ -225,7 +373,7 @@ void handleServos() {
   }
 
   int id = doc["id"];
-  int angle = doc["angle"];
+  int angle = jsonAngleCdeg(doc["angle"]); // fractional degrees allowed
 
   // Validate servo ID
   if (id < 1 || id > SERVO_COUNT) {
@@ -234,7 +382,7 @@ void handleServos() {
   }
 
   // Validate angle
-  if (angle < 0 || angle > 180) {
+  if (angle < 0) {
     server.send(400, "application/json", "{\"error\":\"Angle out of range 0-180\"}");
     return;
   }
@@ -257,38 +405,25 @@ void handleServos() {
       batchStartTime = millis();
     }
 
-    Serial.print("📦 Added to batch - Servo ");
-    Serial.print(id);
-    Serial.print(" (");
-    Serial.print(getServoName(id));
-    Serial.print(") -> ");
-    Serial.print(angle);
-    Serial.print("° | Batch progress: ");
-    Serial.print(batchCount);
-    Serial.print("/");
-    Serial.println(SERVO_COUNT);
+    LOGD("📦 Added to batch - Servo %d (%s) -> %.2f° | Batch progress: %d/%d",
+         id, getServoName(id), angle / (float)CDEG_PER_DEG, batchCount, SERVO_COUNT);
 
     // Check if batch is complete
     if (batchCount == SERVO_COUNT) {
       batchReady = true;
-      Serial.println("🎯 Batch complete! Executing all 6 servo commands...");
-      executeBatch();
+      LOGD("🎯 Batch complete! Executing all 6 servo commands...");
+      if (!executeBatch()) {
+        server.send(503, "application/json", "{\"error\":\"Motion queue full\"}");
+        return;
+      }
     }
   } else {
     // Update existing command in batch
     batchBuffer[idx].angle = angle;
     batchBuffer[idx].timestamp = millis();
 
-    Serial.print("🔄 Updated batch - Servo ");
-    Serial.print(id);
-    Serial.print(" (");
-    Serial.print(getServoName(id));
-    Serial.print(") -> ");
-    Serial.print(angle);
-    Serial.print("° | Batch progress: ");
-    Serial.print(batchCount);
-    Serial.print("/");
-    Serial.println(SERVO_COUNT);
+    LOGD("🔄 Updated batch - Servo %d (%s) -> %.2f° | Batch progress: %d/%d",
+         id, getServoName(id), angle / (float)CDEG_PER_DEG, batchCount, SERVO_COUNT);
   }
 
   // Send immediate response
@@ -296,196 +431,1718 @@ void handleServos() {
   res["status"] = batchReady ? "batch_executed" : "batched";
   res["id"] = id;
   res["name"] = getServoName(id);
-  res["angle"] = angle;
+  res["angle"] = angle / (float)CDEG_PER_DEG;
   res["batch_count"] = batchCount;
   res["batch_complete"] = (batchCount == SERVO_COUNT);
   res["timestamp"] = millis();
   sendJson(res);
 }
 
-// Handle choreographed sequence commands
-void handleSequence() {
-  Serial.print("📡 POST /sequence - Sequence request received from ");
-  Serial.println(server.client().remoteIP());
+void fillPlannerStatus(JsonDocument &doc) {
+  doc["profile"] = motionProfileName(defaultProfile);
+  doc["tick_ms"] = CONTROL_TICK_MS;
+  doc["moving"] = plannerMoving();
+  JsonArray vel = doc.createNestedArray("max_velocity");
+  JsonArray acc = doc.createNestedArray("max_accel");
+  JsonArray tgt = doc.createNestedArray("targets");
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    vel.add(jointMaxVelocity[i]);
+    acc.add(jointMaxAccel[i]);
+    tgt.add(joints[i].target);
+  }
+}
 
-  unsigned long heapBefore = ESP.getFreeHeap();
+void handlePlannerStatus() {
+  StaticJsonDocument<512> doc;
+  fillPlannerStatus(doc);
+  sendJson(doc);
+}
 
+// Tune the planner: {"profile": name, "max_velocity": [6 deg/s], "max_accel": [6 deg/s^2]}
+// Every field is optional; the whole request is validated before anything changes.
+void handlePlannerConfig() {
   if (!server.hasArg("plain")) {
     server.send(400, "application/json", "{\"error\":\"Missing body\"}");
     return;
   }
+  StaticJsonDocument<512> doc;
+  if (parseJson(doc, server.arg("plain"))) {
+    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+    return;
+  }
 
-  String body = server.arg("plain");
-  size_t bodyLen = body.length();
-  Serial.print("📥 Received JSON body length: ");
-  Serial.println(bodyLen);
+  MotionProfile profile = defaultProfile;
+  if (doc.containsKey("profile") && !parseMotionProfile(doc["profile"].as<const char*>(), &profile)) {
+    server.send(400, "application/json", "{\"error\":\"Unknown profile\"}");
+    return;
+  }
+  const char* keys[2] = {"max_velocity", "max_accel"};
+  for (int k = 0; k < 2; ++k) {
+    if (!doc.containsKey(keys[k])) continue;
+    JsonArray arr = doc[keys[k]].as<JsonArray>();
+    if (arr.isNull() || arr.size() != SERVO_COUNT) {
+      server.send(400, "application/json", "{\"error\":\"Limits must have 6 entries\"}");
+      return;
+    }
+    for (int i = 0; i < SERVO_COUNT; ++i) {
+      if (arr[i].as<float>() <= 0) {
+        server.send(400, "application/json", "{\"error\":\"Limits must be positive\"}");
+        return;
+      }
+    }
+  }
+
+  defaultProfile = profile;
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    if (doc.containsKey("max_velocity")) jointMaxVelocity[i] = doc["max_velocity"][i].as<float>();
+    if (doc.containsKey("max_accel")) jointMaxAccel[i] = doc["max_accel"][i].as<float>();
+  }
+  LOGI("🧭 Planner updated: profile=%s", motionProfileName(defaultProfile));
+
+  StaticJsonDocument<512> res;
+  fillPlannerStatus(res);
+  sendJson(res);
+}
+
+#if ROBOT_FEEDBACK
+// Newest feedback snapshot in degrees and mA, plus detector and telemetry counters
+void handleFeedback() {
+  StaticJsonDocument<1536> doc;
+  FeedbackStats stats = feedbackStats();
+  doc["running"] = stats.running;
+  doc["ticks"] = stats.ticks;
+  doc["samples"] = stats.samples;
+  doc["overruns"] = stats.overruns;
+  doc["stalls"] = stats.stalls;
+  doc["overcurrents"] = stats.overcurrents;
+  doc["snapshot_drops"] = stats.snapshotDrops;
+  JsonObject telemetry = doc.createNestedObject("telemetry");
+  telemetry["active"] = telemetrySub.active;
+  if (telemetrySub.active) telemetry["to"] = telemetrySub.ip.toString();
+  telemetry["sent"] = telemetrySub.sent;
+
+  if (haveFeedback) {
+    const FeedbackSnapshot &s = latestFeedback;
+    doc["age_ms"] = millis() - s.atMs;
+    JsonArray joints = doc.createNestedArray("joints");
+    for (int i = 0; i < SERVO_COUNT; ++i) {
+      JsonObject j = joints.createNestedObject();
+      j["id"] = JOINTS[i].id;
+      j["commanded"] = s.commanded[i] / (float)CDEG_PER_DEG;
+      if (s.measured[i] != FEEDBACK_NONE) j["measured"] = s.measured[i] / (float)CDEG_PER_DEG;
+      if (s.currentMa[i] != FEEDBACK_NONE) j["supply_ma"] = s.currentMa[i];
+      j["stalled"] = (s.stalled & (1 << i)) != 0;
+      j["overcurrent"] = (s.overcurrent & (1 << i)) != 0;
+    }
+  }
+  sendJson(doc);
+}
+#endif
+
+void fillWatchdogStatus(JsonDocument &doc) {
+  doc["stream_deadline_ms"] = streamDeadlineMs;
+  doc["action"] = streamTimeoutActionName(streamTimeoutAction);
+  JsonArray pose = doc.createNestedArray("safe_pose");
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    pose.add(safePose[i] / (float)CDEG_PER_DEG);
+  }
+  doc["armed"] = streamWatchdogArmed;
+  doc["trips"] = streamWatchdogTrips;
+  doc["batch_timeouts"] = batchTimeouts;
+}
+
+void handleWatchdogStatus() {
+  StaticJsonDocument<512> doc;
+  fillWatchdogStatus(doc);
+  sendJson(doc);
+}
 
-  // Parse JSON in memory
-  Serial.println("🧠 Parsing sequence in memory");
-  size_t cap = 2048 + bodyLen; // Generous allocation for ESP32 WROVER
-  DynamicJsonDocument *docPtr = new (std::nothrow) DynamicJsonDocument(cap);
-  if (!docPtr) {
-    server.send(500, "application/json", "{\"error\":\"Memory allocation failure\"}");
+// Tune the stream watchdog: {"stream_deadline_ms": 0 (off) to 10000,
+// "action": "hold" | "safe_pose", "safe_pose": [6 degrees]}. Every field is
+// optional; the whole request is validated before anything changes.
+void handleWatchdogConfig() {
+  if (!server.hasArg("plain")) {
+    server.send(400, "application/json", "{\"error\":\"Missing body\"}");
+    return;
+  }
+  StaticJsonDocument<384> doc;
+  if (parseJson(doc, server.arg("plain"))) {
+    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
     return;
   }
 
-  DeserializationError jerr = deserializeJson(*docPtr, body);
-  if (jerr) {
-    Serial.print("❌ JSON deserialization error: ");
-    Serial.println(jerr.c_str());
-    delete docPtr;
-    server.send(400, "application/json", "{\"error\":\"JSON parse failed\"}");
+  unsigned long deadline = streamDeadlineMs;
+  if (doc.containsKey("stream_deadline_ms")) {
+    JsonVariant v = doc["stream_deadline_ms"];
+    if (!v.is<long>() || v.as<long>() < 0 || v.as<long>() > (long)MAX_STREAM_DEADLINE_MS) {
+      server.send(400, "application/json", "{\"error\":\"stream_deadline_ms out of range 0-10000\"}");
+      return;
+    }
+    deadline = v.as<unsigned long>();
+  }
+  StreamTimeoutAction action = streamTimeoutAction;
+  if (doc.containsKey("action") && !parseStreamTimeoutAction(doc["action"].as<const char*>(), &action)) {
+    server.send(400, "application/json", "{\"error\":\"Unknown action\"}");
     return;
   }
+  int pose[SERVO_COUNT];
+  memcpy(pose, safePose, sizeof(pose));
+  if (doc.containsKey("safe_pose")) {
+    JsonArray arr = doc["safe_pose"].as<JsonArray>();
+    if (arr.isNull() || arr.size() != SERVO_COUNT) {
+      server.send(400, "application/json", "{\"error\":\"safe_pose must have 6 entries\"}");
+      return;
+    }
+    for (int i = 0; i < SERVO_COUNT; ++i) {
+      pose[i] = jsonAngleCdeg(arr[i]);
+      if (pose[i] < 0) {
+        server.send(400, "application/json", "{\"error\":\"Angle out of range 0-180\"}");
+        return;
+      }
+    }
+  }
 
-  JsonDocument &doc = *docPtr;
+  streamDeadlineMs = deadline;
+  streamTimeoutAction = action;
+  memcpy(safePose, pose, sizeof(pose));
+  LOGI("🛟 Stream watchdog: %lums, %s", deadline, streamTimeoutActionName(action));
+
+  StaticJsonDocument<512> res;
+  fillWatchdogStatus(res);
+  sendJson(res);
+}
 
-  if (!doc.containsKey("sequence")) {
-    delete docPtr;
-    server.send(400, "application/json", "{\"error\":\"Missing sequence field\"}");
+// Whole-pose command: {"angles":[a1..a6], "at_ms": optional millis() deadline,
+// "duration_ms": optional time to reach the pose}. A null entry leaves that servo untouched.
+void handleFrame() {
+  if (!server.hasArg("plain")) {
+    server.send(400, "application/json", "{\"error\":\"Missing body\"}");
     return;
   }
 
-  JsonArray sequence = doc["sequence"].as<JsonArray>();
-  String skill = doc.containsKey("skill") ? doc["skill"].as<String>() : String("Unknown Skill");
+  StaticJsonDocument<256> doc;
+  DeserializationError error = parseJson(doc, server.arg("plain"));
+  if (error) {
+    LOGW("❌ JSON error: %s", error.c_str());
+    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+    return;
+  }
 
-  Serial.print("🎭 Skill: ");
-  Serial.println(skill);
-  Serial.print("🧾 Steps: ");
-  Serial.println(sequence.size());
+  JsonArray arr = doc["angles"].as<JsonArray>();
+  if (arr.isNull() || arr.size() != SERVO_COUNT) {
+    server.send(400, "application/json", "{\"error\":\"angles must have 6 entries\"}");
+    return;
+  }
 
-  // Execute steps
-  for (JsonObject step : sequence) {
-    if (!step.containsKey("commands")) {
-      delete docPtr;
-      server.send(400, "application/json", "{\"error\":\"Step missing commands\"}");
+  int angles[SERVO_COUNT];
+  JointMask mask = 0;
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    JsonVariant v = arr[i];
+    if (v.isNull()) continue;
+    int angle = jsonAngleCdeg(v);
+    if (angle < 0) {
+      server.send(400, "application/json", "{\"error\":\"Angle out of range 0-180\"}");
       return;
     }
-    JsonArray commands = step["commands"].as<JsonArray>();
-    Serial.print("🔢 Step ");
-    Serial.print(step["seq_num"].as<int>());
-    Serial.print(" cmds=");
-    Serial.println(commands.size());
+    angles[i] = angle;
+    mask |= (1 << i);
+  }
 
-    for (JsonObject c : commands) {
-      if (!c.containsKey("id") || !c.containsKey("deg")) {
-        delete docPtr;
-        server.send(400, "application/json", "{\"error\":\"Command missing id/deg\"}");
-        return;
-      }
-      int sid = c["id"].as<int>();
-      int angle = c["deg"].as<int>();
-      int idx = getServoIndex(sid);
-      if (idx < 0) {
-        delete docPtr;
-        server.send(400,"application/json","{\"error\":\"Bad servo id\"}");
+  unsigned long durationMs = doc["duration_ms"] | 0UL;
+  if (durationMs > MAX_FRAME_LEAD_MS) {
+    server.send(400, "application/json", "{\"error\":\"duration_ms too long\"}");
+    return;
+  }
+
+  StaticJsonDocument<256> res;
+  unsigned long now = millis();
+  bool scheduled = false;
+  if (doc.containsKey("at_ms")) {
+    unsigned long applyAt = doc["at_ms"].as<unsigned long>();
+    long lead = (long)(applyAt - now);
+    if (lead > (long)MAX_FRAME_LEAD_MS) {
+      server.send(400, "application/json", "{\"error\":\"at_ms too far in the future\"}");
+      return;
+    }
+    if (lead > 0) {
+      MotionCommand cmd = {};
+      cmd.type = MOTION_SCHEDULE;
+      memcpy(cmd.angles, angles, sizeof(angles));
+      cmd.mask = mask;
+      cmd.durationMs = durationMs;
+      cmd.applyAt = applyAt;
+      if (!postMotion(cmd)) {
+        server.send(503, "application/json", "{\"error\":\"Motion queue full\"}");
         return;
       }
-      if (angle < 0 || angle > 180) {
-        delete docPtr;
-        server.send(400,"application/json","{\"error\":\"Angle out of range\"}");
-        return;
+      scheduled = true;
+      res["at_ms"] = applyAt;
+    }
+  }
+  // A newer immediate frame supersedes a scheduled one
+  if (!scheduled && !applyFrame(angles, mask, durationMs)) {
+    server.send(503, "application/json", "{\"error\":\"Motion queue full\"}");
+    return;
+  }
+
+  res["status"] = scheduled ? "scheduled" : "executed";
+  JsonArray out = res.createNestedArray("angles");
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    out.add(currentAngles[i]);
+  }
+  res["timestamp"] = now;
+  sendJson(res);
+}
+
+// Choreographed sequence upload (POST /sequence). The JSON body is tokenized
+// as it streams in and each step is written straight into the step table, so
+// nothing bigger than one token is buffered and skill length is bounded only
+// by MAX_SEQUENCE_STEPS. Expected shape:
+//   {"skill": "...", "step_ms": 400, "profile": "cubic", "start_at_ms": 123456,
+//    "sequence": [{"commands": [{"id": 1, "deg": 90}, ...]}, {"hold": 3}, ...]}
+// Only the listed servos move in a step, so a delta-encoded sequence names
+// just the joints that change; {"hold": n} stands for n steps that keep the
+// pose. Unknown keys (e.g. "seq_num") are skipped. Playback is started on the
+// motion task and the request answered 202 once the body is complete.
+struct SequenceJsonUpload : public JsonStreamHandler {
+  enum Where : uint8_t { AT_START, IN_ROOT, IN_STEPS, IN_STEP, IN_COMMANDS, IN_COMMAND, AT_END };
+
+  Where where;
+  uint8_t skipDepth;      // >0 while inside a value nobody asked for
+  char key[16];           // most recent key in the current object
+  char skill[64];
+  char profile[16];
+  bool hasProfile;
+  bool hasStartAt;
+  unsigned long startAt;  // device millis() for a synchronised start
+  bool sawSequence;
+  bool stepHasCommands;
+  long stepHold;          // {"hold": n} steps standing in for this one
+  long stepMs;
+  int stepCount;
+  long cmdId;
+  long cmdDeg;            // centidegrees
+  bool cmdHasId;
+  bool cmdHasDeg;
+  size_t received;
+  uint32_t parseUs;       // time spent in the tokenizer across all chunks
+  uint32_t heapBefore;
+  int errorStatus;        // 0 while the upload is valid, otherwise the HTTP status to reply with
+  const char *error;
+
+  void reset() {
+    where = AT_START;
+    skipDepth = 0;
+    key[0] = '\0';
+    strcpy(skill, "Unknown Skill");
+    hasProfile = false;
+    hasStartAt = false;
+    sawSequence = false;
+    stepMs = DEFAULT_STEP_DURATION_MS;
+    stepCount = 0;
+    received = 0;
+    parseUs = 0;
+    heapBefore = ESP.getFreeHeap();
+    errorStatus = 0;
+    error = nullptr;
+  }
+
+  bool fail(int status, const char *message) {
+    if (errorStatus == 0) {
+      errorStatus = status;
+      error = message;
+    }
+    return false;
+  }
+
+  // Integer from a JSON number (times scale, rounded) or a numeric string
+  static bool parseInteger(JsonStreamEvent event, const char *text, long *out, long scale = 1) {
+    if (event != JSON_NUMBER && event != JSON_STRING) return false;
+    char *end;
+    double v = strtod(text, &end);
+    if (end == text || *end != '\0') return false;
+    *out = scale == 1 ? (long)v : lround(v * scale);
+    return true;
+  }
+
+  bool openContainer(JsonStreamEvent event) {
+    bool isObject = event == JSON_OBJECT_START;
+    switch (where) {
+      case AT_START:
+        if (!isObject) return fail(400, "Body must be an object");
+        where = IN_ROOT;
+        return true;
+      case IN_ROOT:
+        if (!isObject && !sawSequence && strcmp(key, "sequence") == 0) {
+          sawSequence = true;
+          where = IN_STEPS;
+          return true;
+        }
+        break;
+      case IN_STEPS:
+        if (!isObject) return fail(400, "Step must be an object");
+        if (stepCount >= MAX_SEQUENCE_STEPS) return fail(413, "Too many steps");
+        sequenceSteps[stepCount].mask = 0;
+        stepHasCommands = false;
+        stepHold = 0;
+        where = IN_STEP;
+        return true;
+      case IN_STEP:
+        if (!isObject && strcmp(key, "commands") == 0) {
+          stepHasCommands = true;
+          where = IN_COMMANDS;
+          return true;
+        }
+        break;
+      case IN_COMMANDS:
+        if (!isObject) return fail(400, "Command must be an object");
+        cmdHasId = cmdHasDeg = false;
+        where = IN_COMMAND;
+        return true;
+      default:
+        break;
+    }
+    skipDepth = 1;
+    return true;
+  }
+
+  bool closeContainer() {
+    switch (where) {
+      case IN_COMMAND: {
+        if (!cmdHasId || !cmdHasDeg) return fail(400, "Command missing id/deg");
+        int idx = getServoIndex((int)cmdId);
+        if (idx < 0) return fail(400, "Bad servo id");
+        if (cmdDeg < 0 || cmdDeg > MAX_ANGLE_CDEG) return fail(400, "Angle out of range");
+        SequenceStep &entry = sequenceSteps[stepCount];
+        entry.angles[idx] = (uint16_t)cmdDeg;
+        entry.mask |= (1 << idx);
+        where = IN_COMMANDS;
+        return true;
       }
+      case IN_COMMANDS:
+        where = IN_STEP;
+        return true;
+      case IN_STEP:
+        if (stepHold > 0) {
+          if (stepHasCommands) return fail(400, "Step has both commands and hold");
+          if (stepCount + stepHold > MAX_SEQUENCE_STEPS) return fail(413, "Too many steps");
+          for (long n = 0; n < stepHold; ++n) sequenceSteps[stepCount++].mask = 0;
+          where = IN_STEPS;
+          return true;
+        }
+        if (!stepHasCommands) return fail(400, "Step missing commands");
+        stepCount++;
+        where = IN_STEPS;
+        return true;
+      case IN_STEPS:
+        where = IN_ROOT;
+        return true;
+      default:
+        where = AT_END;
+        return true;
+    }
+  }
 
-      // Apply angle adjustment for motor inversion (pin 12)
-      int adjustedAngle = adjustAngleForServo(idx, angle);
-      servos[idx].write(adjustedAngle);
-      currentAngles[idx] = angle; // Store original angle for status
-
-      Serial.print("  ✅ Servo ");
-      Serial.print(sid);
-      Serial.print(" -> ");
-      Serial.print(angle);
-      if (idx == 2) { // Show inverted angle for pin 12
-        Serial.print("° (inverted to ");
-        Serial.print(adjustedAngle);
-        Serial.print("°)");
-      } else {
-        Serial.print("°");
+  bool scalar(JsonStreamEvent event, const char *text, size_t len) {
+    if (where == IN_ROOT) {
+      if (strcmp(key, "skill") == 0 && event == JSON_STRING) {
+        size_t n = len < sizeof(skill) - 1 ? len : sizeof(skill) - 1;
+        memcpy(skill, text, n);
+        skill[n] = '\0';
+      } else if (strcmp(key, "step_ms") == 0) {
+        if (!parseInteger(event, text, &stepMs)) return fail(400, "step_ms out of range");
+      } else if (strcmp(key, "start_at_ms") == 0) {
+        char *end;
+        startAt = strtoul(text, &end, 10);
+        if (event != JSON_NUMBER || end == text || *end != '\0') return fail(400, "start_at_ms out of range");
+        hasStartAt = true;
+      } else if (strcmp(key, "profile") == 0) {
+        if (event != JSON_STRING || len >= sizeof(profile)) return fail(400, "Unknown profile");
+        memcpy(profile, text, len + 1);
+        hasProfile = true;
       }
-      Serial.println();
+      return true;
+    }
+    if (where == IN_STEP && strcmp(key, "hold") == 0) {
+      if (!parseInteger(event, text, &stepHold) || stepHold < 1) return fail(400, "Bad hold");
+      return true;
+    }
+    if (where == IN_COMMAND) {
+      if (strcmp(key, "id") == 0) {
+        cmdHasId = parseInteger(event, text, &cmdId);
+        if (!cmdHasId) return fail(400, "Bad servo id");
+      } else if (strcmp(key, "deg") == 0) {
+        cmdHasDeg = parseInteger(event, text, &cmdDeg, CDEG_PER_DEG);
+        if (!cmdHasDeg) return fail(400, "Angle out of range");
+      }
+      return true;
+    }
+    if (where == AT_START) return fail(400, "Body must be an object");
+    if (where == IN_STEPS) return fail(400, "Step must be an object");
+    if (where == IN_COMMANDS) return fail(400, "Command must be an object");
+    return true;
+  }
+
+  bool onJsonEvent(JsonStreamEvent event, const char *text, size_t len) override {
+    if (errorStatus != 0) return false;
+    if (skipDepth > 0) {
+      if (event == JSON_OBJECT_START || event == JSON_ARRAY_START) skipDepth++;
+      if (event == JSON_OBJECT_END || event == JSON_ARRAY_END) skipDepth--;
+      return true;
     }
-    delay(400);
+    switch (event) {
+      case JSON_KEY:
+        strncpy(key, text, sizeof(key) - 1);
+        key[sizeof(key) - 1] = '\0';
+        return true;
+      case JSON_OBJECT_START:
+      case JSON_ARRAY_START:
+        return openContainer(event);
+      case JSON_OBJECT_END:
+      case JSON_ARRAY_END:
+        return closeContainer();
+      default:
+        return scalar(event, text, len);
+    }
+  }
+};
+
+SequenceJsonUpload seqUpload;
+JsonStreamParser seqUploadParser(seqUpload);
+
+// Body chunks for /sequence
+void handleSequenceUpload() {
+  HTTPRaw &raw = server.raw();
+  if (raw.status == RAW_START) {
+    seqUpload.reset();
+    seqUploadParser.reset();
+    if (sequenceBusy()) seqUpload.fail(409, "Sequence already running");
+  } else if (raw.status == RAW_WRITE) {
+    seqUpload.received += raw.currentSize;
+    int64_t t0 = esp_timer_get_time();
+    if (seqUpload.errorStatus == 0 && !seqUploadParser.feed(raw.buf, raw.currentSize)) {
+      seqUpload.fail(400, "JSON parse failed");
+    }
+    seqUpload.parseUs += (uint32_t)(esp_timer_get_time() - t0);
+  } else if (raw.status == RAW_ABORTED) {
+    seqUpload.fail(400, "Upload aborted");
   }
+}
+
+// Called once the whole /sequence body has been fed to the tokenizer
+void handleSequence() {
+  LOGI("📡 POST /sequence - Sequence request received from %s (%u bytes)",
+       server.client().remoteIP().toString().c_str(), (unsigned)seqUpload.received);
 
+  if (seqUpload.errorStatus == 0 && seqUpload.received == 0) {
+    seqUpload.fail(400, "Missing body");
+  }
+  if (seqUpload.errorStatus == 0 && !seqUploadParser.finish()) {
+    seqUpload.fail(400, "JSON parse failed");
+  }
+  if (seqUpload.received > 0) metricsRecord(METRIC_JSON_PARSE, seqUpload.parseUs);
+  if (seqUpload.errorStatus == 0 && !seqUpload.sawSequence) {
+    seqUpload.fail(400, "Missing sequence field");
+  }
+  MotionProfile profile = defaultProfile;
+  if (seqUpload.errorStatus == 0 && seqUpload.hasProfile && !parseMotionProfile(seqUpload.profile, &profile)) {
+    seqUpload.fail(400, "Unknown profile");
+  }
+  if (seqUpload.errorStatus == 0 &&
+      (seqUpload.stepMs < (long)MIN_STEP_DURATION_MS || seqUpload.stepMs > (long)MAX_STEP_DURATION_MS)) {
+    seqUpload.fail(400, "step_ms out of range");
+  }
+  if (seqUpload.errorStatus == 0 && seqUpload.hasStartAt && !validStartAt(seqUpload.startAt)) {
+    seqUpload.fail(400, "start_at_ms out of range");
+  }
+  if (seqUpload.errorStatus != 0) {
+    if (seqUploadParser.failed() && seqUpload.errorStatus == 400) {
+      LOGW("❌ Sequence rejected at byte %u: %s (%s)", (unsigned)seqUploadParser.offset(),
+           seqUpload.error, seqUploadParser.error());
+    } else {
+      LOGW("❌ Sequence rejected: %s", seqUpload.error);
+    }
+    StaticJsonDocument<128> err;
+    err["error"] = seqUpload.error;
+    if (seqUpload.errorStatus == 409) err["job_id"] = sequenceJobId;
+    sendJson(err, seqUpload.errorStatus);
+    return;
+  }
+
+  String skill(seqUpload.skill);
+  int stepCount = seqUpload.stepCount;
+  unsigned long stepMs = (unsigned long)seqUpload.stepMs;
+  LOGI("🎭 Skill: %s | 🧾 Steps: %d", skill.c_str(), stepCount);
+
+  uint32_t jobId = startSequence(skill.c_str(), stepCount, stepMs, profile, seqUpload.hasStartAt, seqUpload.startAt);
+  if (jobId == 0) {
+    server.send(503, "application/json", "{\"error\":\"Motion queue full\"}");
+    return;
+  }
   unsigned long heapAfter = ESP.getFreeHeap();
 
   // Build response
-  DynamicJsonDocument resp(512 + SERVO_COUNT * 8);
-  resp["status"] = "completed";
+  StaticJsonDocument<384> resp;
+  resp["status"] = "accepted";
+  resp["job_id"] = jobId;
   resp["skill"] = skill;
-  resp["steps_executed"] = sequence.size();
-  resp["heap_before"] = heapBefore;
+  resp["steps"] = stepCount;
+  resp["step_ms"] = stepMs;
+  resp["profile"] = motionProfileName(profile);
+  resp["estimated_duration_ms"] = (unsigned long)stepCount * stepMs;
+  if (seqUpload.hasStartAt) resp["start_at_ms"] = seqUpload.startAt;
+  resp["heap_before"] = seqUpload.heapBefore;
   resp["heap_after"] = heapAfter;
-  resp["body_size"] = bodyLen;
-  resp["memory_used"] = heapBefore - heapAfter;
-  JsonArray finalAngles = resp.createNestedArray("final_angles");
-  for (int i=0;i<SERVO_COUNT;++i) {
-    finalAngles.add(currentAngles[i]);
+  resp["body_size"] = seqUpload.received;
+  sendJson(resp, 202);
+}
+
+// Report the current (or last) sequence job
+void handleSequenceStatus() {
+  StaticJsonDocument<512> doc;
+  fillSequenceStatus(doc);
+  JsonArray angles = doc.createNestedArray("angles");
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    angles.add(currentAngles[i]);
   }
+  sendJson(doc);
+}
 
-  sendJson(resp);
-  delete docPtr; // Free memory
+// Device clock for NTP-style offset estimation: the host timestamps either
+// side of this request and takes the reply as stamped halfway between
+void handleTime() {
+  char body[64];
+  snprintf(body, sizeof(body), "{\"now_ms\":%lu,\"now_us\":%lld}", millis(), (long long)esp_timer_get_time());
+  server.send(200, "application/json", body);
 }
 
-// Process servo stacks in parallel (keeping for backwards compatibility)
-void processServoStacks() {
-  unsigned long now = millis();
+// Stop the running sequence; servos hold their last written pose
+void handleSequenceAbort() {
+  LOGI("📡 POST /sequence/abort - Abort request received");
+  bool wasRunning = requestSequenceAbort();
+  StaticJsonDocument<384> doc;
+  fillSequenceStatus(doc);
+  doc["aborted"] = wasRunning;
+  sendJson(doc);
+}
 
-  for (int i = 0; i < SERVO_COUNT; ++i) {
-    // Check if it's time to execute next command for this servo
-    if (now - lastStackExecution[i] >= STACK_EXECUTION_INTERVAL) {
-      if (!servoStacks[i].empty()) {
-        ServoCommand cmd = servoStacks[i].front();
-        servoStacks[i].pop();
-
-        // Execute servo command with angle adjustment
-        int adjustedAngle = adjustAngleForServo(i, cmd.angle);
-        servos[i].write(adjustedAngle);
-        currentAngles[i] = cmd.angle; // Store original angle for status
-        lastStackExecution[i] = now;
-
-        Serial.print("⚡ Executed - Servo ");
-        Serial.print(i + 1);
-        Serial.print(" -> ");
-        Serial.print(cmd.angle);
-        if (i == 2) { // Show inverted angle for pin 12
-          Serial.print("° (inverted to ");
-          Serial.print(adjustedAngle);
-          Serial.print("°)");
-        } else {
-          Serial.print("°");
-        }
-        Serial.print(" | Remaining in stack: ");
-        Serial.println(servoStacks[i].size());
+// Drive the monkey face directly: {"expression": name, "react": optional bool}.
+// A reaction shows briefly and falls back to the held expression; sequence
+// playback sets the held expression on its own (see faceLinkPoll)
+void handleFace() {
+  if (!server.hasArg("plain")) {
+    server.send(400, "application/json", "{\"error\":\"Missing body\"}");
+    return;
+  }
+  StaticJsonDocument<128> doc;
+  if (parseJson(doc, server.arg("plain"))) {
+    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+    return;
+  }
+  FaceExpression expression;
+  if (!parseFaceExpression(doc["expression"].as<const char*>(), &expression)) {
+    server.send(400, "application/json", "{\"error\":\"Unknown expression\"}");
+    return;
+  }
+  bool react = doc["react"] | false;
+  if (react) {
+    faceLinkSend(FACE_OP_REACT, expression);
+  } else {
+    faceLinkSetExpression(expression);
+  }
+
+  StaticJsonDocument<128> res;
+  res["expression"] = faceExpressionName(expression);
+  res["react"] = react;
+  res["face_seen"] = faceLinkStats().faceSeen;
+  sendJson(res);
+}
+
+// Queue angles on one servo's stack (POST /stack); the motion task plays them
+// back one every STACK_EXECUTION_INTERVAL ms.
+// Body: {"id": 1-6, "angles": [0-180, ...], "policy": "reject" | "drop_oldest"}
+// "reject" (default) answers 429 when the stack lacks room for all of them
+void handleStack() {
+  if (!server.hasArg("plain")) {
+    server.send(400, "application/json", "{\"error\":\"Missing body\"}");
+    return;
+  }
+
+  ArenaJsonDocument doc(1536);
+  DeserializationError error = parseJson(doc, server.arg("plain"));
+  if (error) {
+    LOGW("❌ /stack JSON error: %s", error.c_str());
+    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+    return;
+  }
+
+  int id = doc["id"] | 0;
+  int idx = getServoIndex(id);
+  if (idx < 0) {
+    server.send(400, "application/json", "{\"error\":\"Invalid servo id (1-6)\"}");
+    return;
+  }
+
+  JsonArray list = doc["angles"];
+  if (list.isNull() || list.size() == 0) {
+    server.send(400, "application/json", "{\"error\":\"Missing angles\"}");
+    return;
+  }
+  if (list.size() > STACK_CAPACITY) {
+    server.send(413, "application/json", "{\"error\":\"More angles than stack capacity\"}");
+    return;
+  }
+
+  const char *policyName = doc["policy"] | "reject";
+  StackOverflowPolicy policy;
+  if (strcmp(policyName, "reject") == 0) {
+    policy = STACK_REJECT;
+  } else if (strcmp(policyName, "drop_oldest") == 0) {
+    policy = STACK_DROP_OLDEST;
+  } else {
+    server.send(400, "application/json", "{\"error\":\"Unknown policy\"}");
+    return;
+  }
+
+  int angles[STACK_CAPACITY];
+  int count = 0;
+  for (JsonVariant v : list) {
+    int angle = jsonAngleCdeg(v);
+    if (angle < 0) {
+      server.send(400, "application/json", "{\"error\":\"Angle out of range 0-180\"}");
+      return;
+    }
+    angles[count++] = angle;
+  }
+
+  int dropped = 0;
+  bool queued = enqueueStack(idx, angles, count, policy, &dropped);
+
+  StaticJsonDocument<192> reply;
+  reply["id"] = id;
+  reply["queued"] = queued ? count : 0;
+  reply["dropped"] = dropped;
+  reply["depth"] = stackDepth(idx);
+  reply["capacity"] = STACK_CAPACITY;
+  if (!queued) {
+    LOGW("⚠️ Stack %d full - rejected %d commands", id, count);
+    reply["error"] = "Stack full";
+    sendJson(reply, 429);
+    return;
+  }
+  if (dropped > 0) {
+    LOGW("⚠️ Stack %d overflow - dropped %d oldest commands", id, dropped);
+  }
+  sendJson(reply);
+}
+
+// Empty every servo stack without touching the current pose
+void handleStackClear() {
+  clearStacks();
+  server.send(200, "application/json", "{\"status\":\"cleared\"}");
+}
+
+// Packed binary sequence upload (POST /sequence.bin), decoded straight into the
+// step table as the body streams in - no String copy and no JSON document.
+//
+// Layout (little-endian):
+//   [0..1] magic 'S','Q'   [2] version (1-4)   [3] skill name length (0-63)
+//   [4..5] step count      [6..7] step duration in ms
+//   then the skill name bytes, then the steps.
+//
+// Versions 1 and 2 send every joint of every step: SERVO_COUNT angles in
+// servo id order (1-6). Version 1 angles are one byte, 0-180 degrees or 0xFF
+// to leave that servo as is; version 2 angles are u16 centidegrees, 0-18000 or
+// 0xFFFF.
+//
+// Versions 3 and 4 are delta encoded, so joints that don't move cost nothing:
+// each record starts with a byte whose bit 7 is clear for a keyframe, with
+// bits 0-5 marking the servo ids (bit 0 = id 1) whose new angles follow in id
+// order (degree bytes for 3, u16 centidegrees for 4), or set for a run of
+// 1-127 steps (bits 0-6) that hold the pose. The step count in the header
+// counts held steps, so the timeline is the same as the full encoding's.
+//
+// With ?pipeline=1 the job starts as soon as the first step has been decoded
+// instead of after the whole body, so time to first motion no longer grows
+// with the sequence, and the step count may go up to MAX_PIPELINED_STEPS.
+// The body read stalls whenever the executor is a full table behind (see
+// motion_core.h), so for such long jobs the HTTP server is held until
+// playback is near the end. The stream port, WiFi supervision and the face
+// link keep being serviced meanwhile, so the job can still be aborted with a
+// UDP 'SA' datagram, a long press on the face or by closing the connection.
+// A bad step, or an executor that stops freeing slots, ends a pipelined job
+// that is already playing.
+static const uint8_t BIN_SEQ_MAGIC_0 = 'S';
+static const uint8_t BIN_SEQ_MAGIC_1 = 'Q';
+static const uint8_t BIN_SEQ_VERSION_DEG = 1;
+static const uint8_t BIN_SEQ_VERSION_CDEG = 2;
+static const uint8_t BIN_SEQ_VERSION_DELTA_DEG = 3;
+static const uint8_t BIN_SEQ_VERSION_DELTA_CDEG = 4;
+static const uint8_t BIN_SEQ_HOLD_RUN = 0x80;  // delta record: bits 0-6 are a hold count
+static const size_t BIN_SEQ_HEADER_SIZE = 8;
+static const size_t BIN_SEQ_MAX_NAME = 63;
+static const unsigned long SEQUENCE_SLOT_WAIT_SLACK_MS = 500; // beyond two steps, see waitForSequenceSlot()
+static const uint8_t BIN_SEQ_HOLD = 0xFF;
+static const uint16_t BIN_SEQ_HOLD_CDEG = 0xFFFF;
+
+struct BinarySequenceUpload {
+  uint8_t header[BIN_SEQ_HEADER_SIZE];
+  char name[BIN_SEQ_MAX_NAME + 1];
+  size_t received;     // body bytes consumed so far
+  size_t expected;     // body size implied by the header (0 until known); an upper bound when delta
+  uint8_t nameLen;
+  uint8_t angleBytes;  // 1 for versions 1 and 3, 2 for versions 2 and 4
+  uint8_t lowByte;     // first half of a u16 angle
+  bool delta;          // versions 3 and 4
+  uint8_t deltaMask;   // delta: servo id bits whose angles are still to come
+  bool deltaHigh;      // delta: lowByte holds the first half of the current angle
+  uint16_t stepCount;
+  uint16_t stepsDecoded;
+  uint16_t stepMs;
+  bool storeSteps;     // decode into sequenceSteps, or only validate (skill cache uploads)
+  bool pipelined;      // play while the body is still arriving
+  bool started;        // pipelined job has been queued
+  bool timed;          // pipelined: ?start_at_ms= was given
+  unsigned long startAt;
+  uint32_t jobId;
+  int64_t beganUs;     // esp_timer_get_time() at the first body chunk
+  uint32_t firstStepUs;  // pipelined: body start to job start
+  uint32_t stalledUs;    // pipelined: time the body read waited for the executor
+  bool waiting;          // pipelined: inside waitForSequenceSlot()
+  int errorStatus;     // 0 while the upload is valid, otherwise the HTTP status to reply with
+  const char* error;
+};
+
+BinarySequenceUpload binUpload;
+
+void failBinaryUpload(int status, const char* error) {
+  if (binUpload.errorStatus == 0) {
+    binUpload.errorStatus = status;
+    binUpload.error = error;
+  }
+}
+
+// Optional ?start_at_ms= (device millis) for a synchronised start; false if
+// it is present but out of range
+bool parseStartAtArg(bool *timed, unsigned long *startAt) {
+  *timed = server.hasArg("start_at_ms");
+  if (!*timed) return true;
+  *startAt = strtoul(server.arg("start_at_ms").c_str(), nullptr, 10);
+  return validStartAt(*startAt);
+}
+
+void resetBinaryUpload(bool storeSteps = true, bool pipelined = false) {
+  memset(&binUpload, 0, sizeof(binUpload));
+  binUpload.storeSteps = storeSteps;
+  binUpload.pipelined = pipelined;
+  binUpload.beganUs = esp_timer_get_time();
+  if (storeSteps && sequenceBusy()) {
+    failBinaryUpload(409, "Sequence already running");
+    return;
+  }
+  if (pipelined) {
+    if (!parseStartAtArg(&binUpload.timed, &binUpload.startAt)) {
+      failBinaryUpload(400, "start_at_ms out of range");
+      return;
+    }
+    sequencePipelineBegin();
+  }
+}
+
+// Validate the fixed header once all of its bytes have arrived
+void parseBinaryHeader() {
+  const uint8_t *h = binUpload.header;
+  if (h[0] != BIN_SEQ_MAGIC_0 || h[1] != BIN_SEQ_MAGIC_1) {
+    failBinaryUpload(400, "Bad magic");
+    return;
+  }
+  if (h[2] < BIN_SEQ_VERSION_DEG || h[2] > BIN_SEQ_VERSION_DELTA_CDEG) {
+    failBinaryUpload(400, "Unsupported version");
+    return;
+  }
+  binUpload.delta = h[2] >= BIN_SEQ_VERSION_DELTA_DEG;
+  binUpload.angleBytes = (h[2] == BIN_SEQ_VERSION_CDEG || h[2] == BIN_SEQ_VERSION_DELTA_CDEG) ? 2 : 1;
+  binUpload.nameLen = h[3];
+  binUpload.stepCount = (uint16_t)(h[4] | (h[5] << 8));
+  binUpload.stepMs = (uint16_t)(h[6] | (h[7] << 8));
+
+  if (binUpload.nameLen > BIN_SEQ_MAX_NAME) {
+    failBinaryUpload(400, "Skill name too long");
+  } else if (binUpload.stepCount > MAX_SEQUENCE_STEPS && !binUpload.pipelined) {
+    failBinaryUpload(413, "Too many steps");
+  } else if (binUpload.stepMs < MIN_STEP_DURATION_MS || binUpload.stepMs > MAX_STEP_DURATION_MS) {
+    failBinaryUpload(400, "step_ms out of range");
+  }
+  // A delta body is at most one record byte more per step than the full one
+  binUpload.expected = BIN_SEQ_HEADER_SIZE + binUpload.nameLen +
+                       (size_t)binUpload.stepCount * (SERVO_COUNT * binUpload.angleBytes + (binUpload.delta ? 1 : 0));
+}
+
+void serviceSideChannels();
+
+// Backpressure for pipelined uploads: hold the body read until the executor
+// has played the step that last used this slot. The rest of the network loop
+// keeps running meanwhile (see serviceSideChannels()), so the abort paths stay
+// live. Fails if the job ends first, or if it runs for two steps plus
+// SEQUENCE_SLOT_WAIT_SLACK_MS without freeing the slot; waiting for a
+// scheduled start does not count.
+bool waitForSequenceSlot(int step) {
+  if (sequenceSlotFree(step)) return true;
+  int64_t t0 = esp_timer_get_time();
+  const unsigned long limitMs = 2 * binUpload.stepMs + SEQUENCE_SLOT_WAIT_SLACK_MS;
+  unsigned long runningSince = millis();
+  bool ok = true;
+  binUpload.waiting = true;
+  while (!sequenceSlotFree(step)) {
+    if (!sequenceBusy()) {
+      failBinaryUpload(409, "Sequence stopped during upload");
+      ok = false;
+      break;
+    }
+    unsigned long now = millis();
+    if (sequenceState == SEQ_SCHEDULED) {
+      runningSince = now;
+    } else if (now - runningSince >= limitMs) {
+      LOGE("❌ Sequence job %u: step %d never freed a slot", (unsigned)binUpload.jobId, step + 1);
+      failBinaryUpload(503, "Sequence executor stalled");
+      ok = false;
+      break;
+    }
+    serviceSideChannels();
+    vTaskDelay(pdMS_TO_TICKS(CONTROL_TICK_MS));
+  }
+  binUpload.waiting = false;
+  if (!ok) return false;
+  binUpload.stalledUs += (uint32_t)(esp_timer_get_time() - t0);
+  return true;
+}
+
+// A pipelined step is complete: make it playable, and start the job on the first
+void publishPipelinedStep(int step) {
+  sequencePublishSteps(step + 1);
+  if (binUpload.started) return;
+  binUpload.name[binUpload.nameLen] = '\0';
+  const char *skill = binUpload.nameLen > 0 ? binUpload.name : "Unknown Skill";
+  binUpload.jobId = startSequence(skill, binUpload.stepCount, binUpload.stepMs, defaultProfile, binUpload.timed,
+                                  binUpload.startAt, true);
+  if (binUpload.jobId == 0) {
+    failBinaryUpload(503, "Motion queue full");
+    return;
+  }
+  binUpload.started = true;
+  binUpload.firstStepUs = (uint32_t)(esp_timer_get_time() - binUpload.beganUs);
+}
+
+// Step writers shared by both encodings; with storeSteps clear (skill cache
+// uploads) the body is only validated. beginUploadStep() is false if the
+// upload failed waiting for the step's slot.
+bool beginUploadStep(int step) {
+  if (!binUpload.storeSteps) return true;
+  if (binUpload.pipelined && !waitForSequenceSlot(step)) return false;
+  sequenceSlot(step).mask = 0;
+  return true;
+}
+
+void setUploadAngle(int step, int servoId, int cdeg) {
+  if (!binUpload.storeSteps) return;
+  SequenceStep &entry = sequenceSlot(step);
+  int idx = getServoIndex(servoId);
+  entry.angles[idx] = (uint16_t)cdeg;
+  entry.mask |= (1 << idx);
+}
+
+void endUploadStep(int step) {
+  binUpload.stepsDecoded = (uint16_t)(step + 1);
+  if (binUpload.storeSteps && binUpload.pipelined) publishPipelinedStep(step);
+}
+
+// Versions 3 and 4, one byte of the step records
+void feedDeltaByte(uint8_t b) {
+  int step = binUpload.stepsDecoded;
+  if (binUpload.deltaMask == 0) {
+    if (step >= binUpload.stepCount) {
+      failBinaryUpload(400, "Body longer than header");
+      return;
+    }
+    if (b & BIN_SEQ_HOLD_RUN) {
+      int run = b & ~BIN_SEQ_HOLD_RUN;
+      if (run == 0 || step + run > binUpload.stepCount) {
+        failBinaryUpload(400, "Bad hold run");
+        return;
+      }
+      for (int n = step; n < step + run && binUpload.errorStatus == 0; ++n) {
+        if (beginUploadStep(n)) endUploadStep(n);
       }
+      return;
+    }
+    if (b >> SERVO_COUNT) {
+      failBinaryUpload(400, "Bad joint mask");
+      return;
+    }
+    if (!beginUploadStep(step)) return;
+    binUpload.deltaMask = b;
+    if (b == 0) endUploadStep(step);
+    return;
+  }
+
+  int cdeg;
+  if (binUpload.angleBytes == 2) {
+    if (!binUpload.deltaHigh) {
+      binUpload.lowByte = b;
+      binUpload.deltaHigh = true;
+      return;
     }
+    binUpload.deltaHigh = false;
+    cdeg = binUpload.lowByte | (b << 8);
+  } else {
+    cdeg = b * CDEG_PER_DEG;
+  }
+  if (cdeg > MAX_ANGLE_CDEG) {
+    failBinaryUpload(400, "Angle out of range");
+    return;
   }
+  int bit = __builtin_ctz(binUpload.deltaMask);
+  setUploadAngle(step, bit + 1, cdeg);
+  binUpload.deltaMask &= (uint8_t)(binUpload.deltaMask - 1);
+  if (binUpload.deltaMask == 0) endUploadStep(step);
 }
 
-void handleNotFound() {
-  server.send(404, "application/json", "{\"error\":\"Not found\"}");
+void feedBinaryUpload(const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len && binUpload.errorStatus == 0; ++i) {
+    size_t pos = binUpload.received++;
+    uint8_t b = data[i];
+
+    if (pos < BIN_SEQ_HEADER_SIZE) {
+      binUpload.header[pos] = b;
+      if (pos == BIN_SEQ_HEADER_SIZE - 1) parseBinaryHeader();
+      continue;
+    }
+    pos -= BIN_SEQ_HEADER_SIZE;
+    if (pos < binUpload.nameLen) {
+      binUpload.name[pos] = (char)b;
+      continue;
+    }
+    pos -= binUpload.nameLen;
+    if (binUpload.delta) {
+      feedDeltaByte(b);
+      continue;
+    }
+
+    size_t stepBytes = (size_t)SERVO_COUNT * binUpload.angleBytes;
+    size_t stepIndex = pos / stepBytes;
+    size_t angleIndex = (pos % stepBytes) / binUpload.angleBytes;
+    if (stepIndex >= binUpload.stepCount) {
+      failBinaryUpload(400, "Body longer than header");
+      return;
+    }
+    int cdeg;
+    if (binUpload.angleBytes == 2) {
+      if (pos % 2 == 0) {
+        binUpload.lowByte = b;
+        continue;
+      }
+      uint16_t v = (uint16_t)(binUpload.lowByte | (b << 8));
+      cdeg = v == BIN_SEQ_HOLD_CDEG ? -1 : v;
+    } else {
+      cdeg = b == BIN_SEQ_HOLD ? -1 : b * CDEG_PER_DEG;
+    }
+    if (cdeg > MAX_ANGLE_CDEG) {
+      failBinaryUpload(400, "Angle out of range");
+      return;
+    }
+    if (angleIndex == 0 && !beginUploadStep((int)stepIndex)) return;
+    if (cdeg >= 0) setUploadAngle((int)stepIndex, (int)angleIndex + 1, cdeg);
+    if (angleIndex == SERVO_COUNT - 1) endUploadStep((int)stepIndex);
+  }
 }
 
-void handleCalibrate() {
-  Serial.println("🛠 POST /calibrate - neutralizing servos, clearing stacks and batch");
+// Body chunks for /sequence.bin
+void handleSequenceBinaryUpload() {
+  HTTPRaw &raw = server.raw();
+  if (raw.status == RAW_START) {
+    resetBinaryUpload(true, server.hasArg("pipeline") && server.arg("pipeline") != "0");
+  } else if (raw.status == RAW_WRITE) {
+    feedBinaryUpload(raw.buf, raw.currentSize);
+  } else if (raw.status == RAW_ABORTED) {
+    failBinaryUpload(400, "Upload aborted");
+    if (binUpload.started) requestSequenceAbort();
+  }
+}
 
-  // Clear batch
-  initializeBatch();
+// parseStartAtArg() for handlers: replies 400 and returns false if out of range
+bool readStartAtArg(bool *timed, unsigned long *startAt) {
+  if (parseStartAtArg(timed, startAt)) return true;
+  server.send(400, "application/json", "{\"error\":\"start_at_ms out of range\"}");
+  return false;
+}
 
-  // Clear all stacks
-  for (int i = 0; i < SERVO_COUNT; ++i) {
-    while (!servoStacks[i].empty()) {
-      servoStacks[i].pop();
+// Check the decoder saw a whole body; sets binUpload.error otherwise
+bool binaryUploadComplete() {
+  if (binUpload.errorStatus == 0 && binUpload.received < BIN_SEQ_HEADER_SIZE) {
+    failBinaryUpload(400, "Missing header");
+  }
+  bool complete = binUpload.delta ? binUpload.stepsDecoded == binUpload.stepCount && binUpload.deltaMask == 0
+                                  : binUpload.received == binUpload.expected;
+  if (binUpload.errorStatus == 0 && !complete) {
+    failBinaryUpload(400, "Truncated body");
+  }
+  if (binUpload.errorStatus != 0) return false;
+  binUpload.name[binUpload.nameLen] = '\0';
+  return true;
+}
+
+// binaryUploadComplete(), answering the request with the error when it fails
+bool finishBinaryUpload() {
+  if (!binaryUploadComplete()) {
+    LOGW("❌ Binary sequence rejected: %s", binUpload.error);
+    StaticJsonDocument<128> err;
+    err["error"] = binUpload.error;
+    if (binUpload.errorStatus == 409) err["job_id"] = sequenceJobId;
+    sendJson(err, binUpload.errorStatus);
+    return false;
+  }
+  return true;
+}
+
+// Called once the whole /sequence.bin body has been fed to the decoder
+void handleSequenceBinary() {
+  LOGI("📡 POST /sequence.bin - Binary sequence received from %s (%u bytes)",
+       server.client().remoteIP().toString().c_str(), (unsigned)binUpload.received);
+
+  if (!finishBinaryUpload()) {
+    if (binUpload.started) requestSequenceAbort(); // the rest of the steps are not coming
+    return;
+  }
+  String skill = binUpload.nameLen > 0 ? String(binUpload.name) : String("Unknown Skill");
+  bool timed = binUpload.timed;
+  unsigned long startAt = binUpload.startAt;
+  uint32_t jobId = binUpload.jobId;
+  if (!binUpload.started) {
+    if (!binUpload.pipelined && !readStartAtArg(&timed, &startAt)) return;
+    jobId = startSequence(skill.c_str(), binUpload.stepCount, binUpload.stepMs, defaultProfile, timed, startAt);
+    if (jobId == 0) {
+      server.send(503, "application/json", "{\"error\":\"Motion queue full\"}");
+      return;
+    }
+  }
+
+  StaticJsonDocument<384> resp;
+  resp["status"] = "accepted";
+  resp["job_id"] = jobId;
+  resp["skill"] = skill;
+  resp["steps"] = binUpload.stepCount;
+  resp["step_ms"] = binUpload.stepMs;
+  resp["estimated_duration_ms"] = (unsigned long)binUpload.stepCount * binUpload.stepMs;
+  if (timed) resp["start_at_ms"] = startAt;
+  resp["body_size"] = binUpload.received;
+  if (binUpload.started) {
+    resp["pipelined"] = true;
+    resp["first_step_after_us"] = binUpload.firstStepUs;
+    resp["stalled_us"] = binUpload.stalledUs;
+  }
+  sendJson(resp, 202);
+}
+
+// Skill cache - POST /skills/<name> stores a /sequence.bin body in flash (it
+// is validated as it streams to the file); POST /play/<key> replays it with
+// no body. GET /skills lists the cache, GET /skills/<key> checks for one
+// entry and DELETE /skills/<name> drops it. Stores and deletes answer 409
+// while a sequence plays: a LittleFS write stalls both cores mid-playback.
+// A key is a skill name or the 8-hex-digit content CRC-32 of the stored body
+// without its name (see skill_cache.h), so the backend can skip uploads of
+// motions the robot already has under any name.
+struct SkillUpload {
+  char name[SKILL_NAME_MAX + 1];
+  bool reserved;  // flash space has been made for the size given in the header
+};
+
+SkillUpload skillUpload;
+
+// Percent-decode a URL path segment into out; false if empty or too long
+bool decodeSkillName(const String &segment, char *out, size_t outSize) {
+  size_t len = 0;
+  const char *s = segment.c_str();
+  for (size_t i = 0; s[i] != '\0'; ++i) {
+    char c = s[i];
+    if (c == '%' && isxdigit((unsigned char)s[i + 1]) && isxdigit((unsigned char)s[i + 2])) {
+      char hex[3] = {s[i + 1], s[i + 2], '\0'};
+      c = (char)strtol(hex, nullptr, 16);
+      i += 2;
+    } else if (c == '+') {
+      c = ' ';
+    }
+    if (len + 1 >= outSize) return false;
+    out[len++] = c;
+  }
+  out[len] = '\0';
+  return len > 0;
+}
+
+// Look a skill up by name, falling back to its content CRC
+const SkillCacheEntry *resolveSkill(const char *key) {
+  const SkillCacheEntry *entry = skillCacheFind(key);
+  if (entry || strlen(key) != 8) return entry;
+  char *end;
+  uint32_t crc = (uint32_t)strtoul(key, &end, 16);
+  return *end == '\0' ? skillCacheFindByCrc(crc) : nullptr;
+}
+
+void fillSkillEntry(JsonObject o, const SkillCacheEntry *entry) {
+  char crc[9];
+  snprintf(crc, sizeof(crc), "%08x", (unsigned)entry->crc);
+  o["name"] = (const char *)entry->name;
+  o["crc"] = crc; // copied by ArduinoJson
+  o["size"] = entry->size;
+  o["last_used"] = entry->lastUsed;
+}
+
+// Body chunks for POST /skills/<name>
+void handleSkillUpload() {
+  HTTPRaw &raw = server.raw();
+  if (raw.status == RAW_START) {
+    resetBinaryUpload(false);
+    skillUpload.reserved = false;
+    if (!skillCacheReady()) {
+      failBinaryUpload(503, "Skill cache unavailable");
+    } else if (sequenceBusy()) {
+      failBinaryUpload(409, "Sequence running; store skills while idle");
+    } else if (!decodeSkillName(server.pathArg(0), skillUpload.name, sizeof(skillUpload.name))) {
+      failBinaryUpload(400, "Bad skill name");
+    } else if (!skillCacheBeginWrite(skillUpload.name)) {
+      failBinaryUpload(507, "Cannot create skill file");
+    }
+  } else if (raw.status == RAW_WRITE) {
+    if (binUpload.errorStatus != 0) return;
+    feedBinaryUpload(raw.buf, raw.currentSize);
+    // Make room as soon as the header says how big the file will be (at most, for delta bodies)
+    if (binUpload.errorStatus == 0 && binUpload.expected > 0 && !skillUpload.reserved) {
+      skillUpload.reserved = true;
+      if (!skillCacheReserve(binUpload.expected)) failBinaryUpload(507, "Skill cache full");
+    }
+    if (binUpload.errorStatus == 0 && !skillCacheWrite(raw.buf, raw.currentSize)) {
+      failBinaryUpload(507, "Flash write failed");
     }
+  } else if (raw.status == RAW_ABORTED) {
+    failBinaryUpload(400, "Upload aborted");
   }
+}
+
+// Called once the whole skill body has been written to the temp file
+void handleSkillStore() {
+  LOGI("📡 POST /skills/%s - %u bytes", skillUpload.name, (unsigned)binUpload.received);
+  if (!finishBinaryUpload()) {
+    skillCacheAbortWrite();
+    return;
+  }
+  if (!skillCacheCommit()) {
+    server.send(507, "application/json", "{\"error\":\"Flash write failed\"}");
+    return;
+  }
+
+  char crc[9];
+  snprintf(crc, sizeof(crc), "%08x", (unsigned)skillCacheFind(skillUpload.name)->crc);
+
+  StaticJsonDocument<256> resp;
+  resp["status"] = "stored";
+  resp["skill"] = skillUpload.name;
+  resp["crc"] = crc;
+  resp["steps"] = binUpload.stepCount;
+  resp["step_ms"] = binUpload.stepMs;
+  resp["size"] = binUpload.received;
+  resp["cached"] = skillCacheCount();
+  resp["free_bytes"] = skillCacheFreeBytes();
+  sendJson(resp, 201);
+}
 
-  // Set all servos to neutral with angle adjustment
-  for(int i=0;i<SERVO_COUNT;++i){
-    int adjustedAngle = adjustAngleForServo(i, 90);
-    servos[i].write(adjustedAngle);
-    currentAngles[i]=90;
+// Run a cached skill's file through the binary decoder into the sequence
+// table. An unreadable file is removed; binUpload.error says why.
+bool decodeCachedSkill(const char *name, File &file) {
+  resetBinaryUpload(true);
+  uint8_t chunk[256];
+  size_t n;
+  while (binUpload.errorStatus == 0 && (n = file.read(chunk, sizeof(chunk))) > 0) {
+    feedBinaryUpload(chunk, n);
   }
+  file.close();
+  if (!binaryUploadComplete()) {
+    LOGE("❌ Cached skill '%s' is unreadable (%s) - removing it", name, binUpload.error);
+    skillCacheRemove(name);
+    return false;
+  }
+  return true;
+}
+
+// Replay a cached skill - the only traffic is this request line
+void handlePlaySkill() {
+  char key[SKILL_NAME_MAX + 1];
+  if (!decodeSkillName(server.pathArg(0), key, sizeof(key))) {
+    server.send(400, "application/json", "{\"error\":\"Bad skill name\"}");
+    return;
+  }
+  LOGI("📡 POST /play/%s", key);
+  bool timed;
+  unsigned long startAt = 0;
+  if (!readStartAtArg(&timed, &startAt)) return;
+  if (!skillCacheReady()) {
+    server.send(503, "application/json", "{\"error\":\"Skill cache unavailable\"}");
+    return;
+  }
+  if (sequenceBusy()) {
+    StaticJsonDocument<128> busy;
+    busy["error"] = "Sequence already running";
+    busy["job_id"] = sequenceJobId;
+    sendJson(busy, 409);
+    return;
+  }
+  const SkillCacheEntry *entry = resolveSkill(key);
+  char name[SKILL_NAME_MAX + 1];
+  strcpy(name, entry ? entry->name : key);
+  File file = skillCacheOpen(name);
+  if (!file) {
+    server.send(404, "application/json", "{\"error\":\"Skill not cached\"}");
+    return;
+  }
+
+  if (!decodeCachedSkill(name, file)) {
+    finishBinaryUpload();
+    return;
+  }
+
+  uint32_t jobId = startSequence(name, binUpload.stepCount, binUpload.stepMs, defaultProfile, timed, startAt);
+  if (jobId == 0) {
+    server.send(503, "application/json", "{\"error\":\"Motion queue full\"}");
+    return;
+  }
+
+  StaticJsonDocument<256> resp;
+  resp["status"] = "accepted";
+  resp["job_id"] = jobId;
+  resp["skill"] = name;
+  resp["steps"] = binUpload.stepCount;
+  resp["step_ms"] = binUpload.stepMs;
+  resp["estimated_duration_ms"] = (unsigned long)binUpload.stepCount * binUpload.stepMs;
+  if (timed) resp["start_at_ms"] = startAt;
+  sendJson(resp, 202);
+}
+
+// Touch on the monkey face: a tap replays the most recently used cached
+// skill, a long press stops whatever is playing
+void onFaceEvent(uint8_t event, uint8_t arg) {
+  if (event == FACE_EVT_HOLD) {
+    LOGI("🐵 Face long-press - aborting playback");
+    requestSequenceAbort();
+    return;
+  }
+  if (event != FACE_EVT_TAP) return;
+  // A tap replay reuses binUpload, so not while an upload is waiting on the executor
+  if (!skillCacheReady() || sequenceBusy() || binUpload.waiting) {
+    faceLinkSend(FACE_OP_BLINK);
+    return;
+  }
+  const SkillCacheEntry *latest = nullptr;
+  for (size_t i = 0; i < skillCacheCount(); ++i) {
+    const SkillCacheEntry *entry = skillCacheEntryAt(i);
+    if (!latest || entry->lastUsed > latest->lastUsed) latest = entry;
+  }
+  if (!latest) {
+    faceLinkSend(FACE_OP_REACT, FACE_EXPR_SURPRISE);
+    return;
+  }
+  char name[SKILL_NAME_MAX + 1];
+  strcpy(name, latest->name);
+  LOGI("🐵 Face tap (zone %u) - replaying '%s'", arg, name);
+  File file = skillCacheOpen(name);
+  if (!file || !decodeCachedSkill(name, file)) return;
+  if (startSequence(name, binUpload.stepCount, binUpload.stepMs, defaultProfile) == 0) {
+    LOGW("⚠️ Face tap replay dropped: motion queue full");
+  }
+}
+
+void handleSkillList() {
+  ArenaJsonDocument doc(256 + SKILL_CACHE_MAX_ENTRIES * (SKILL_NAME_MAX + 96));
+  doc["ready"] = skillCacheReady();
+  doc["free_bytes"] = skillCacheFreeBytes();
+  doc["capacity"] = SKILL_CACHE_MAX_ENTRIES;
+  doc["evictions"] = skillCacheEvictions();
+  JsonArray list = doc.createNestedArray("skills");
+  for (size_t i = 0; i < skillCacheCount(); ++i) {
+    const SkillCacheEntry *entry = skillCacheEntryAt(i);
+    fillSkillEntry(list.createNestedObject(), entry);
+  }
+  sendJson(doc);
+}
+
+// Cheap presence check before an upload: 200 with the entry, or 404
+void handleSkillLookup() {
+  char key[SKILL_NAME_MAX + 1];
+  if (!decodeSkillName(server.pathArg(0), key, sizeof(key))) {
+    server.send(400, "application/json", "{\"error\":\"Bad skill name\"}");
+    return;
+  }
+  const SkillCacheEntry *entry = resolveSkill(key);
+  if (!entry) {
+    server.send(404, "application/json", "{\"error\":\"Skill not cached\"}");
+    return;
+  }
+  StaticJsonDocument<256> doc;
+  fillSkillEntry(doc.to<JsonObject>(), entry);
+  sendJson(doc);
+}
+
+void handleSkillDelete() {
+  char name[SKILL_NAME_MAX + 1];
+  if (!decodeSkillName(server.pathArg(0), name, sizeof(name))) {
+    server.send(400, "application/json", "{\"error\":\"Bad skill name\"}");
+    return;
+  }
+  if (sequenceBusy()) {
+    server.send(409, "application/json", "{\"error\":\"Sequence running; delete skills while idle\"}");
+    return;
+  }
+  if (!skillCacheRemove(name)) {
+    server.send(404, "application/json", "{\"error\":\"Skill not cached\"}");
+    return;
+  }
+  server.send(200, "application/json", "{\"status\":\"deleted\"}");
+}
+
+// Control tick - an esp_timer fires every CONTROL_TICK_MS and wakes a task
+// pinned to core 1 that owns the planner, sequence playback, scheduled frame
+// and stacks, so servo timing never depends on what the network task is doing
+//
+// The task is subscribed to the task watchdog and feeds it every tick. If the
+// tick stops (a dead timer, or the motion task spinning on the stack lock
+// held by a hung network task) the chip panics and reboots rather than leave
+// the servos frozen on their last duty. The same timeout covers IDLE0, which
+// a network task that never yields would starve.
+static const BaseType_t MOTION_TASK_CORE = 1;
+static const UBaseType_t MOTION_TASK_PRIORITY = 10; // above loopTask (1), the only other user of core 1
+static const uint32_t MOTION_TASK_STACK = 4096;
+static const uint32_t MOTION_WDT_TIMEOUT_S = 3; // well above a flash erase stalling both cores
+
+TaskHandle_t motionTaskHandle = nullptr;
+esp_timer_handle_t controlTimer = nullptr;
+
+void onControlTimer(void*) {
+  xTaskNotifyGive(motionTaskHandle);
+}
+
+void motionTask(void*) {
+  esp_task_wdt_add(nullptr);
+  int64_t lastWake = 0;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    esp_task_wdt_reset();
+    int64_t wake = esp_timer_get_time();
+    if (lastWake != 0) {
+      int64_t drift = (wake - lastWake) - (int64_t)CONTROL_TICK_MS * 1000;
+      metricsRecord(METRIC_TICK_JITTER, (uint32_t)(drift < 0 ? -drift : drift));
+    }
+    lastWake = wake;
+
+    motionTick();
+#if ROBOT_FEEDBACK
+    feedbackTick(); // Compare measured joints with what the planner just wrote
+#endif
+    metricsRecord(METRIC_TICK_BUSY, (uint32_t)(esp_timer_get_time() - wake));
+  }
+}
+
+void setupMotion() {
+  Serial.println("=== Motion Task Setup Starting ===");
+  esp_task_wdt_init(MOTION_WDT_TIMEOUT_S, true); // reconfigures the TWDT the core already started
+  xTaskCreatePinnedToCore(motionTask, "motion", MOTION_TASK_STACK, nullptr,
+                          MOTION_TASK_PRIORITY, &motionTaskHandle, MOTION_TASK_CORE);
+
+  esp_timer_create_args_t timerArgs = {};
+  timerArgs.callback = onControlTimer;
+  timerArgs.name = "control_tick";
+  esp_timer_create(&timerArgs, &controlTimer);
+  esp_timer_start_periodic(controlTimer, CONTROL_TICK_MS * 1000ULL);
+
+  Serial.print("✅ Control tick every ");
+  Serial.print(CONTROL_TICK_MS);
+  Serial.print("ms driving the motion task on core ");
+  Serial.println(MOTION_TASK_CORE);
+  Serial.println("=== Motion Task Setup Complete ===");
+}
+
+// WiFi link supervisor. setupWiFi() only starts a connect; maintainWiFi()
+// runs on the network task and takes it from there. A fast attempt from the
+// NVS cache falls back to a scan + DHCP connect if it has not come up in
+// time, and a dropped link is retried with backoff. The driver's own
+// auto-reconnect usually wins first; the retries cover the cases where it
+// gives up. Nothing reboots the board any more.
+enum WiFiLinkState { WIFI_LINK_FAST, WIFI_LINK_CONNECTING, WIFI_LINK_UP };
+static const unsigned long WIFI_FAST_CONNECT_TIMEOUT_MS = 4000;
+static const unsigned long WIFI_RETRY_MIN_MS = 5000;
+static const unsigned long WIFI_RETRY_MAX_MS = 60000;
+
+// Link drops and re-associations after the first connect
+volatile uint32_t wifiDisconnects = 0;
+volatile uint32_t wifiReconnects = 0;
+volatile bool wifiGotIp = false; // set on the event task, consumed by maintainWiFi()
+bool wifiEverConnected = false;
+
+WiFiLinkState wifiLinkState = WIFI_LINK_CONNECTING;
+unsigned long wifiAttemptStart = 0;
+unsigned long wifiRetryMs = WIFI_RETRY_MIN_MS;
+bool wifiCachedConnect = false; // this boot's first attempt used the cache
+unsigned long wifiUpMs = 0;     // millis() at the first connect, 0 until then
+
+void onWiFiDisconnected(WiFiEvent_t, WiFiEventInfo_t) {
+  if (wifiEverConnected) wifiDisconnects++;
+}
+
+void onWiFiGotIp(WiFiEvent_t, WiFiEventInfo_t) {
+  if (wifiEverConnected) wifiReconnects++;
+  wifiEverConnected = true;
+  wifiGotIp = true;
+}
+
+// Connect to the cached BSSID/channel with its address, or scan and use DHCP
+void beginWiFiConnect(const WiFiCache *cache) {
+  if (cache) {
+    WiFi.config(IPAddress(cache->ip), IPAddress(cache->gateway), IPAddress(cache->subnet),
+                IPAddress(cache->dns));
+    WiFi.begin(WIFI_SSID, WIFI_PASS, cache->channel, cache->bssid);
+  } else {
+    WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+    WiFi.begin(WIFI_SSID, WIFI_PASS);
+  }
+  wifiLinkState = cache ? WIFI_LINK_FAST : WIFI_LINK_CONNECTING;
+  wifiAttemptStart = millis();
+}
+
+void onWiFiLinkUp(unsigned long now) {
+  if (wifiUpMs == 0) wifiUpMs = now;
+  wifiLinkState = WIFI_LINK_UP;
+  wifiRetryMs = WIFI_RETRY_MIN_MS;
+
+  const uint8_t *bssid = WiFi.BSSID();
+  if (bssid) {
+    WiFiCache cache = {};
+    memcpy(cache.bssid, bssid, sizeof(cache.bssid));
+    cache.channel = (uint8_t)WiFi.channel();
+    cache.ip = (uint32_t)WiFi.localIP();
+    cache.gateway = (uint32_t)WiFi.gatewayIP();
+    cache.subnet = (uint32_t)WiFi.subnetMask();
+    cache.dns = (uint32_t)WiFi.dnsIP();
+    wifiCacheStore(cache);
+  }
+  LOGI("📶 WiFi up: %s on channel %d, %d dBm", WiFi.localIP().toString().c_str(), (int)WiFi.channel(),
+       (int)WiFi.RSSI());
+}
+
+void maintainWiFi() {
+  unsigned long now = millis();
+  if (wifiGotIp) {
+    wifiGotIp = false;
+    onWiFiLinkUp(now);
+  }
+  bool connected = WiFi.status() == WL_CONNECTED;
+  switch (wifiLinkState) {
+    case WIFI_LINK_UP:
+      if (!connected) {
+        wifiLinkState = WIFI_LINK_CONNECTING;
+        wifiAttemptStart = now;
+      }
+      break;
+    case WIFI_LINK_FAST:
+      if (!connected && now - wifiAttemptStart > WIFI_FAST_CONNECT_TIMEOUT_MS) {
+        LOGW("⚠️ Cached WiFi connect timed out, scanning with DHCP");
+        wifiCacheClear();
+        WiFi.disconnect();
+        beginWiFiConnect(nullptr);
+      }
+      break;
+    case WIFI_LINK_CONNECTING:
+      if (!connected && now - wifiAttemptStart > wifiRetryMs) {
+        LOGW("⚠️ WiFi still down after %lu ms, retrying", wifiRetryMs);
+        WiFi.disconnect();
+        beginWiFiConnect(nullptr);
+        wifiRetryMs = wifiRetryMs * 2 > WIFI_RETRY_MAX_MS ? WIFI_RETRY_MAX_MS : wifiRetryMs * 2;
+      }
+      break;
+  }
+}
+
+// Boot phase timings for GET /metrics: how long each setup step took and
+// when the robot was ready, so boot-time changes can be measured
+enum BootPhase { BOOT_SERVOS, BOOT_MOTION, BOOT_WIFI, BOOT_STORAGE, BOOT_SERVER, BOOT_PHASE_COUNT };
+static const char *const BOOT_PHASE_NAMES[BOOT_PHASE_COUNT] = {"servos", "motion", "wifi", "storage", "server"};
+uint32_t bootPhaseUs[BOOT_PHASE_COUNT];
+unsigned long bootReadyMs = 0; // millis() when setup() handed over to the tasks
+
+void runBootPhase(BootPhase phase, void (*setupFn)()) {
+  int64_t t0 = esp_timer_get_time();
+  setupFn();
+  bootPhaseUs[phase] = (uint32_t)(esp_timer_get_time() - t0);
+}
+
+const char *resetReasonName(esp_reset_reason_t reason) {
+  switch (reason) {
+    case ESP_RST_POWERON: return "power_on";
+    case ESP_RST_EXT: return "external";
+    case ESP_RST_SW: return "software";
+    case ESP_RST_PANIC: return "panic";
+    case ESP_RST_INT_WDT:
+    case ESP_RST_TASK_WDT:
+    case ESP_RST_WDT: return "watchdog";
+    case ESP_RST_DEEPSLEEP: return "deep_sleep";
+    case ESP_RST_BROWNOUT: return "brownout";
+    default: return "other";
+  }
+}
+
+// Instrumentation - GET /metrics reports the histograms from include/metrics.h
+// plus WiFi and heap health; POST /metrics/reset clears the histograms
+static const size_t METRICS_HISTOGRAM_JSON = JSON_OBJECT_SIZE(7) + JSON_ARRAY_SIZE(METRICS_BUCKETS);
+
+// Upper bound of the bucket holding the q-quantile (0 when it is the open-ended one)
+uint32_t histogramQuantileUs(const LatencyHistogram &h, float q) {
+  if (h.count == 0) return 0;
+  uint32_t rank = (uint32_t)(q * (h.count - 1)) + 1;
+  uint32_t seen = 0;
+  for (int b = 0; b < METRICS_BUCKETS; ++b) {
+    seen += h.buckets[b];
+    if (seen >= rank) return metricsBucketUpperUs(b);
+  }
+  return 0;
+}
+
+void fillHistogram(JsonObject o, const LatencyHistogram &h) {
+  o["count"] = h.count;
+  o["sum_us"] = h.sumUs;
+  o["max_us"] = h.maxUs;
+  o["mean_us"] = h.count ? (uint32_t)(h.sumUs / h.count) : 0;
+  o["p50_us"] = histogramQuantileUs(h, 0.50f);
+  o["p99_us"] = histogramQuantileUs(h, 0.99f);
+  // Trailing empty buckets are left out to keep the reply short
+  int last = METRICS_BUCKETS - 1;
+  while (last >= 0 && h.buckets[last] == 0) --last;
+  JsonArray buckets = o.createNestedArray("buckets");
+  for (int b = 0; b <= last; ++b) {
+    buckets.add(h.buckets[b]);
+  }
+}
+
+void handleMetrics() {
+  RequestScope scope; // untimed, so not covered by timedRoute()
+  ArenaJsonDocument doc(1728 + METRICS_BUCKETS * 16 +
+                          (METRICS_MAX_ROUTES + METRIC_SERIES_COUNT) * METRICS_HISTOGRAM_JSON);
+  doc["uptime_ms"] = millis();
+  JsonArray bounds = doc.createNestedArray("bucket_upper_us");
+  for (int b = 0; b < METRICS_BUCKETS - 1; ++b) {
+    bounds.add(metricsBucketUpperUs(b));
+  }
+
+  JsonObject routes = doc.createNestedObject("routes");
+  for (int r = 0; r < metricsRouteCount(); ++r) {
+    fillHistogram(routes.createNestedObject(metricsRouteLabel(r)), metricsRoute(r));
+  }
+  JsonObject series = doc.createNestedObject("series");
+  for (int s = 0; s < METRIC_SERIES_COUNT; ++s) {
+    MetricsSeries id = (MetricsSeries)s;
+    fillHistogram(series.createNestedObject(metricsSeriesName(id)), metricsSeries(id));
+  }
+
+  JsonObject wifi = doc.createNestedObject("wifi");
+  wifi["connected"] = WiFi.status() == WL_CONNECTED;
+  wifi["rssi"] = WiFi.RSSI();
+  wifi["disconnects"] = wifiDisconnects;
+  wifi["reconnects"] = wifiReconnects;
+
+  JsonObject boot = doc.createNestedObject("boot");
+  boot["fast_boot"] = FAST_BOOT;
+  boot["reset_reason"] = resetReasonName(esp_reset_reason());
+  JsonObject phases = boot.createNestedObject("phases_us");
+  for (int p = 0; p < BOOT_PHASE_COUNT; ++p) {
+    phases[BOOT_PHASE_NAMES[p]] = bootPhaseUs[p];
+  }
+  boot["ready_ms"] = bootReadyMs;
+  boot["wifi_up_ms"] = wifiUpMs;
+  boot["wifi_cached_connect"] = wifiCachedConnect;
+
+  JsonObject heap = doc.createNestedObject("heap");
+  heap["free"] = ESP.getFreeHeap();
+  heap["min_free"] = ESP.getMinFreeHeap();
+  heap["largest_block"] = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+
+  JsonObject arena = doc.createNestedObject("request_arena");
+  arena["capacity"] = requestArenaCapacity();
+  arena["high_water"] = requestArenaHighWater();
+  arena["heap_fallbacks"] = requestArenaFallbacks();
+  arena["psram"] = requestArenaInPsram();
+
+  FaceLinkStats face = faceLinkStats();
+  JsonObject faceLink = doc.createNestedObject("face_link");
+  faceLink["seen"] = face.faceSeen;
+  faceLink["frames_sent"] = face.framesSent;
+  faceLink["frames_received"] = face.framesReceived;
+  faceLink["bad_frames"] = face.badFrames;
+
+  JsonObject watchdog = doc.createNestedObject("watchdog");
+  watchdog["stream_trips"] = streamWatchdogTrips;
+  watchdog["batch_timeouts"] = batchTimeouts;
+
+  doc["motion_queue_drops"] = motionQueueDrops;
+  doc["log_dropped"] = logDroppedCount();
+  sendJson(doc);
+}
+
+void handleMetricsReset() {
+  metricsReset();
+  server.send(200, "application/json", "{\"status\":\"reset\"}");
+}
+
+// Wraps a route handler so its run time lands in that route's histogram and
+// whatever it took from the request arena is released when it returns.
+// Upload callbacks are timed too, under their own label, once per chunk.
+WebServer::THandlerFunction timedRoute(const char *label, WebServer::THandlerFunction fn) {
+  int route = metricsRegisterRoute(label);
+  return [route, fn]() {
+    int64_t t0 = esp_timer_get_time();
+    {
+      RequestScope scope;
+      fn();
+    }
+    metricsRecordRoute(route, (uint32_t)(esp_timer_get_time() - t0));
+  };
+}
+
+#if ROBOT_LOG_RING
+// Dump the log ring buffer oldest-first as plain text
+void handleLogs() {
+  const char *first, *second;
+  size_t firstLen, secondLen;
+  logRingSnapshot(&first, &firstLen, &second, &secondLen);
+  server.setContentLength(firstLen + secondLen);
+  server.send(200, "text/plain", "");
+  if (firstLen) server.sendContent(first, firstLen);
+  if (secondLen) server.sendContent(second, secondLen);
+}
+#endif
+
+void handleNotFound() {
+  server.send(404, "application/json", "{\"error\":\"Not found\"}");
+}
+
+void handleCalibrate() {
+  LOGI("🛠 POST /calibrate - neutralizing servos, clearing stacks and batch");
+
+  // The motion task stops any sequence playback, clears the stacks and the
+  // scheduled frame, then eases to neutral
+  bool sequenceAborted = sequenceBusy();
+  MotionCommand cmd = {};
+  cmd.type = MOTION_CALIBRATE;
+  if (!postMotion(cmd)) {
+    server.send(503, "application/json", "{\"error\":\"Motion queue full\"}");
+    return;
+  }
+
+  // Clear batch
+  initializeBatch();
 
   StaticJsonDocument<256> doc;
   doc["status"]="calibrated";
@@ -493,6 +2150,7 @@ void handleCalibrate() {
   doc["neutral_angle"]=90;
   doc["stacks_cleared"]=true;
   doc["batch_cleared"]=true;
+  doc["sequence_aborted"]=sequenceAborted;
   JsonArray arr=doc.createNestedArray("angles");
   for(int i=0;i<SERVO_COUNT;++i) {
     arr.add(currentAngles[i]);
@@ -500,18 +2158,29 @@ void handleCalibrate() {
   doc["timestamp_ms"]=millis();
   sendJson(doc);
 
-  Serial.println("✅ Calibration complete - all stacks and batch cleared, servos at 90°");
+  LOGI("✅ Calibration complete - all stacks and batch cleared, servos easing to 90°");
 }
 
 void setupWiFi() {
   Serial.println("=== WiFi Setup Starting ===");
+  WiFi.persistent(false); // credentials live in this file; NVS holds only the cache
   WiFi.mode(WIFI_STA);
   Serial.println("WiFi mode set to STA (Station)");
+  WiFi.onEvent(onWiFiDisconnected, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+  WiFi.onEvent(onWiFiGotIp, ARDUINO_EVENT_WIFI_STA_GOT_IP);
 
   Serial.print("Connecting to WiFi network: ");
   Serial.println(WIFI_SSID);
 
-  WiFi.begin(WIFI_SSID, WIFI_PASS);
+  WiFiCache cache;
+  wifiCachedConnect = FAST_BOOT && wifiCacheLoad(&cache);
+  beginWiFiConnect(wifiCachedConnect ? &cache : nullptr);
+  if (FAST_BOOT) {
+    // The network task's maintainWiFi() finishes the connect and logs the IP
+    Serial.println(wifiCachedConnect ? "Connecting from the cached association in the background"
+                                     : "Connecting with DHCP in the background");
+    return;
+  }
   Serial.print("Connecting with DHCP");
 
   unsigned long startAttempt = millis();
@@ -542,9 +2211,8 @@ void setupWiFi() {
       Serial.println("\n❌ WiFi connection timeout after 20 seconds!");
       Serial.print("Final status: ");
       Serial.println(WiFi.status());
-      Serial.println("Rebooting ESP32...");
-      delay(2000);
-      ESP.restart();
+      Serial.println("Continuing boot; the network task keeps retrying in the background");
+      return;
     }
   }
 
@@ -572,14 +2240,16 @@ void setupWiFi() {
 }
 
 void setupServos() {
+  if (FAST_BOOT) {
+    // All channels in one pass, no per-servo logging or settle delay
+    for (int i = 0; i < SERVO_COUNT; ++i) {
+      halServoAttach(i);
+      motionInitJoint(i, 90 * CDEG_PER_DEG);
+    }
+    LOGI("✅ %d servos initialized at 90°", SERVO_COUNT);
+    return;
+  }
   Serial.println("=== Servo Setup Starting ===");
-  Serial.println("Allocating PWM timers...");
-
-  ESP32PWM::allocateTimer(0);
-  ESP32PWM::allocateTimer(1);
-  ESP32PWM::allocateTimer(2);
-  ESP32PWM::allocateTimer(3);
-  Serial.println("✅ PWM timers allocated");
 
   Serial.print("Initializing ");
   Serial.print(SERVO_COUNT);
@@ -589,26 +2259,19 @@ void setupServos() {
     Serial.print("  Servo ");
     Serial.print(i + 1);
     Serial.print(" -> Pin ");
-    Serial.print(SERVO_PINS[i]);
+    Serial.print(JOINTS[i].pin);
     Serial.print("...");
 
-    servos[i].setPeriodHertz(50);
-    servos[i].attach(SERVO_PINS[i], SERVO_MIN_US, SERVO_MAX_US);
-    currentAngles[i] = 90;
-
-    // Apply angle adjustment for initial position
-    int adjustedAngle = adjustAngleForServo(i, 90);
-    servos[i].write(adjustedAngle);
+    halServoAttach(i);
+    motionInitJoint(i, 90 * CDEG_PER_DEG);
 
     Serial.print(" ✅ Initialized at ");
     Serial.print(currentAngles[i]);
-    if (i == 2) { // Show inverted angle for pin 12
-      Serial.print("° (inverted to ");
-      Serial.print(adjustedAngle);
-      Serial.print("°)");
-    } else {
-      Serial.print("°");
-    }
+    Serial.print("° (");
+    Serial.print(servoPulseUs(i, 90));
+    Serial.print("us");
+    if (JOINTS[i].cal.inverted) Serial.print(", inverted");
+    Serial.print(")");
     Serial.println();
     delay(100);
   }
@@ -616,48 +2279,107 @@ void setupServos() {
   Serial.println("=== Servo Setup Complete ===");
 }
 
+void setupStorage() {
+  Serial.println("=== Skill Cache Setup Starting ===");
+  if (skillCacheBegin()) {
+    Serial.print("💾 Cached skills: ");
+    Serial.println((unsigned)skillCacheCount());
+  } else {
+    Serial.println("❌ LittleFS unavailable - /skills and /play are disabled");
+  }
+  Serial.println("=== Skill Cache Setup Complete ===");
+}
+
 void setupServer() {
   Serial.println("=== HTTP Server Setup Starting ===");
   Serial.println("Registering HTTP endpoints...");
-  server.on("/", HTTP_GET, handleRoot);
-  server.on("/servo", HTTP_POST, handleServos);
-  server.on("/sequence", HTTP_POST, handleSequence);
-  server.on("/calibrate", HTTP_POST, handleCalibrate);
+  server.on("/", HTTP_GET, timedRoute("GET /", handleRoot));
+  server.on("/servo", HTTP_POST, timedRoute("POST /servo", handleServos));
+  server.on("/frame", HTTP_POST, timedRoute("POST /frame", handleFrame));
+  server.on("/servos", HTTP_POST, timedRoute("POST /servos", handleFrame)); // alias used by the backend calibrate fallback
+  server.on("/sequence", HTTP_POST, timedRoute("POST /sequence", handleSequence),
+            timedRoute("POST /sequence body", handleSequenceUpload));
+  server.on("/sequence", HTTP_GET, timedRoute("GET /sequence", handleSequenceStatus));
+  server.on("/sequence/abort", HTTP_POST, timedRoute("POST /sequence/abort", handleSequenceAbort));
+  server.on("/time", HTTP_GET, handleTime); // untimed: it should add as little delay as possible
+  server.on("/sequence.bin", HTTP_POST, timedRoute("POST /sequence.bin", handleSequenceBinary),
+            timedRoute("POST /sequence.bin body", handleSequenceBinaryUpload));
+  server.on("/stack", HTTP_POST, timedRoute("POST /stack", handleStack));
+  server.on("/stack/clear", HTTP_POST, timedRoute("POST /stack/clear", handleStackClear));
+  server.on("/skills", HTTP_GET, timedRoute("GET /skills", handleSkillList));
+  server.on(UriBraces("/skills/{}"), HTTP_GET, timedRoute("GET /skills/{}", handleSkillLookup));
+  server.on(UriBraces("/skills/{}"), HTTP_POST, timedRoute("POST /skills/{}", handleSkillStore),
+            timedRoute("POST /skills/{} body", handleSkillUpload));
+  server.on(UriBraces("/skills/{}"), HTTP_DELETE, timedRoute("DELETE /skills/{}", handleSkillDelete));
+  server.on(UriBraces("/play/{}"), HTTP_POST, timedRoute("POST /play/{}", handlePlaySkill));
+  server.on("/face", HTTP_POST, timedRoute("POST /face", handleFace));
+  server.on("/calibrate", HTTP_POST, timedRoute("POST /calibrate", handleCalibrate));
+  server.on("/planner", HTTP_GET, timedRoute("GET /planner", handlePlannerStatus));
+  server.on("/planner", HTTP_POST, timedRoute("POST /planner", handlePlannerConfig));
+  server.on("/watchdog", HTTP_GET, timedRoute("GET /watchdog", handleWatchdogStatus));
+  server.on("/watchdog", HTTP_POST, timedRoute("POST /watchdog", handleWatchdogConfig));
+#if ROBOT_FEEDBACK
+  server.on("/feedback", HTTP_GET, timedRoute("GET /feedback", handleFeedback));
+#endif
+  server.on("/metrics", HTTP_GET, handleMetrics);
+  server.on("/metrics/reset", HTTP_POST, handleMetricsReset);
+#if ROBOT_LOG_RING
+  server.on("/logs", HTTP_GET, timedRoute("GET /logs", handleLogs));
+#endif
   server.onNotFound(handleNotFound);
   server.begin();
   Serial.println("🎉 HTTP server started successfully on port 80!");
+  streamUdp.begin(STREAM_UDP_PORT);
+  Serial.print("🎉 UDP pose stream listening on port ");
+  Serial.println(STREAM_UDP_PORT);
   Serial.println("=== HTTP Server Setup Complete ===");
 }
 
-void setup() {
-  Serial.begin(115200);
-  delay(1200);
-  Serial.println("\n=== ESP32 BATCHED SERVO CONTROLLER BOOT ===");
-
-  Serial.println("\n\n============================================================");
-  Serial.println("       ESP32 BATCHED SERVO CONTROLLER STARTING        ");
-  Serial.println("============================================================");
-  Serial.println("Starting in 2 seconds... Open serial monitor now!");
+// Networking task - HTTP parsing, the UDP stream and batch timeouts run on
+// core 0 next to the WiFi stack, so a slow client or a large /sequence parse
+// can only delay other requests, never a servo update on core 1
+static const BaseType_t NETWORK_TASK_CORE = 0;
+static const UBaseType_t NETWORK_TASK_PRIORITY = 2; // below the WiFi/lwIP tasks it depends on
+static const uint32_t NETWORK_TASK_STACK = 8192;
+
+TaskHandle_t networkTaskHandle = nullptr;
+
+// Everything on the network task except the HTTP server; also run while a
+// pipelined upload holds the server (waitForSequenceSlot())
+void serviceSideChannels() {
+  maintainWiFi();
+  processStream(); // Apply the newest streamed pose, if any arrived
+#if ROBOT_FEEDBACK
+  sendTelemetry(); // Feedback snapshot of the last tick to the subscriber
+#endif
+  checkBatchTimeout(); // Drop a /servo batch that stopped arriving part-way
+  faceLinkPoll(); // Face display events, and expressions that follow playback
+}
 
-  for (int i = 2; i > 0; i--) {
-    Serial.print("Starting in: ");
-    Serial.print(i);
-    Serial.println(" seconds...");
-    delay(1000);
+void networkTask(void*) {
+  int64_t lastStart = 0;
+  for (;;) {
+    int64_t start = esp_timer_get_time();
+    if (lastStart != 0) metricsRecord(METRIC_LOOP_GAP, (uint32_t)(start - lastStart));
+    lastStart = start;
+    server.handleClient();
+    serviceSideChannels();
+    if (!sequenceBusy()) skillCacheFlush(); // flash writes stall the motion tick too
+    metricsRecord(METRIC_LOOP_BUSY, (uint32_t)(esp_timer_get_time() - start));
+    vTaskDelay(1); // let IDLE0 run so the task watchdog stays fed
   }
+}
 
-  Serial.println("\nINITIALIZING ESP32 BATCHED SERVO CONTROLLER...\n");
-
-  pinMode(LED_PIN, OUTPUT);
-  digitalWrite(LED_PIN, LOW);
-
-  // Initialize batch system
-  initializeBatch();
-
-  setupWiFi();
-  setupServos();
-  setupServer();
+void startNetworkTask() {
+  xTaskCreatePinnedToCore(networkTask, "network", NETWORK_TASK_STACK, nullptr,
+                          NETWORK_TASK_PRIORITY, &networkTaskHandle, NETWORK_TASK_CORE);
+  Serial.print("✅ Network task running on core ");
+  Serial.println(NETWORK_TASK_CORE);
+}
 
+// Endpoint and behaviour summary for the serial monitor (verbose boot only;
+// at 115200 baud it takes a few hundred ms to drain)
+void printUsageBanner() {
   Serial.println("\n============================================================");
   Serial.println("              SYSTEM READY!                      ");
   Serial.println("============================================================");
@@ -670,6 +2392,9 @@ void setup() {
   Serial.print("Send servo commands (collects 6 before executing): curl -X POST http://");
   Serial.print(WiFi.localIP().toString());
   Serial.println("/servo -H 'Content-Type: application/json' -d '{\"id\":1,\"angle\":120}'");
+  Serial.print("Send a whole pose at once: curl -X POST http://");
+  Serial.print(WiFi.localIP().toString());
+  Serial.println("/frame -H 'Content-Type: application/json' -d '{\"angles\":[90,90,90,90,90,90]}'");
   Serial.print("Execute choreographed sequence: curl -X POST http://");
   Serial.print(WiFi.localIP().toString());
   Serial.println("/sequence -H 'Content-Type: application/json' -d '{\"skill\":\"wave\",\"sequence\":[{\"seq_num\":1,\"commands\":[{\"id\":2,\"deg\":45}]}]}'");
@@ -679,27 +2404,102 @@ void setup() {
   Serial.println("\nBATCH BEHAVIOR:");
   Serial.println("- Collects up to 6 servo commands");
   Serial.println("- Executes all 6 simultaneously when batch is complete");
-  Serial.println("- Auto-executes incomplete batches after 1 second timeout");
+  Serial.println("- Drops incomplete batches after 1 second as stale");
   Serial.println("- Can update commands in current batch");
-  Serial.println("\n🔄 SERVO INVERSION:");
-  Serial.println("- Servo 3 (pin 12, left_elbow_vertical) has inverted movement");
-  Serial.println("- 0° becomes 180°, 180° becomes 0°, 90° stays 90°");
+  Serial.println("\n🔄 SERVO CALIBRATION:");
+  Serial.println("- Per-servo pins, pulse range, inversion and trim live in JOINTS (lib/motion/joints.h)");
+  Serial.println("- Servo 3 (pin 12, left_elbow_vertical) is inverted: 0° drives to the 180° pulse");
   Serial.println("\n🎭 SEQUENCE ENDPOINT:");
   Serial.println("- POST /sequence for choreographed movements");
-  Serial.println("- Executes immediately with timed steps");
-  Serial.println("- Supports memory-efficient large sequences");
+  Serial.println("- Parses once, replies 202 with a job_id, plays steps in the background");
+  Serial.println("- GET /sequence for progress, POST /sequence/abort to stop");
+  Serial.println("- Optional step_ms field (default 400ms per step)");
+  Serial.println("- Optional start_at_ms (device clock, see GET /time) for a synchronised start");
+  Serial.println("- GET /metrics for per-route latency, loop/tick timing, WiFi and heap health");
+  Serial.println("- Steps are keyframes: the planner eases between them at 50 Hz");
+  Serial.println("\n💾 SKILL CACHE:");
+  Serial.println("- POST /skills/<name> with a /sequence.bin body stores it in flash (409 while playing)");
+  Serial.println("- POST /play/<name> replays it, GET /skills lists, LRU eviction when full");
+  Serial.println("- Optional profile field: linear, trapezoidal (default) or cubic");
+  Serial.println("- POST /sequence.bin takes the packed format (8-byte header + 6 bytes/step)");
+  Serial.println("- Versions 3/4 are delta encoded: changed joints only, run-length holds");
+  Serial.println("- POST /sequence.bin?pipeline=1 starts playing as soon as the first step arrives");
+  Serial.println("\n🐵 FACE:");
+  Serial.println("- Monkey display on Serial2 follows playback: talks per step, happy when done");
+  Serial.println("- Tap the face to replay the last skill, long-press to abort");
+  Serial.println("- POST /face {\"expression\":\"surprise\",\"react\":true} drives it directly");
+  Serial.println("\n📶 UDP STREAM:");
+  Serial.print("- 12-byte pose packets ('PS' + uint32 seq + 6 angles) on port ");
+  Serial.println(STREAM_UDP_PORT);
+  Serial.println("- Out-of-order and duplicate packets are dropped");
+  Serial.println("- Send 'SA' to abort the running sequence, even mid-upload");
+  Serial.println("- Watchdog: no pose within the deadline holds the arms (GET/POST /watchdog)");
+#if ROBOT_FEEDBACK
+  Serial.println("- Send 'TS' to subscribe to per-tick feedback telemetry ('TF'); GET /feedback");
+#endif
   Serial.println("============================================================");
+
 }
 
-void loop() {
-  server.handleClient();
-  processServoStacks(); // Process servo command stacks in parallel
-  checkBatchTimeout(); // Check if batch should be auto-executed
+void setup() {
+  Serial.begin(115200);
+  if (!FAST_BOOT) {
+    delay(1200);
+    Serial.println("\n=== ESP32 BATCHED SERVO CONTROLLER BOOT ===");
+
+    Serial.println("\n\n============================================================");
+    Serial.println("       ESP32 BATCHED SERVO CONTROLLER STARTING        ");
+    Serial.println("============================================================");
+    Serial.println("Starting in 2 seconds... Open serial monitor now!");
+
+    for (int i = 2; i > 0; i--) {
+      Serial.print("Starting in: ");
+      Serial.print(i);
+      Serial.println(" seconds...");
+      delay(1000);
+    }
+  }
+
+  Serial.println("\nINITIALIZING ESP32 BATCHED SERVO CONTROLLER...\n");
 
+  pinMode(LED_PIN, OUTPUT);
+  digitalWrite(LED_PIN, LOW);
+
+  // Initialize batch system
+  initializeBatch();
+  requestArenaBegin(REQUEST_ARENA_INTERNAL_BYTES, REQUEST_ARENA_PSRAM_BYTES);
+  faceLinkBegin();
+  faceLinkSetEventHandler(onFaceEvent);
+#if ROBOT_FEEDBACK
+  feedbackBegin(); // before the motion task's first tick reads it
+#endif
+
+  // Servos first so the arms hold neutral as early as possible; in fast boot
+  // WiFi then associates while storage and the server come up
+  runBootPhase(BOOT_SERVOS, setupServos);
+  runBootPhase(BOOT_MOTION, setupMotion);
+  runBootPhase(BOOT_WIFI, setupWiFi);
+  runBootPhase(BOOT_STORAGE, setupStorage);
+  runBootPhase(BOOT_SERVER, setupServer);
+
+  if (FAST_BOOT) {
+    LOGI("🎉 Ready in %lu ms (fast boot); GET /metrics has the boot timings", millis());
+  } else {
+    printUsageBanner();
+  }
+  bootReadyMs = millis();
+
+  // Start serving only once the banner is out so request logs don't interleave
+  startNetworkTask();
+}
+
+// Networking and motion run in their own tasks; loop() only keeps the heartbeat
+void loop() {
   unsigned long now = millis();
   if (now - lastBlink >= 1000) {
     ledState = !ledState;
     digitalWrite(LED_PIN, ledState ? HIGH : LOW);
     lastBlink = now;
   }
+  delay(10);
 }
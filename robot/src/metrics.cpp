@@ -0,0 +1,80 @@
+#include "metrics.h"
+
+#include <string.h>
+
+#include "logging.h"
+
+static LatencyHistogram series[METRIC_SERIES_COUNT];
+static LatencyHistogram routes[METRICS_MAX_ROUTES];
+static const char *routeLabels[METRICS_MAX_ROUTES];
+static int routeCount = 0;
+
+static const int BUCKET_SHIFT = 6; // bucket 0 ends at 2^6 us
+
+static inline int bucketFor(uint32_t us) {
+  if (us < (1u << BUCKET_SHIFT)) return 0;
+  int b = (31 - __builtin_clz(us)) - (BUCKET_SHIFT - 1);
+  return b < METRICS_BUCKETS ? b : METRICS_BUCKETS - 1;
+}
+
+static inline void record(LatencyHistogram &h, uint32_t us) {
+  h.buckets[bucketFor(us)]++;
+  h.count++;
+  h.sumUs += us;
+  if (us > h.maxUs) h.maxUs = us;
+}
+
+const char *metricsSeriesName(MetricsSeries s) {
+  switch (s) {
+    case METRIC_JSON_PARSE: return "json_parse";
+    case METRIC_LOOP_BUSY: return "loop_busy";
+    case METRIC_LOOP_GAP: return "loop_gap";
+    case METRIC_TICK_JITTER: return "tick_jitter";
+    case METRIC_TICK_BUSY: return "tick_busy";
+    default: return "unknown";
+  }
+}
+
+uint32_t metricsBucketUpperUs(int bucket) {
+  if (bucket < 0 || bucket >= METRICS_BUCKETS - 1) return 0;
+  return 1u << (BUCKET_SHIFT + bucket);
+}
+
+void metricsRecord(MetricsSeries s, uint32_t us) {
+  record(series[s], us);
+}
+
+const LatencyHistogram &metricsSeries(MetricsSeries s) {
+  return series[s];
+}
+
+int metricsRegisterRoute(const char *label) {
+  if (routeCount >= METRICS_MAX_ROUTES) {
+    LOGE("❌ Metrics: route table full (METRICS_MAX_ROUTES = %d), '%s' is not timed", METRICS_MAX_ROUTES, label);
+    return -1;
+  }
+  routeLabels[routeCount] = label;
+  return routeCount++;
+}
+
+void metricsRecordRoute(int route, uint32_t us) {
+  if (route < 0 || route >= routeCount) return;
+  record(routes[route], us);
+}
+
+int metricsRouteCount() {
+  return routeCount;
+}
+
+const char *metricsRouteLabel(int route) {
+  return routeLabels[route];
+}
+
+const LatencyHistogram &metricsRoute(int route) {
+  return routes[route];
+}
+
+void metricsReset() {
+  memset(series, 0, sizeof(series));
+  memset(routes, 0, sizeof(routes));
+}
@@ -0,0 +1,28 @@
+#include "motion_hal_esp32.h"
+
+#include <Arduino.h>
+
+#include "motion_core.h"
+
+static portMUX_TYPE stackLock = portMUX_INITIALIZER_UNLOCKED;
+
+unsigned long halMillis() {
+  return millis();
+}
+
+void halServoAttach(int servoIndex) {
+  ledcSetup(SERVO_LEDC_CHANNEL_BASE + servoIndex, SERVO_PWM_HZ, SERVO_DUTY_BITS);
+  ledcAttachPin(JOINTS[servoIndex].pin, SERVO_LEDC_CHANNEL_BASE + servoIndex);
+}
+
+void halServoWrite(int servoIndex, uint16_t duty) {
+  ledcWrite(SERVO_LEDC_CHANNEL_BASE + servoIndex, duty);
+}
+
+void halStackLock() {
+  portENTER_CRITICAL(&stackLock);
+}
+
+void halStackUnlock() {
+  portEXIT_CRITICAL(&stackLock);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "motion_core.h"
+
+// Native simulator backing lib/motion/motion_hal.h: a virtual millisecond
+// clock that only moves when told to, and servos that record what they were
+// driven to instead of generating PWM. Single-threaded, so the stack lock is
+// a no-op.
+
+struct SimServo {
+  uint16_t duty;    // last duty written
+  uint32_t writes;  // halServoWrite() calls for this servo
+};
+
+extern SimServo simServos[SERVO_COUNT];
+extern bool simVerbose; // print LOGx output to stderr
+
+void simSetTime(unsigned long ms);
+void simAdvance(unsigned long ms);
+unsigned long simTime();
+
+// Pulse width in microseconds that the last written duty corresponds to
+float simServoPulseUs(int servoIndex);
+
+// Reset the motion core and servos to a neutral pose at virtual time 0
+void simReset();
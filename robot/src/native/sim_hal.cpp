@@ -0,0 +1,74 @@
+#include "sim.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "logging.h"
+
+SimServo simServos[SERVO_COUNT];
+bool simVerbose = false;
+
+static unsigned long simNowMs = 0;
+
+unsigned long halMillis() {
+  return simNowMs;
+}
+
+void halServoWrite(int servoIndex, uint16_t duty) {
+  simServos[servoIndex].duty = duty;
+  simServos[servoIndex].writes++;
+}
+
+void halStackLock() {}
+void halStackUnlock() {}
+
+void simSetTime(unsigned long ms) {
+  simNowMs = ms;
+}
+
+void simAdvance(unsigned long ms) {
+  simNowMs += ms;
+}
+
+unsigned long simTime() {
+  return simNowMs;
+}
+
+float simServoPulseUs(int servoIndex) {
+  const uint32_t maxDuty = (1u << SERVO_DUTY_BITS) - 1;
+  return simServos[servoIndex].duty * (float)SERVO_PERIOD_US / maxDuty;
+}
+
+void simReset() {
+  simNowMs = 0;
+  MotionCommand cmd;
+  while (motionQueue.pop(cmd)) {
+  }
+  clearStacks();
+  pendingFrame.active = false;
+  sequenceState = SEQ_IDLE;
+  sequenceLength = 0;
+  sequenceCursor = 0;
+  initializeBatch();
+  memset(simServos, 0, sizeof(simServos));
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    motionInitJoint(i, 90 * CDEG_PER_DEG);
+  }
+}
+
+// logging.h backend for the host: virtual-clock timestamps, stderr, opt-in
+void logPrintf(int level, const char* fmt, ...) {
+  if (!simVerbose) return;
+  static const char LEVELS[] = "NEWID";
+  fprintf(stderr, "[%lu] %c ", simNowMs, LEVELS[level < 0 || level > 4 ? 4 : level]);
+  va_list args;
+  va_start(args, fmt);
+  vfprintf(stderr, fmt, args);
+  va_end(args);
+  fputc('\n', stderr);
+}
+
+uint32_t logDroppedCount() {
+  return 0;
+}
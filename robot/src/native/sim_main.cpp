@@ -0,0 +1,390 @@
+// Host-side driver for the motion core (pio run -e native).
+//
+//   program replay <servo_sequence.json> [--speed N] [--step-ms N] [--profile P] [--csv FILE] [--verbose]
+//     Plays a backend sequence through the real planner and sequence executor
+//     against the virtual clock, N times faster than real time (default 1000,
+//     0 = as fast as possible), and reports timing, servo writes and the peak
+//     joint velocities seen. --csv writes one row of joint angles per tick.
+//
+//   program bench [--iterations N]
+//     Microbenchmarks of the control-tick hot paths in ns/op.
+//
+//   program selftest
+//     Scenario checks of the sequence executor against the virtual clock;
+//     exits non-zero if any fails.
+#include <ArduinoJson.h>
+
+#include <chrono>
+#include <fstream>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+
+#include "motion_core.h"
+#include "sim.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedMs(Clock::time_point since) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+static const char *argValue(int argc, char **argv, const char *flag, const char *fallback) {
+  for (int i = 0; i + 1 < argc; ++i) {
+    if (strcmp(argv[i], flag) == 0) return argv[i + 1];
+  }
+  return fallback;
+}
+
+static bool hasFlag(int argc, char **argv, const char *flag) {
+  for (int i = 0; i < argc; ++i) {
+    if (strcmp(argv[i], flag) == 0) return true;
+  }
+  return false;
+}
+
+// Same shape and limits as POST /sequence: {"skill", "step_ms", "profile",
+// "sequence": [{"commands": [{"id", "deg"}]} or {"hold": n}]}
+static bool loadSequence(const char *path, std::string &skill, unsigned long &stepMs, MotionProfile &profile,
+                         int &stepCount) {
+  std::ifstream in(path);
+  if (!in) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return false;
+  }
+  DynamicJsonDocument doc(1 << 20);
+  DeserializationError error = deserializeJson(doc, in);
+  if (error) {
+    fprintf(stderr, "%s: %s\n", path, error.c_str());
+    return false;
+  }
+
+  skill = doc["skill"] | "Unknown Skill";
+  if (doc.containsKey("step_ms")) stepMs = doc["step_ms"].as<unsigned long>();
+  if (doc.containsKey("profile") && !parseMotionProfile(doc["profile"].as<const char *>(), &profile)) {
+    fprintf(stderr, "%s: unknown profile\n", path);
+    return false;
+  }
+  JsonArray steps = doc["sequence"].as<JsonArray>();
+  if (steps.isNull() || steps.size() == 0) {
+    fprintf(stderr, "%s: sequence must have 1-%d steps\n", path, MAX_SEQUENCE_STEPS);
+    return false;
+  }
+
+  stepCount = 0;
+  for (JsonObject step : steps) {
+    long hold = step["hold"] | 0L;
+    if (stepCount + (hold > 0 ? hold : 1) > MAX_SEQUENCE_STEPS) {
+      fprintf(stderr, "%s: sequence must have 1-%d steps\n", path, MAX_SEQUENCE_STEPS);
+      return false;
+    }
+    if (hold > 0) {
+      while (hold-- > 0) sequenceSteps[stepCount++].mask = 0;
+      continue;
+    }
+    SequenceStep &out = sequenceSteps[stepCount++];
+    out.mask = 0;
+    for (JsonObject cmd : step["commands"].as<JsonArray>()) {
+      int idx = getServoIndex(cmd["id"].as<int>());
+      float deg = cmd["deg"].as<float>();
+      if (idx < 0 || !(deg >= 0.0f && deg <= 180.0f)) {
+        fprintf(stderr, "%s: step %d has a bad command\n", path, stepCount);
+        return false;
+      }
+      out.angles[idx] = (uint16_t)lroundf(deg * CDEG_PER_DEG);
+      out.mask |= (JointMask)(1 << idx);
+    }
+  }
+  return true;
+}
+
+static int runReplay(int argc, char **argv) {
+  if (argc < 1) {
+    fprintf(stderr, "usage: replay <servo_sequence.json> [--speed N] [--step-ms N] [--profile P] [--csv FILE]\n");
+    return 2;
+  }
+  double speed = atof(argValue(argc, argv, "--speed", "1000"));
+  unsigned long stepMs = DEFAULT_STEP_DURATION_MS;
+  MotionProfile profile = PROFILE_TRAPEZOIDAL;
+  simVerbose = hasFlag(argc, argv, "--verbose");
+
+  simReset();
+  std::string skill;
+  int stepCount = 0;
+  if (!loadSequence(argv[0], skill, stepMs, profile, stepCount)) return 1;
+  const char *stepArg = argValue(argc, argv, "--step-ms", nullptr);
+  if (stepArg) stepMs = strtoul(stepArg, nullptr, 10);
+  const char *profileArg = argValue(argc, argv, "--profile", nullptr);
+  if (profileArg && !parseMotionProfile(profileArg, &profile)) {
+    fprintf(stderr, "unknown profile %s\n", profileArg);
+    return 2;
+  }
+  if (stepMs < MIN_STEP_DURATION_MS || stepMs > MAX_STEP_DURATION_MS) {
+    fprintf(stderr, "step_ms out of range\n");
+    return 2;
+  }
+
+  FILE *csv = nullptr;
+  const char *csvPath = argValue(argc, argv, "--csv", nullptr);
+  if (csvPath) {
+    csv = fopen(csvPath, "w");
+    if (!csv) {
+      fprintf(stderr, "cannot write %s\n", csvPath);
+      return 1;
+    }
+    fprintf(csv, "t_ms,step");
+    for (int i = 0; i < SERVO_COUNT; ++i) fprintf(csv, ",%s", JOINTS[i].name);
+    fprintf(csv, "\n");
+  }
+
+  if (startSequence(skill.c_str(), stepCount, stepMs, profile) == 0) {
+    fprintf(stderr, "motion queue full\n");
+    return 1;
+  }
+
+  float lastPosition[SERVO_COUNT];
+  float peakVelocity[SERVO_COUNT] = {0};
+  for (int i = 0; i < SERVO_COUNT; ++i) lastPosition[i] = joints[i].position;
+
+  // Ticks at the firmware's control period; with a finite speed each tick is
+  // paced to CONTROL_TICK_MS / speed of wall time
+  const double tickWallMs = speed > 0 ? CONTROL_TICK_MS / speed : 0;
+  const unsigned long limitMs = (unsigned long)stepCount * stepMs + 60000;
+  Clock::time_point wallStart = Clock::now();
+  unsigned long ticks = 0;
+  while (sequenceState != SEQ_COMPLETED && simTime() < limitMs) {
+    motionTick();
+    ticks++;
+    for (int i = 0; i < SERVO_COUNT; ++i) {
+      float v = fabsf(joints[i].position - lastPosition[i]) * 1000.0f / CONTROL_TICK_MS;
+      if (v > peakVelocity[i]) peakVelocity[i] = v;
+      lastPosition[i] = joints[i].position;
+    }
+    if (csv) {
+      fprintf(csv, "%lu,%d", simTime(), sequenceCursor);
+      for (int i = 0; i < SERVO_COUNT; ++i) fprintf(csv, ",%.2f", joints[i].position);
+      fprintf(csv, "\n");
+    }
+    simAdvance(CONTROL_TICK_MS);
+    if (tickWallMs > 0) {
+      double due = ticks * tickWallMs - elapsedMs(wallStart);
+      if (due > 0) std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(due));
+    }
+  }
+  double wallMs = elapsedMs(wallStart);
+  if (csv) fclose(csv);
+
+  uint32_t writes = 0;
+  for (int i = 0; i < SERVO_COUNT; ++i) writes += simServos[i].writes;
+  printf("skill: %s\n", skill.c_str());
+  printf("steps: %d @ %lums (%s)\n", stepCount, stepMs, motionProfileName(profile));
+  printf("state: %s after %lu virtual ms, %lu ticks\n", sequenceStateName(sequenceState), simTime(), ticks);
+  printf("wall: %.1f ms (%.0fx real time)\n", wallMs, wallMs > 0 ? simTime() / wallMs : 0.0);
+  printf("servo writes: %u (%.2f per tick)\n", (unsigned)writes, ticks ? writes / (double)ticks : 0.0);
+  printf("%-24s %8s %10s %10s %9s\n", "joint", "final", "peak deg/s", "limit", "pulse us");
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    printf("%-24s %8.2f %10.1f %10.1f %9.1f\n", JOINTS[i].name, joints[i].position, peakVelocity[i],
+           jointMaxVelocity[i], simServoPulseUs(i));
+  }
+  return sequenceState == SEQ_COMPLETED ? 0 : 1;
+}
+
+static volatile uint32_t benchSink;
+
+template <typename F>
+static void bench(const char *name, long iterations, F body) {
+  Clock::time_point start = Clock::now();
+  for (long n = 0; n < iterations; ++n) body(n);
+  double ns = elapsedMs(start) * 1e6 / iterations;
+  printf("%-36s %10.1f ns/op\n", name, ns);
+}
+
+static int runBench(int argc, char **argv) {
+  long iterations = atol(argValue(argc, argv, "--iterations", "1000000"));
+  if (iterations <= 0) iterations = 1000000;
+  simReset();
+
+  bench("servoDuty (fractional)", iterations, [](long n) {
+    benchSink += servoDuty((int)(n % SERVO_COUNT), (int)(n % MAX_ANGLE_CDEG));
+  });
+
+  int angles[SERVO_COUNT];
+  const JointMask all = (JointMask)((1 << SERVO_COUNT) - 1);
+  bench("plannerMoveTo (6 joints)", iterations, [&](long n) {
+    for (int i = 0; i < SERVO_COUNT; ++i) angles[i] = (int)((n * 37 + i * 1000) % MAX_ANGLE_CDEG);
+    plannerMoveTo(angles, all, 400, PROFILE_TRAPEZOIDAL);
+  });
+
+  simReset();
+  bench("plannerTick (6 joints moving)", iterations, [&](long n) {
+    if (!plannerMoving()) {
+      for (int i = 0; i < SERVO_COUNT; ++i) angles[i] = (n & 1) ? 3000 : 15000;
+      plannerMoveTo(angles, all, 0, PROFILE_CUBIC);
+    }
+    simAdvance(1);
+    plannerTick();
+  });
+
+  simReset();
+  bench("enqueueStack + dequeueStack", iterations, [](long n) {
+    int angle = (int)(n % MAX_ANGLE_CDEG);
+    int dropped;
+    size_t remaining;
+    ServoCommand cmd;
+    enqueueStack((int)(n % SERVO_COUNT), &angle, 1, STACK_DROP_OLDEST, &dropped);
+    dequeueStack((int)(n % SERVO_COUNT), cmd, &remaining);
+    benchSink += cmd.angle;
+  });
+
+  simReset();
+  bench("motionTick (idle)", iterations, [](long) {
+    simAdvance(CONTROL_TICK_MS);
+    motionTick();
+  });
+
+  // A full-length sequence at 20 ms steps: every tick starts a new keyframe
+  simReset();
+  for (int s = 0; s < MAX_SEQUENCE_STEPS; ++s) {
+    sequenceSteps[s].mask = all;
+    for (int i = 0; i < SERVO_COUNT; ++i) sequenceSteps[s].angles[i] = (uint16_t)((s * 331 + i * 977) % MAX_ANGLE_CDEG);
+  }
+  long replays = iterations / (MAX_SEQUENCE_STEPS * 10) + 1;
+  long ticks = 0;
+  Clock::time_point start = Clock::now();
+  for (long r = 0; r < replays; ++r) {
+    startSequence("bench", MAX_SEQUENCE_STEPS, MIN_STEP_DURATION_MS, PROFILE_TRAPEZOIDAL);
+    do {
+      motionTick();
+      simAdvance(CONTROL_TICK_MS);
+      ticks++;
+    } while (sequenceState != SEQ_COMPLETED);
+  }
+  double ns = elapsedMs(start) * 1e6 / ticks;
+  printf("%-36s %10.1f ns/op (%ld ticks, %.0fx real time)\n", "motionTick (sequence playback)", ns, ticks,
+         CONTROL_TICK_MS * 1e6 / ns);
+  return 0;
+}
+
+static int selftestFailures = 0;
+
+static void expect(bool ok, const char *scenario, const char *what) {
+  printf("%s  %s: %s\n", ok ? "ok  " : "FAIL", scenario, what);
+  if (!ok) selftestFailures++;
+}
+
+// Fill the step table with alternating poses ending on a distinct final one
+static void fillSteps(int stepCount, uint16_t finalCdeg) {
+  const JointMask all = (JointMask)((1 << SERVO_COUNT) - 1);
+  for (int s = 0; s < stepCount; ++s) {
+    sequenceSteps[s].mask = all;
+    for (int i = 0; i < SERVO_COUNT; ++i) sequenceSteps[s].angles[i] = (s & 1) ? 6000 : 12000;
+  }
+  for (int i = 0; i < SERVO_COUNT; ++i) sequenceSteps[stepCount - 1].angles[i] = finalCdeg;
+}
+
+// Tick until the job completes; false if it never does. Tracks the fastest
+// any joint moved in a single tick.
+static bool runToCompletion(unsigned long limitMs, float *peakVelocity) {
+  float last[SERVO_COUNT];
+  for (int i = 0; i < SERVO_COUNT; ++i) last[i] = joints[i].position;
+  *peakVelocity = 0;
+  unsigned long until = simTime() + limitMs;
+  while (sequenceState != SEQ_COMPLETED && simTime() < until) {
+    motionTick();
+    for (int i = 0; i < SERVO_COUNT; ++i) {
+      float v = fabsf(joints[i].position - last[i]) * 1000.0f / CONTROL_TICK_MS / jointMaxVelocity[i];
+      if (v > *peakVelocity) *peakVelocity = v;
+      last[i] = joints[i].position;
+    }
+    simAdvance(CONTROL_TICK_MS);
+  }
+  return sequenceState == SEQ_COMPLETED;
+}
+
+// Let the planner finish the last keyframe, then compare each joint
+static bool atPose(const uint16_t cdeg[SERVO_COUNT]) {
+  for (int t = 0; t < 1000 && plannerMoving(); ++t) {
+    motionTick();
+    simAdvance(CONTROL_TICK_MS);
+  }
+  for (int i = 0; i < SERVO_COUNT; ++i) {
+    if (fabsf(joints[i].position - cdeg[i] / (float)CDEG_PER_DEG) > 0.01f) return false;
+  }
+  return true;
+}
+
+static bool atFinalPose(uint16_t finalCdeg) {
+  uint16_t pose[SERVO_COUNT];
+  for (int i = 0; i < SERVO_COUNT; ++i) pose[i] = finalCdeg;
+  return atPose(pose);
+}
+
+static int runSelftest(int, char **) {
+  const int steps = 10;
+  const unsigned long stepMs = 500;
+  float peak;
+
+  // A synchronized start whose start_at is long gone: every step but the last
+  // is skipped, and the last still plays over a full step
+  simReset();
+  simSetTime(120000);
+  fillSteps(steps, 3000);
+  startSequence("late", steps, stepMs, PROFILE_TRAPEZOIDAL, true, 120000 - 60000);
+  bool done = runToCompletion(10000, &peak);
+  expect(done, "start_at far in the past", "job completes");
+  expect(atFinalPose(3000), "start_at far in the past", "final pose applied");
+  expect(peak <= 1.01f, "start_at far in the past", "final pose reached within joint velocity limits");
+
+  // Delta steps with a past start_at: every step changes one joint, so only
+  // folding the skipped steps lands each joint on its last target
+  simReset();
+  simSetTime(120000);
+  uint16_t expected[SERVO_COUNT];
+  for (int s = 0; s < steps; ++s) {
+    int idx = s % SERVO_COUNT;
+    sequenceSteps[s].mask = (JointMask)(1 << idx);
+    sequenceSteps[s].angles[idx] = (uint16_t)(4000 + s * 1000);
+    expected[idx] = sequenceSteps[s].angles[idx];
+  }
+  startSequence("late delta", steps, stepMs, PROFILE_TRAPEZOIDAL, true, 120000 - 60000);
+  done = runToCompletion(10000, &peak);
+  expect(done, "delta steps, start_at far in the past", "job completes");
+  expect(atPose(expected), "delta steps, start_at far in the past", "every joint at its last skipped target");
+
+  // The motion task stalls mid-job for longer than the remaining steps
+  simReset();
+  fillSteps(steps, 15000);
+  startSequence("stall", steps, stepMs, PROFILE_TRAPEZOIDAL);
+  for (int t = 0; t < 10; ++t) {
+    motionTick();
+    simAdvance(CONTROL_TICK_MS);
+  }
+  simAdvance(steps * stepMs * 5);
+  done = runToCompletion(10000, &peak);
+  expect(done, "stall past the last step", "job completes");
+  expect(atFinalPose(15000), "stall past the last step", "final pose applied");
+
+  // On time: nothing is skipped and the job takes its nominal length
+  simReset();
+  fillSteps(steps, 9000);
+  startSequence("on time", steps, stepMs, PROFILE_TRAPEZOIDAL);
+  done = runToCompletion(10000, &peak);
+  expect(done && simTime() >= steps * stepMs && simTime() <= steps * stepMs + 2 * CONTROL_TICK_MS, "on time",
+         "takes step_ms per step");
+  expect(atFinalPose(9000), "on time", "final pose applied");
+
+  printf("%d failed\n", selftestFailures);
+  return selftestFailures ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc >= 2 && strcmp(argv[1], "replay") == 0) return runReplay(argc - 2, argv + 2);
+  if (argc >= 2 && strcmp(argv[1], "bench") == 0) return runBench(argc - 2, argv + 2);
+  if (argc >= 2 && strcmp(argv[1], "selftest") == 0) return runSelftest(argc - 2, argv + 2);
+  fprintf(stderr, "usage: %s replay <servo_sequence.json> [options] | bench [--iterations N] | selftest\n",
+          argv[0]);
+  return 2;
+}
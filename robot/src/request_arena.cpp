@@ -0,0 +1,79 @@
+#include "request_arena.h"
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <stdlib.h>
+
+#include "logging.h"
+
+static uint8_t *arena = nullptr;
+static size_t arenaSize = 0;
+static size_t arenaUsed = 0;
+static size_t arenaHighWater = 0;
+static uint32_t arenaFallbacks = 0;
+static bool arenaPsram = false;
+
+static inline bool inArena(const void *ptr) {
+  return arena && ptr >= arena && ptr < arena + arenaSize;
+}
+
+bool requestArenaBegin(size_t internalBytes, size_t psramBytes) {
+  if (psramFound()) {
+    arena = (uint8_t *)heap_caps_malloc(psramBytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (arena) {
+      arenaSize = psramBytes;
+      arenaPsram = true;
+    }
+  }
+  if (!arena) {
+    arena = (uint8_t *)heap_caps_malloc(internalBytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (arena) arenaSize = internalBytes;
+  }
+  if (!arena) {
+    LOGE("❌ Request arena: no room for %u bytes", (unsigned)internalBytes);
+    return false;
+  }
+  LOGI("✅ Request arena: %u bytes in %s", (unsigned)arenaSize, arenaPsram ? "PSRAM" : "internal RAM");
+  return true;
+}
+
+void *requestArenaAlloc(size_t bytes) {
+  size_t start = (arenaUsed + 7) & ~(size_t)7;
+  if (arena && start + bytes <= arenaSize) {
+    arenaUsed = start + bytes;
+    if (arenaUsed > arenaHighWater) arenaHighWater = arenaUsed;
+    return arena + start;
+  }
+  arenaFallbacks++;
+  LOGW("⚠️ Request arena exhausted (%u of %u used), %u bytes from the heap", (unsigned)arenaUsed,
+       (unsigned)arenaSize, (unsigned)bytes);
+  return malloc(bytes);
+}
+
+void requestArenaFree(void *ptr) {
+  if (ptr && !inArena(ptr)) free(ptr);
+}
+
+size_t requestArenaMark() {
+  return arenaUsed;
+}
+
+void requestArenaRewind(size_t mark) {
+  if (mark < arenaUsed) arenaUsed = mark;
+}
+
+size_t requestArenaCapacity() {
+  return arenaSize;
+}
+
+size_t requestArenaHighWater() {
+  return arenaHighWater;
+}
+
+uint32_t requestArenaFallbacks() {
+  return arenaFallbacks;
+}
+
+bool requestArenaInPsram() {
+  return arenaPsram;
+}
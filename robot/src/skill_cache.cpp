@@ -0,0 +1,344 @@
+#include "skill_cache.h"
+
+#include <LittleFS.h>
+
+#include "logging.h"
+
+static const char* SKILL_DIR = "/skills";
+static const char* SKILL_INDEX_PATH = "/skills/index.bin";
+static const char* SKILL_TEMP_PATH = "/skills/upload.tmp";
+static const uint32_t SKILL_INDEX_MAGIC = 0x33434B53;  // "SKC3"; older indexes start an empty cache
+// Headroom for LittleFS metadata and block rounding when reserving space
+static const size_t SKILL_FS_SLACK = 8192;
+// Quiet time after the last play before its use order is written back
+static const unsigned long SKILL_INDEX_FLUSH_MS = 10000;
+// /sequence.bin header layout (see main.cpp): the name length byte, and the
+// name bytes that follow the fixed header, are left out of the content CRC
+static const size_t SEQ_NAME_LEN_OFFSET = 3;
+static const size_t SEQ_HEADER_SIZE = 8;
+
+struct SkillIndexHeader {
+  uint32_t magic;
+  uint32_t count;
+  uint32_t useCounter;
+};
+
+static SkillCacheEntry entries[SKILL_CACHE_MAX_ENTRIES];
+static size_t entryCount = 0;
+static uint32_t useCounter = 0;
+static uint32_t evictions = 0;
+static bool mounted = false;
+static bool indexDirty = false;        // lastUsed bumps not yet in flash
+static unsigned long dirtySince = 0;   // millis() of the newest bump
+
+static File uploadFile;
+static char uploadName[SKILL_NAME_MAX + 1];
+static uint32_t uploadCrc = 0;
+static size_t uploadOffset = 0;   // body bytes seen so far
+static uint8_t uploadNameLen = 0;
+
+// CRC-32 (IEEE, reflected) with a 16-entry table; chains like zlib.crc32
+static uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len) {
+  static const uint32_t table[16] = {
+      0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+      0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+  };
+  crc = ~crc;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    crc = (crc >> 4) ^ table[crc & 0x0F];
+    crc = (crc >> 4) ^ table[crc & 0x0F];
+  }
+  return ~crc;
+}
+
+// Content CRC of a /sequence.bin body streamed in any chunking: the CRC-32
+// of the same body with an empty name, so one motion stored under several
+// names has one key
+static void contentCrcUpdate(const uint8_t* data, size_t len) {
+  while (len > 0) {
+    size_t n = len;
+    // Bytes up to the end of the region the offset is in
+    size_t regionEnd = uploadOffset < SEQ_NAME_LEN_OFFSET ? SEQ_NAME_LEN_OFFSET
+                     : uploadOffset < SEQ_HEADER_SIZE     ? SEQ_HEADER_SIZE
+                                                          : SEQ_HEADER_SIZE + uploadNameLen;
+    if (uploadOffset < regionEnd && regionEnd - uploadOffset < n) n = regionEnd - uploadOffset;
+    if (uploadOffset < SEQ_NAME_LEN_OFFSET) {
+      uploadCrc = crc32Update(uploadCrc, data, n);
+    } else if (uploadOffset == SEQ_NAME_LEN_OFFSET) {
+      static const uint8_t noName = 0;
+      uploadNameLen = data[0];
+      n = 1;
+      uploadCrc = crc32Update(uploadCrc, &noName, 1);
+    } else if (uploadOffset < SEQ_HEADER_SIZE) {
+      uploadCrc = crc32Update(uploadCrc, data, n);
+    } else if (uploadOffset < SEQ_HEADER_SIZE + uploadNameLen) {
+      // the name: skipped
+    } else {
+      uploadCrc = crc32Update(uploadCrc, data, n);
+    }
+    data += n;
+    len -= n;
+    uploadOffset += n;
+  }
+}
+
+// FNV-1a keeps file names short and filesystem-safe whatever the skill is called
+static uint32_t nameHash(const char* name) {
+  uint32_t h = 2166136261u;
+  for (const char* p = name; *p; ++p) {
+    h = (h ^ (uint8_t)*p) * 16777619u;
+  }
+  return h;
+}
+
+static void skillPath(const char* name, char* out, size_t outSize) {
+  snprintf(out, outSize, "%s/%08x.seq", SKILL_DIR, (unsigned)nameHash(name));
+}
+
+static int findIndex(const char* name) {
+  for (size_t i = 0; i < entryCount; ++i) {
+    if (strcmp(entries[i].name, name) == 0) return (int)i;
+  }
+  return -1;
+}
+
+static void saveIndex() {
+  File f = LittleFS.open(SKILL_INDEX_PATH, FILE_WRITE);
+  if (!f) {
+    LOGE("❌ Skill cache: cannot write index");
+    return;
+  }
+  SkillIndexHeader header = {SKILL_INDEX_MAGIC, (uint32_t)entryCount, useCounter};
+  f.write((const uint8_t*)&header, sizeof(header));
+  f.write((const uint8_t*)entries, entryCount * sizeof(SkillCacheEntry));
+  f.close();
+  indexDirty = false;
+}
+
+// Drop entry i from the table and flash (the index is saved by the caller)
+static void dropEntry(size_t i) {
+  char path[32];
+  skillPath(entries[i].name, path, sizeof(path));
+  LittleFS.remove(path);
+  memmove(&entries[i], &entries[i + 1], (entryCount - i - 1) * sizeof(SkillCacheEntry));
+  entryCount--;
+}
+
+static bool evictLeastRecent() {
+  if (entryCount == 0) return false;
+  size_t oldest = 0;
+  for (size_t i = 1; i < entryCount; ++i) {
+    if (entries[i].lastUsed < entries[oldest].lastUsed) oldest = i;
+  }
+  LOGI("♻️ Skill cache: evicting '%s'", entries[oldest].name);
+  dropEntry(oldest);
+  evictions++;
+  return true;
+}
+
+// Rewrites the index only if it had to be repaired
+static void loadIndex() {
+  entryCount = 0;
+  bool changed = false;
+  File f = LittleFS.open(SKILL_INDEX_PATH, FILE_READ);
+  if (f) {
+    SkillIndexHeader header;
+    changed = true; // unless it reads back whole
+    if (f.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && header.magic == SKILL_INDEX_MAGIC &&
+        header.count <= SKILL_CACHE_MAX_ENTRIES) {
+      size_t bytes = header.count * sizeof(SkillCacheEntry);
+      if (f.read((uint8_t*)entries, bytes) == bytes) {
+        entryCount = header.count;
+        useCounter = header.useCounter;
+        changed = false;
+      }
+    }
+    f.close();
+  }
+
+  // Keep only entries whose file survived (e.g. a power cut mid-commit)
+  for (size_t i = 0; i < entryCount;) {
+    entries[i].name[SKILL_NAME_MAX] = '\0';
+    char path[32];
+    skillPath(entries[i].name, path, sizeof(path));
+    File data = LittleFS.open(path, FILE_READ);
+    bool ok = data && data.size() == entries[i].size;
+    if (data) data.close();
+    if (ok) {
+      i++;
+    } else {
+      memmove(&entries[i], &entries[i + 1], (entryCount - i - 1) * sizeof(SkillCacheEntry));
+      entryCount--;
+      changed = true;
+    }
+  }
+
+  // Remove files the index no longer knows about, including a stale upload
+  File dir = LittleFS.open(SKILL_DIR);
+  if (dir && dir.isDirectory()) {
+    char stray[SKILL_CACHE_MAX_ENTRIES + 1][48];
+    size_t strayCount = 0;
+    for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+      const char* path = f.path();
+      bool known = strcmp(path, SKILL_INDEX_PATH) == 0;
+      for (size_t i = 0; i < entryCount && !known; ++i) {
+        char expected[32];
+        skillPath(entries[i].name, expected, sizeof(expected));
+        known = strcmp(path, expected) == 0;
+      }
+      if (!known && strayCount < SKILL_CACHE_MAX_ENTRIES + 1) {
+        strncpy(stray[strayCount], path, sizeof(stray[0]) - 1);
+        stray[strayCount][sizeof(stray[0]) - 1] = '\0';
+        strayCount++;
+      }
+      f.close();
+    }
+    dir.close();
+    for (size_t i = 0; i < strayCount; ++i) {
+      LittleFS.remove(stray[i]);
+    }
+  }
+  if (changed) saveIndex();
+}
+
+bool skillCacheBegin() {
+  if (!LittleFS.begin(true)) {
+    LOGE("❌ Skill cache: LittleFS mount failed");
+    return false;
+  }
+  LittleFS.mkdir(SKILL_DIR);
+  mounted = true;
+  loadIndex();
+  LOGI("💾 Skill cache: %u skills, %u bytes free", (unsigned)entryCount, (unsigned)skillCacheFreeBytes());
+  return true;
+}
+
+bool skillCacheReady() { return mounted; }
+size_t skillCacheCount() { return entryCount; }
+uint32_t skillCacheEvictions() { return evictions; }
+
+const SkillCacheEntry* skillCacheEntryAt(size_t index) {
+  return index < entryCount ? &entries[index] : nullptr;
+}
+
+const SkillCacheEntry* skillCacheFind(const char* name) {
+  int i = findIndex(name);
+  return i < 0 ? nullptr : &entries[i];
+}
+
+const SkillCacheEntry* skillCacheFindByCrc(uint32_t crc) {
+  for (size_t i = 0; i < entryCount; ++i) {
+    if (entries[i].crc == crc) return &entries[i];
+  }
+  return nullptr;
+}
+
+size_t skillCacheFreeBytes() {
+  if (!mounted) return 0;
+  size_t total = LittleFS.totalBytes();
+  size_t used = LittleFS.usedBytes();
+  return used < total ? total - used : 0;
+}
+
+bool skillCacheBeginWrite(const char* name) {
+  if (!mounted) return false;
+  skillCacheAbortWrite();
+  strncpy(uploadName, name, SKILL_NAME_MAX);
+  uploadName[SKILL_NAME_MAX] = '\0';
+  uploadCrc = 0;
+  uploadOffset = 0;
+  uploadNameLen = 0;
+  uploadFile = LittleFS.open(SKILL_TEMP_PATH, FILE_WRITE);
+  return (bool)uploadFile;
+}
+
+bool skillCacheReserve(size_t bytes) {
+  size_t need = bytes + SKILL_FS_SLACK;
+  bool evicted = false;
+  while (skillCacheFreeBytes() < need ||
+         (entryCount >= SKILL_CACHE_MAX_ENTRIES && findIndex(uploadName) < 0)) {
+    if (!evictLeastRecent()) break;
+    evicted = true;
+  }
+  if (evicted) saveIndex();
+  return skillCacheFreeBytes() >= need;
+}
+
+bool skillCacheWrite(const uint8_t* data, size_t len) {
+  if (!uploadFile || uploadFile.write(data, len) != len) return false;
+  contentCrcUpdate(data, len);
+  return true;
+}
+
+bool skillCacheCommit() {
+  if (!uploadFile) return false;
+  uint32_t size = (uint32_t)uploadFile.size();
+  uploadFile.close();
+
+  int existing = findIndex(uploadName);
+  if (existing >= 0) dropEntry((size_t)existing);
+
+  char path[32];
+  skillPath(uploadName, path, sizeof(path));
+  // Another name that hashes to the same file loses its slot
+  for (size_t i = 0; i < entryCount; ++i) {
+    char other[32];
+    skillPath(entries[i].name, other, sizeof(other));
+    if (strcmp(other, path) == 0) {
+      dropEntry(i);
+      break;
+    }
+  }
+  if (entryCount >= SKILL_CACHE_MAX_ENTRIES) evictLeastRecent();
+
+  if (!LittleFS.rename(SKILL_TEMP_PATH, path)) {
+    LittleFS.remove(SKILL_TEMP_PATH);
+    saveIndex();
+    return false;
+  }
+  SkillCacheEntry &entry = entries[entryCount++];
+  memset(&entry, 0, sizeof(entry));
+  strcpy(entry.name, uploadName);
+  entry.size = size;
+  entry.crc = uploadCrc;
+  entry.lastUsed = ++useCounter;
+  saveIndex();
+  return true;
+}
+
+void skillCacheAbortWrite() {
+  if (uploadFile) {
+    uploadFile.close();
+    LittleFS.remove(SKILL_TEMP_PATH);
+  }
+}
+
+File skillCacheOpen(const char* name) {
+  int i = findIndex(name);
+  if (i < 0) return File();
+  char path[32];
+  skillPath(name, path, sizeof(path));
+  File f = LittleFS.open(path, FILE_READ);
+  if (f) {
+    // Replays are the hot path: record the use in RAM and leave the flash
+    // write to skillCacheFlush()
+    entries[i].lastUsed = ++useCounter;
+    indexDirty = true;
+    dirtySince = millis();
+  }
+  return f;
+}
+
+void skillCacheFlush() {
+  if (!indexDirty || millis() - dirtySince < SKILL_INDEX_FLUSH_MS) return;
+  saveIndex();
+}
+
+bool skillCacheRemove(const char* name) {
+  int i = findIndex(name);
+  if (i < 0) return false;
+  dropEntry((size_t)i);
+  saveIndex();
+  return true;
+}
@@ -0,0 +1,63 @@
+#include "wifi_cache.h"
+
+#include <Preferences.h>
+#include <string.h>
+
+#include "logging.h"
+
+static const char* NVS_NAMESPACE = "wifi";
+static const char* NVS_KEY = "assoc";
+static const uint8_t CACHE_VERSION = 1;
+
+struct StoredCache {
+  uint8_t version;
+  WiFiCache cache;
+};
+
+static bool readStored(StoredCache* out) {
+  Preferences prefs;
+  if (!prefs.begin(NVS_NAMESPACE, true)) return false;
+  size_t len = prefs.getBytes(NVS_KEY, out, sizeof(*out));
+  prefs.end();
+  return len == sizeof(*out) && out->version == CACHE_VERSION;
+}
+
+bool wifiCacheLoad(WiFiCache* out) {
+  StoredCache stored;
+  if (!readStored(&stored) || stored.cache.channel == 0 || stored.cache.ip == 0) return false;
+  *out = stored.cache;
+  return true;
+}
+
+// Field by field: the struct has padding, which memcmp would compare too
+static bool sameCache(const WiFiCache& a, const WiFiCache& b) {
+  return memcmp(a.bssid, b.bssid, sizeof(a.bssid)) == 0 && a.channel == b.channel && a.ip == b.ip &&
+         a.gateway == b.gateway && a.subnet == b.subnet && a.dns == b.dns;
+}
+
+void wifiCacheStore(const WiFiCache& cache) {
+  StoredCache stored;
+  if (readStored(&stored) && sameCache(stored.cache, cache)) return;
+
+  memset(&stored, 0, sizeof(stored));
+  stored.version = CACHE_VERSION;
+  stored.cache = cache;
+  Preferences prefs;
+  if (!prefs.begin(NVS_NAMESPACE, false)) {
+    LOGW("⚠️ WiFi cache: NVS unavailable");
+    return;
+  }
+  if (prefs.putBytes(NVS_KEY, &stored, sizeof(stored)) != sizeof(stored)) {
+    LOGW("⚠️ WiFi cache: write failed");
+  } else {
+    LOGI("💾 WiFi cache updated (channel %u)", (unsigned)cache.channel);
+  }
+  prefs.end();
+}
+
+void wifiCacheClear() {
+  Preferences prefs;
+  if (!prefs.begin(NVS_NAMESPACE, false)) return;
+  prefs.remove(NVS_KEY);
+  prefs.end();
+}